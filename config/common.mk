@@ -10,7 +10,11 @@ endif
 ifeq ($(PLATFORM), win32)
 include $(dir $(lastword $(MAKEFILE_LIST)))../platform/platform_win32.mk
 else
-$(error Invalid PLATFORM (must be "win32"))
+ifeq ($(PLATFORM), linux)
+include $(dir $(lastword $(MAKEFILE_LIST)))../platform/platform_linux.mk
+else
+$(error Invalid PLATFORM (must be "win32" or "linux"))
+endif
 endif
 
 # Pull in graphics api
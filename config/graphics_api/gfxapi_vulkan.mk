@@ -1,7 +1,10 @@
 # Graphics api flags 
 ifeq ($(strip $(VULKAN_SDK)),)
+# The linux backend does not build the vulkan modules yet
+ifneq ($(PLATFORM), linux)
 $(error "VULKAN_SDK is not set in your environment.")
 endif
+endif
 
 THIRD_PARTY_DIRS := $(VULKAN_SDK)
 
@@ -21,9 +21,15 @@
 
 #include <dd/trace.h>
 #include <dd/util.h>
+#include <dd/sys/sys_processortopology.h>
 #include <dd/ukern.h>
+#include <dd/job.h>
+
+/* The linux backend only provides the core libraries */
+#if !defined(DD_PLATFORM_LINUX)
 #include <dd/mem.h>
 #include <dd/sys.h>
 #include <dd/res.h>
 #include <dd/hid.h>
 #include <dd/vk.h>
+#endif
@@ -0,0 +1,175 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::job {
+
+    namespace impl {
+        class JobSystem;
+    }
+
+    using JobFunction = void (*)(void *arg);
+    using JobHandle   = u32;
+
+    class JobGraph;
+
+    class Job {
+        private:
+            friend class JobGraph;
+            friend class impl::JobSystem;
+        private:
+            JobFunction  m_function;
+            void        *m_arg;
+            JobGraph    *m_graph;
+            Job         *m_next_ready_job;
+            u32          m_predecessor_count;
+            u32          m_remaining_predecessor_count;
+            u32          m_successor_index;
+            u32          m_successor_count;
+        public:
+            constexpr ALWAYS_INLINE Job() : m_function(nullptr), m_arg(nullptr), m_graph(nullptr), m_next_ready_job(nullptr), m_predecessor_count(0), m_remaining_predecessor_count(0), m_successor_index(0), m_successor_count(0) {/*...*/}
+            constexpr ALWAYS_INLINE Job(JobFunction function, void *arg) : m_function(function), m_arg(arg), m_graph(nullptr), m_next_ready_job(nullptr), m_predecessor_count(0), m_remaining_predecessor_count(0), m_successor_index(0), m_successor_count(0) {/*...*/}
+    };
+
+    struct JobDependency {
+        JobHandle predecessor;
+        JobHandle successor;
+    };
+
+    /* Graphs are built into caller storage once and can be resubmitted every frame without allocating */
+    class JobGraph {
+        private:
+            friend class impl::JobSystem;
+        private:
+            Job                  *m_job_array;
+            JobDependency        *m_dependency_array;
+            u32                  *m_successor_array;
+            u32                   m_job_count;
+            u32                   m_max_job_count;
+            u32                   m_dependency_count;
+            u32                   m_max_dependency_count;
+            u32                   m_root_count;
+            bool                  m_is_compiled;
+            ukern::InternalLatch  m_completion_latch;
+        private:
+            void Compile() {
+
+                /* Count predecessors and successors */
+                for (u32 i = 0; i < m_job_count; ++i) {
+                    m_job_array[i].m_predecessor_count = 0;
+                    m_job_array[i].m_successor_count   = 0;
+                }
+                for (u32 i = 0; i < m_dependency_count; ++i) {
+                    m_job_array[m_dependency_array[i].predecessor].m_successor_count   += 1;
+                    m_job_array[m_dependency_array[i].successor].m_predecessor_count += 1;
+                }
+
+                /* Lay out each job's successors contiguously */
+                u32 successor_index = 0;
+                m_root_count        = 0;
+                for (u32 i = 0; i < m_job_count; ++i) {
+                    m_job_array[i].m_successor_index = successor_index;
+                    successor_index                 += m_job_array[i].m_successor_count;
+                    m_job_array[i].m_successor_count = 0;
+                    if (m_job_array[i].m_predecessor_count == 0) { ++m_root_count; }
+                }
+                for (u32 i = 0; i < m_dependency_count; ++i) {
+                    Job *predecessor = m_job_array + m_dependency_array[i].predecessor;
+                    m_successor_array[predecessor->m_successor_index + predecessor->m_successor_count] = m_dependency_array[i].successor;
+                    predecessor->m_successor_count += 1;
+                }
+
+                m_is_compiled = true;
+            }
+        public:
+            constexpr ALWAYS_INLINE JobGraph() : m_job_array(nullptr), m_dependency_array(nullptr), m_successor_array(nullptr), m_job_count(0), m_max_job_count(0), m_dependency_count(0), m_max_dependency_count(0), m_root_count(0), m_is_compiled(false), m_completion_latch(0) {/*...*/}
+
+            void Initialize(Job *job_array, u32 max_job_count, JobDependency *dependency_array, u32 *successor_array, u32 max_dependency_count) {
+                m_job_array            = job_array;
+                m_dependency_array     = dependency_array;
+                m_successor_array      = successor_array;
+                m_max_job_count        = max_job_count;
+                m_max_dependency_count = max_dependency_count;
+                this->Clear();
+            }
+
+            void Clear() {
+                DD_ASSERT(this->IsComplete() == true);
+                m_job_count        = 0;
+                m_dependency_count = 0;
+                m_root_count       = 0;
+                m_is_compiled      = false;
+            }
+
+            Result AddJob(JobHandle *out_handle, JobFunction function, void *arg) {
+
+                /* Integrity checks */
+                RESULT_RETURN_UNLESS(this->IsComplete() == true, ResultJobGraphInFlight);
+                RESULT_RETURN_UNLESS(m_job_count < m_max_job_count, ResultJobGraphFull);
+
+                Job *job = m_job_array + m_job_count;
+                std::construct_at(job);
+                job->m_function = function;
+                job->m_arg      = arg;
+                job->m_graph    = this;
+
+                *out_handle   = m_job_count;
+                m_job_count   = m_job_count + 1;
+                m_is_compiled = false;
+
+                return ResultSuccess;
+            }
+
+            /* Graphs must stay acyclic, the successor only runs once the predecessor has finished */
+            Result AddDependency(JobHandle predecessor, JobHandle successor) {
+
+                /* Integrity checks */
+                RESULT_RETURN_UNLESS(this->IsComplete() == true, ResultJobGraphInFlight);
+                RESULT_RETURN_UNLESS(predecessor < m_job_count && successor < m_job_count, ResultInvalidJobHandle);
+                RESULT_RETURN_IF(predecessor == successor, ResultInvalidDependency);
+                RESULT_RETURN_UNLESS(m_dependency_count < m_max_dependency_count, ResultDependencyTableFull);
+
+                m_dependency_array[m_dependency_count] = JobDependency{ predecessor, successor };
+                m_dependency_count = m_dependency_count + 1;
+                m_is_compiled      = false;
+
+                return ResultSuccess;
+            }
+
+            bool IsComplete() const {
+                return m_completion_latch.TryWait();
+            }
+
+            void Wait() {
+                m_completion_latch.Wait();
+            }
+
+            constexpr ALWAYS_INLINE u32 GetJobCount()        const { return m_job_count; }
+            constexpr ALWAYS_INLINE u32 GetDependencyCount() const { return m_dependency_count; }
+    };
+
+    template<u32 MaxJobCount, u32 MaxDependencyCount>
+    class FixedJobGraph : public JobGraph {
+        private:
+            Job           m_job_storage[MaxJobCount];
+            JobDependency m_dependency_storage[MaxDependencyCount];
+            u32           m_successor_storage[MaxDependencyCount];
+        public:
+            FixedJobGraph() : JobGraph() {
+                this->Initialize(m_job_storage, MaxJobCount, m_dependency_storage, m_successor_storage, MaxDependencyCount);
+            }
+    };
+}
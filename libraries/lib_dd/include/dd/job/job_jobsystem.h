@@ -0,0 +1,40 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::job {
+
+    /* Starts one worker fiber pinned to each ukern core, ukern must be initialized */
+    Result InitializeJobSystem();
+
+    /* Limits the workers to the first cores, forking fibers on other cores share their queues */
+    Result InitializeJobSystem(u32 worker_count);
+    void   FinalizeJobSystem();
+
+    /* Releases the graph's jobs without predecessors, successors are released as their last predecessor finishes */
+    Result SubmitJobGraph(JobGraph *graph);
+
+    /* Submits the graph and waits for every job to finish */
+    Result RunJobGraph(JobGraph *graph);
+
+    /* Queues a standalone job on the calling core for any worker to steal, it's function must count down the completion latch */
+    void ForkJob(Job *job);
+
+    /* Runs the forked job inline if it was not stolen, otherwise runs other queued jobs until the latch opens */
+    void JoinJob(Job *job, ukern::InternalLatch *completion_latch);
+
+    u32 GetJobWorkerCount();
+}
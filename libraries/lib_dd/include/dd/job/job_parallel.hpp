@@ -0,0 +1,156 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::job {
+
+    namespace impl {
+
+        template<typename Function>
+        class ForkedCall {
+            private:
+                Job                   m_job;
+                ukern::InternalLatch  m_completion_latch;
+                Function             &m_function;
+            private:
+                static void InvokeForkedCall(void *arg) {
+                    ForkedCall *forked_call = reinterpret_cast<ForkedCall*>(arg);
+                    forked_call->m_function();
+                    forked_call->m_completion_latch.CountDown();
+                }
+            public:
+                explicit ForkedCall(Function &function) : m_job(InvokeForkedCall, this), m_completion_latch(1), m_function(function) {/*...*/}
+
+                void Fork() {
+                    ForkJob(std::addressof(m_job));
+                }
+
+                void Join() {
+                    JoinJob(std::addressof(m_job), std::addressof(m_completion_latch));
+                }
+        };
+
+        template<typename Function>
+        void ParallelForRange(size_t begin, size_t end, size_t grain, Function &function) {
+
+            /* Run on the calling fiber once the range fits in the grain */
+            if (end - begin <= grain) {
+                for (size_t i = begin; i < end; ++i) { function(i); }
+                return;
+            }
+
+            /* Leave the upper half for thieves while splitting the lower half */
+            const size_t middle     = begin + (end - begin) / 2;
+            auto         upper_half = [&]() { ParallelForRange(middle, end, grain, function); };
+
+            ForkedCall<decltype(upper_half)> forked_call(upper_half);
+            forked_call.Fork();
+            ParallelForRange(begin, middle, grain, function);
+            forked_call.Join();
+        }
+
+        template<typename T, typename MapFunction, typename ReduceFunction>
+        T ParallelReduceRange(size_t begin, size_t end, size_t grain, const T &identity, MapFunction &map, ReduceFunction &reduce) {
+
+            if (end - begin <= grain) {
+                T value = identity;
+                for (size_t i = begin; i < end; ++i) { value = reduce(value, map(i)); }
+                return value;
+            }
+
+            /* The lower half is always the left operand, so reduce only needs to be associative */
+            const size_t middle      = begin + (end - begin) / 2;
+            T            upper_value = identity;
+            auto         upper_half  = [&]() { upper_value = ParallelReduceRange(middle, end, grain, identity, map, reduce); };
+
+            ForkedCall<decltype(upper_half)> forked_call(upper_half);
+            forked_call.Fork();
+            const T lower_value = ParallelReduceRange(begin, middle, grain, identity, map, reduce);
+            forked_call.Join();
+
+            return reduce(lower_value, upper_value);
+        }
+
+        template<typename T, typename Compare>
+        void ParallelSortRange(T *first, T *last, size_t grain, u32 depth_limit, Compare &compare) {
+
+            /* Sort small or badly partitioned ranges serially */
+            if (static_cast<size_t>(last - first) <= grain || depth_limit == 0) {
+                std::sort(first, last, compare);
+                return;
+            }
+
+            /* Median of three pivot */
+            const T &first_value  = *first;
+            const T &middle_value = first[(last - first) / 2];
+            const T &last_value   = *(last - 1);
+            const T  pivot        = (compare(first_value, middle_value) == true) ? ((compare(middle_value, last_value) == true) ? middle_value : ((compare(first_value, last_value) == true) ? last_value : first_value))
+                                                                                 : ((compare(first_value, last_value) == true) ? first_value : ((compare(middle_value, last_value) == true) ? last_value : middle_value));
+
+            /* Split into less than, equal to and greater than the pivot so duplicates don't recurse */
+            T *lower_end   = std::partition(first, last, [&](const T &value) { return compare(value, pivot); });
+            T *upper_begin = std::partition(lower_end, last, [&](const T &value) { return compare(pivot, value) == false; });
+
+            auto upper_half = [&]() { ParallelSortRange(upper_begin, last, grain, depth_limit - 1, compare); };
+
+            ForkedCall<decltype(upper_half)> forked_call(upper_half);
+            forked_call.Fork();
+            ParallelSortRange(first, lower_end, grain, depth_limit - 1, compare);
+            forked_call.Join();
+        }
+    }
+
+    /* Calls function(index) for every index in [begin, end), ranges are split in half until they fit in the grain */
+    template<typename Function>
+    void ParallelFor(size_t begin, size_t end, size_t grain, Function &&function) {
+
+        if (end <= begin) { return; }
+
+        /* Run serially without workers */
+        if (GetJobWorkerCount() == 0) {
+            for (size_t i = begin; i < end; ++i) { function(i); }
+            return;
+        }
+
+        impl::ParallelForRange(begin, end, (grain != 0) ? grain : 1, function);
+    }
+
+    /* Folds map(index) over [begin, end) with reduce, which must be associative with identity as it's identity */
+    template<typename T, typename MapFunction, typename ReduceFunction>
+    T ParallelReduce(size_t begin, size_t end, size_t grain, const T &identity, MapFunction &&map, ReduceFunction &&reduce) {
+
+        if (end <= begin) { return identity; }
+
+        const size_t split_grain = (GetJobWorkerCount() != 0) ? ((grain != 0) ? grain : 1) : end - begin;
+        return impl::ParallelReduceRange(begin, end, split_grain, identity, map, reduce);
+    }
+
+    /* Unstable quicksort, partitions are sorted in parallel until they fit in the grain */
+    template<typename T, typename Compare>
+    void ParallelSort(T *array, size_t count, size_t grain, Compare &&compare) {
+
+        if (count < 2) { return; }
+
+        if (GetJobWorkerCount() == 0) { std::sort(array, array + count, compare); return; }
+
+        impl::ParallelSortRange(array, array + count, (grain != 0) ? grain : 1, 2 * std::bit_width(count), compare);
+    }
+
+    template<typename T>
+    void ParallelSort(T *array, size_t count, size_t grain) {
+        ParallelSort(array, count, grain, [](const T &lhs, const T &rhs) { return lhs < rhs; });
+    }
+}
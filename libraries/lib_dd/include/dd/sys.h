@@ -1,5 +1,6 @@
 #pragma once
 
+#include <dd/sys/sys_processortopology.h>
 #include <dd/sys/sys_systemmanager.h>
 #include <dd/sys/sys_mutex.hpp>
 #include <dd/sys/sys_event.hpp>
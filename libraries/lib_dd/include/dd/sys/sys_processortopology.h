@@ -0,0 +1,72 @@
+#pragma once
+
+namespace dd::sys {
+
+    /* Distances between two processors, ordered from closest to furthest */
+    enum ProcessorDistance : u32 {
+        ProcessorDistance_Self,
+        ProcessorDistance_SmtSibling,
+        ProcessorDistance_SharedL2,
+        ProcessorDistance_SharedL3,
+        ProcessorDistance_SameNumaNode,
+        ProcessorDistance_Remote,
+    };
+
+    struct ProcessorTopology {
+        static constexpr size_t MaxProcessorCount = 256;
+        static constexpr u16    InvalidDomain     = 0xffff;
+
+        /* Domain ids are dense, processors sharing an id share that resource */
+        struct ProcessorInfo {
+            u16 core_id;
+            u16 l2_domain;
+            u16 l3_domain;
+            u16 numa_node;
+        };
+
+        /* Processor indices are flat across processor groups on Win32 and are cpu ids on Linux */
+        u32           processor_count;
+        u32           core_count;
+        u32           l2_domain_count;
+        u32           l3_domain_count;
+        u32           numa_node_count;
+        ProcessorInfo processor_info_array[MaxProcessorCount];
+
+        static constexpr ProcessorDistance GetDistance(const ProcessorInfo &info0, const ProcessorInfo &info1) {
+            if (info0.core_id   != InvalidDomain && info0.core_id   == info1.core_id)   { return ProcessorDistance_SmtSibling; }
+            if (info0.l2_domain != InvalidDomain && info0.l2_domain == info1.l2_domain) { return ProcessorDistance_SharedL2; }
+            if (info0.l3_domain != InvalidDomain && info0.l3_domain == info1.l3_domain) { return ProcessorDistance_SharedL3; }
+            if (info0.numa_node != InvalidDomain && info0.numa_node == info1.numa_node) { return ProcessorDistance_SameNumaNode; }
+
+            return ProcessorDistance_Remote;
+        }
+
+        constexpr ProcessorDistance GetDistance(u32 processor_index0, u32 processor_index1) const {
+            if (processor_index0 == processor_index1)                                       { return ProcessorDistance_Self; }
+            if (processor_count <= processor_index0 || processor_count <= processor_index1) { return ProcessorDistance_Remote; }
+
+            return GetDistance(processor_info_array[processor_index0], processor_info_array[processor_index1]);
+        }
+
+        constexpr ProcessorInfo GetProcessorInfo(u32 processor_index) const {
+            if (processor_count <= processor_index) { return ProcessorInfo{ InvalidDomain, InvalidDomain, InvalidDomain, InvalidDomain }; }
+            return processor_info_array[processor_index];
+        }
+
+        /* Gives every processor it's own core and caches on a single numa node */
+        constexpr void SetFlat(u32 flat_processor_count) {
+            processor_count = flat_processor_count;
+            core_count      = flat_processor_count;
+            l2_domain_count = flat_processor_count;
+            l3_domain_count = flat_processor_count;
+            numa_node_count = 1;
+            for (u32 i = 0; i < flat_processor_count; ++i) {
+                const u16 domain = static_cast<u16>(i);
+                processor_info_array[i] = ProcessorInfo{ domain, domain, domain, 0 };
+            }
+        }
+    };
+
+    /* Reads SMT, cache and numa topology from the OS, falls back to a flat topology on failure */
+    void QueryProcessorTopology(ProcessorTopology *out_topology);
+}
@@ -3,13 +3,20 @@
 namespace dd::sys {
 
     struct SystemManager {
-        u32         active_processor_count;
-        u32         process_core_count;
-        u64         process_core_mask;
-        u64         system_core_mask;
-        SYSTEM_INFO system_info;
-        
-        static constexpr size_t MaximumSupportedProcessorCount = 64;
+        static constexpr size_t MaximumSupportedProcessorCount = 256;
+
+        /* Processor indices are flat across processor groups, group n's processors follow group n - 1's */
+        using ProcessorMask = util::BitSet<MaximumSupportedProcessorCount>;
+
+        u32           active_processor_count;
+        u32           processor_group_count;
+        u32           process_core_count;
+        u64           process_core_mask;
+        u64           system_core_mask;
+        ProcessorMask process_processor_mask;
+        SYSTEM_INFO   system_info;
+
+        ProcessorTopology processor_topology;
     };
 
     void InitializeSystemManager();
@@ -19,6 +26,8 @@ namespace dd::sys {
     SystemManager *GetSystemManager();
 
     u32 GetProcessProcessorCount();
+    const SystemManager::ProcessorMask &GetProcessProcessorMask();
+    const ProcessorTopology *GetProcessorTopology();
     u32 GetCurrentThreadCoreNumber();
     
     SYSTEM_INFO *GetSystemInfo();
@@ -17,20 +17,16 @@
 
 namespace dd::trace {
 
-    ALWAYS_INLINE bool IsDebuggerPresent() {
-        return ::IsDebuggerPresent();
-    }
+    bool IsDebuggerPresent();
 
-    ALWAYS_INLINE void Break() {
-        if (IsDebuggerPresent() == true) {
-            ::DebugBreak();
-        }
-    }
+    void Break();
 
     namespace impl {
 
         NO_RETURN void AbortImpl(const char *expected_result, const char *function_name, const char *full_file_path, u32 line_number, const Result result, const char *format, ...);
 
+        bool OutputCrashReport(const char *file_path, const char *output, size_t output_length);
+
         NO_RETURN void Abort(const Result result);
     }
 }
@@ -15,14 +15,29 @@
  */
 #pragma once
 
-#include <dd/ukern/ukern_init.h>
+#if defined(DD_PLATFORM_LINUX)
+    #include <dd/ukern/ukern_platform.linux.hpp>
+#else
+    #include <dd/ukern/ukern_platform.win32.hpp>
+#endif
+#include <dd/ukern/ukern_fibercontext.hpp>
 #include <dd/ukern/ukern_debug.h>
 #include <dd/ukern/ukern_fiberlocalstorage.h>
+#include <dd/ukern/ukern_init.h>
 #include <dd/ukern/ukern_threadapi.h>
 #include <dd/ukern/ukern_synchronizationapi.h>
 #include <dd/ukern/ukern_busymutex.hpp>
 #include <dd/ukern/ukern_handletable.hpp>
+#include <dd/ukern/ukern_runqueue.hpp>
+#include <dd/ukern/ukern_fiberstackpool.hpp>
+#include <dd/ukern/ukern_schedulertrace.hpp>
+#include <dd/ukern/ukern_waitaddresstable.hpp>
 #include <dd/ukern/ukern_scheduler.hpp>
 #include <dd/ukern/ukern_waitableobject.hpp>
+#include <dd/ukern/ukern_coroutine.hpp>
 #include <dd/ukern/ukern_internalcriticalsection.hpp>
 #include <dd/ukern/ukern_internalconditionvariable.hpp>
+#include <dd/ukern/ukern_internalreaderwriterlock.hpp>
+#include <dd/ukern/ukern_internalsemaphore.hpp>
+#include <dd/ukern/ukern_internallatch.hpp>
+#include <dd/ukern/ukern_internalbarrier.hpp>
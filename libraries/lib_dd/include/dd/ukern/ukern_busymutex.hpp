@@ -18,6 +18,8 @@
 namespace dd::ukern {
 
     class BusyMutex {
+        public:
+            static constexpr u32 MaxSpinCount = 256;
         private:
         union {
             struct {
@@ -31,21 +33,44 @@ namespace dd::ukern {
 
             ALWAYS_INLINE void Enter() {
 
-                /* Increment lock count */
-                u32 wait = ::InterlockedExchangeAdd(reinterpret_cast<volatile long int*>(std::addressof(m_counter)), 0x1'0000);
+                /* Increment lock count, our ticket is the lock count prior to the increment */
+                std::atomic_ref<u32> counter(m_counter);
+                const u32 ticket = counter.fetch_add(0x1'0000);
+                u32       wait   = ticket;
 
-                /* Wait until release count is matched */
-                while ((wait & 0xffff) != ((wait >> 0x10) & 0xffff)) {
+                /* Wait until release count reaches our ticket */
+                u32 spin_count = 0;
+                while ((wait & 0xffff) != ((ticket >> 0x10) & 0xffff)) {
 
                     /* Signal the processor to not aggressively speculatively execute for a bit */
                     util::x64::pause();
 
+                    /* Give up the processor past a short critical section, a preempted thread holding an earlier ticket can't release until it runs */
+                    ++spin_count;
+                    if (spin_count == MaxSpinCount) {
+                        impl::YieldCoreThread();
+                        spin_count = 0;
+                    }
+
                     /* Atomicly acquire the lock and release counters */
-                    wait = ::InterlockedAdd(reinterpret_cast<volatile long int*>(std::addressof(m_counter)), 0);
+                    wait = counter.load();
                 }
             }
 
+            ALWAYS_INLINE bool TryEnter() {
+
+                /* Only take a ticket if the mutex is currently unowned */
+                std::atomic_ref<u32> counter(m_counter);
+                u32 last_counter = counter.load();
+                if ((last_counter & 0xffff) != ((last_counter >> 0x10) & 0xffff)) { return false; }
+
+                return counter.compare_exchange_strong(last_counter, last_counter + 0x1'0000);
+            }
+
             ALWAYS_INLINE void Leave() {
+                /* Ensure the critical section's stores are visible before the release */
+                std::atomic_thread_fence(std::memory_order_release);
+
                 /* Increment release */
                 ++m_release_count;
             }
@@ -0,0 +1,308 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::ukern {
+
+    /* Runner fibers resume ready coroutines, one is pinned to each core */
+    Result StartCoroutineRunners();
+    void   ExitCoroutineRunners();
+
+    namespace impl {
+
+        /* Coroutine bodies check wait results through this, gcc 12 can't mangle the __PRETTY_FUNCTION__ of a coroutine in a pch build */
+        void AbortUnlessAsyncWaitSucceeded(Result wait_result);
+
+        /* Stands in for a fiber in the address wait buckets, so a suspended coroutine holds no stack while it waits */
+        class CoroutineWaiter : public WaitableObject {
+            private:
+                FiberLocalStorage   m_wait_entry;
+                CoroutineResumeNode m_resume_node;
+            private:
+                void EndCoroutineWait(FiberLocalStorage *wait_entry, Result wait_result, CoreWakeBatch *wake_batch) {
+
+                    /* Remove from wait bucket and timer heap */
+                    wait_entry->scheduler_list_node.Unlink();
+                    GetScheduler()->UnregisterWaitTimer(wait_entry);
+                    wait_entry->last_result = wait_result;
+
+                    /* Resume on a runner through the run queues, the frame may be gone once this returns */
+                    GetScheduler()->ScheduleCoroutineUnsafe(std::addressof(m_resume_node), wake_batch);
+                }
+            public:
+                constexpr CoroutineWaiter() : m_wait_entry(), m_resume_node() {/*...*/}
+
+                virtual void EndWait(FiberLocalStorage *wait_entry, Result wait_result, CoreWakeBatch *wake_batch) override {
+                    this->EndCoroutineWait(wait_entry, wait_result, wake_batch);
+                }
+
+                virtual void CancelWait(FiberLocalStorage *wait_entry, Result wait_result, CoreWakeBatch *wake_batch) override {
+                    this->EndCoroutineWait(wait_entry, wait_result, wake_batch);
+                }
+
+                constexpr ALWAYS_INLINE void SetHandle(std::coroutine_handle<> handle) { m_resume_node.handle = handle; }
+
+                constexpr ALWAYS_INLINE FiberLocalStorage *GetWaitEntry()        { return std::addressof(m_wait_entry); }
+                constexpr ALWAYS_INLINE Result             GetWaitResult() const { return m_wait_entry.last_result; }
+        };
+
+        class TaskPromiseBase {
+            public:
+                static constexpr u32 CompletionState_Running  = 0;
+                static constexpr u32 CompletionState_Complete = 1;
+                static constexpr u32 HasWaitersBit            = 0x8000'0000;
+            public:
+                struct FinalAwaiter {
+                    constexpr ALWAYS_INLINE bool await_ready() const noexcept { return false; }
+
+                    template<typename Promise>
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                        return handle.promise().Complete();
+                    }
+
+                    constexpr ALWAYS_INLINE void await_resume() const noexcept {/*...*/}
+                };
+            private:
+                CoroutineResumeNode     m_resume_node;
+                std::coroutine_handle<> m_continuation;
+                u32                     m_completion_state;
+                bool                    m_is_started;
+            private:
+                std::coroutine_handle<> Complete() {
+
+                    /* Read the continuation first, a waiting fiber may free the frame as soon as it sees completion */
+                    std::coroutine_handle<> continuation = m_continuation;
+                    const u32 last_state = std::atomic_ref<u32>(m_completion_state).exchange(CompletionState_Complete);
+                    if ((last_state & HasWaitersBit) != 0) {
+                        GetScheduler()->WakeByAddressImpl(std::addressof(m_completion_state), 0xffff'ffff);
+                    }
+
+                    /* Transfer straight to an awaiting coroutine */
+                    return (continuation != nullptr) ? continuation : std::noop_coroutine();
+                }
+            public:
+                constexpr TaskPromiseBase() : m_resume_node(), m_continuation(), m_completion_state(CompletionState_Running), m_is_started(false) {/*...*/}
+
+                /* Tasks start lazily, when awaited or started */
+                constexpr ALWAYS_INLINE std::suspend_always initial_suspend() const noexcept { return {}; }
+                constexpr ALWAYS_INLINE FinalAwaiter        final_suspend()   const noexcept { return {}; }
+
+                void unhandled_exception() { DD_ASSERT(false); }
+
+                /* Frames are freed on whichever runner completes them, so they skip the per thread heaps */
+                static void *operator new(size_t size) { return ::malloc(size); }
+                static void  operator delete(void *address) { ::free(address); }
+
+                void Start(std::coroutine_handle<> handle) {
+                    DD_ASSERT(m_is_started == false);
+                    m_is_started         = true;
+                    m_resume_node.handle = handle;
+                    GetScheduler()->ScheduleCoroutineImpl(std::addressof(m_resume_node));
+                }
+
+                std::coroutine_handle<> StartAsContinuation(std::coroutine_handle<> handle, std::coroutine_handle<> continuation) {
+                    DD_ASSERT(m_is_started == false);
+                    m_is_started   = true;
+                    m_continuation = continuation;
+                    return handle;
+                }
+
+                void Wait() {
+
+                    std::atomic_ref<u32> completion_state(m_completion_state);
+                    for (;;) {
+                        u32 last_state = completion_state.load();
+                        if (last_state == CompletionState_Complete) { return; }
+
+                        /* Mark waiters so completion knows to wake */
+                        if ((last_state & HasWaitersBit) == 0) {
+                            if (completion_state.compare_exchange_strong(last_state, last_state | HasWaitersBit) == false) { continue; }
+                        }
+
+                        const Result wait_result = GetScheduler()->WaitForAddressIfEqualImpl(std::addressof(m_completion_state), last_state | HasWaitersBit, TimeSpan::MaxTime);
+                        if (wait_result == ResultInvalidWaitAddressValue) { continue; }
+                        RESULT_ABORT_UNLESS(wait_result, ResultSuccess);
+                    }
+                }
+
+                bool IsComplete() const {
+                    return std::atomic_ref<u32>(const_cast<u32&>(m_completion_state)).load() == CompletionState_Complete;
+                }
+
+                constexpr ALWAYS_INLINE bool IsStarted() const { return m_is_started; }
+        };
+
+        template<typename T>
+        class TaskPromise;
+    }
+
+    /* Stackless task, suspended tasks park on the same wait buckets as fibers and resume on runner fibers */
+    template<typename T = void>
+    class Task {
+        public:
+            using promise_type = impl::TaskPromise<T>;
+        private:
+            std::coroutine_handle<promise_type> m_handle;
+        public:
+            constexpr ALWAYS_INLINE Task() : m_handle() {/*...*/}
+            constexpr ALWAYS_INLINE explicit Task(std::coroutine_handle<promise_type> handle) : m_handle(handle) {/*...*/}
+            constexpr ALWAYS_INLINE Task(Task &&rhs) : m_handle(std::exchange(rhs.m_handle, nullptr)) {/*...*/}
+
+            Task(const Task&) = delete;
+            Task &operator=(const Task&) = delete;
+
+            ~Task() {
+                if (m_handle == nullptr) { return; }
+
+                /* A running task can't be destroyed from under it's runner */
+                DD_ASSERT(m_handle.promise().IsStarted() == false || m_handle.promise().IsComplete() == true);
+                m_handle.destroy();
+            }
+
+            Task &operator=(Task &&rhs) {
+                Task tmp(std::move(rhs));
+                std::swap(m_handle, tmp.m_handle);
+                return *this;
+            }
+
+            /* Queues the task to run on a runner fiber */
+            void Start() {
+                m_handle.promise().Start(m_handle);
+            }
+
+            /* Blocks the calling fiber until the task completes, starting it if needed */
+            void Wait() {
+                if (m_handle.promise().IsStarted() == false) { this->Start(); }
+                m_handle.promise().Wait();
+            }
+
+            bool IsComplete() const {
+                return m_handle.promise().IsComplete();
+            }
+
+            decltype(auto) GetResult() {
+                DD_ASSERT(this->IsComplete() == true);
+                return m_handle.promise().GetResult();
+            }
+
+            auto operator co_await() {
+                struct TaskAwaiter {
+                    std::coroutine_handle<promise_type> handle;
+
+                    ALWAYS_INLINE bool await_ready() const { return handle.done(); }
+
+                    /* Start the task on this runner, it transfers back once complete */
+                    ALWAYS_INLINE std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) {
+                        return handle.promise().StartAsContinuation(handle, continuation);
+                    }
+
+                    ALWAYS_INLINE decltype(auto) await_resume() { return handle.promise().GetResult(); }
+                };
+                return TaskAwaiter{ m_handle };
+            }
+    };
+
+    namespace impl {
+
+        template<typename T>
+        class TaskPromise : public TaskPromiseBase {
+            private:
+                T m_result;
+            public:
+                constexpr TaskPromise() : TaskPromiseBase(), m_result() {/*...*/}
+
+                Task<T> get_return_object() {
+                    return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+                }
+
+                void return_value(T result) {
+                    m_result = std::move(result);
+                }
+
+                T GetResult() {
+                    return std::move(m_result);
+                }
+        };
+
+        template<>
+        class TaskPromise<void> : public TaskPromiseBase {
+            public:
+                constexpr TaskPromise() : TaskPromiseBase() {/*...*/}
+
+                Task<void> get_return_object() {
+                    return Task<void>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+                }
+
+                constexpr ALWAYS_INLINE void return_void() const {/*...*/}
+
+                constexpr ALWAYS_INLINE void GetResult() const {/*...*/}
+        };
+
+        class WaitForAddressIfEqualAwaiter {
+            private:
+                CoroutineWaiter m_coroutine_waiter;
+                u32            *m_address;
+                u32             m_value;
+                s64             m_absolute_timeout;
+                Result          m_result;
+            public:
+                constexpr WaitForAddressIfEqualAwaiter(u32 *address, u32 value, s64 absolute_timeout) : m_coroutine_waiter(), m_address(address), m_value(value), m_absolute_timeout(absolute_timeout), m_result(ResultSuccess) {/*...*/}
+
+                constexpr ALWAYS_INLINE bool await_ready() const { return false; }
+
+                bool await_suspend(std::coroutine_handle<> handle) {
+
+                    /* Once queued the coroutine may resume elsewhere, so only touch the awaiter when the wait failed */
+                    m_coroutine_waiter.SetHandle(handle);
+                    const Result wait_result = GetScheduler()->WaitForAddressIfEqualAsyncImpl(std::addressof(m_coroutine_waiter), m_address, m_value, m_absolute_timeout);
+                    if (wait_result == ResultSuccess) { return true; }
+
+                    m_result = wait_result;
+                    return false;
+                }
+
+                ALWAYS_INLINE Result await_resume() const {
+                    return (m_result != ResultSuccess) ? m_result : m_coroutine_waiter.GetWaitResult();
+                }
+        };
+
+        class YieldAwaiter {
+            private:
+                CoroutineResumeNode m_resume_node;
+            public:
+                constexpr YieldAwaiter() : m_resume_node() {/*...*/}
+
+                constexpr ALWAYS_INLINE bool await_ready() const { return false; }
+
+                void await_suspend(std::coroutine_handle<> handle) {
+                    m_resume_node.handle = handle;
+                    GetScheduler()->ScheduleCoroutineImpl(std::addressof(m_resume_node));
+                }
+
+                constexpr ALWAYS_INLINE void await_resume() const {/*...*/}
+        };
+    }
+
+    /* Suspends the coroutine while the address equals value, results match WaitOnAddress */
+    ALWAYS_INLINE impl::WaitForAddressIfEqualAwaiter WaitForAddressIfEqualAsync(u32 *address, u32 value, s64 timeout_ns = -1) {
+        return impl::WaitForAddressIfEqualAwaiter(address, value, impl::GetAbsoluteTimeToWakeup(timeout_ns));
+    }
+
+    /* Requeues the coroutine behind other ready coroutines */
+    ALWAYS_INLINE impl::YieldAwaiter YieldAsync() {
+        return impl::YieldAwaiter();
+    }
+}
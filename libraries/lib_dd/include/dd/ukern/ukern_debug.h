@@ -19,5 +19,10 @@ namespace dd::ukern {
 
     void StopAllOtherCores();
     
-    void OutputBackTraceToFileAll(HANDLE file);
+    void OutputBackTraceToFileAll(Handle file);
+
+    /* Scheduler event tracing, exporting stops the trace and writes it as Chrome trace json */
+    Result EnableSchedulerTrace();
+    void   DisableSchedulerTrace();
+    Result ExportSchedulerTrace(const char *path);
 }
@@ -0,0 +1,55 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::ukern::impl {
+
+    using FiberMainFunction = void (*)(void*);
+
+    /* Cooperative switches only preserve the callee-saved registers and fpu control state, which are kept on the switched out fiber's stack */
+    struct FiberContextImpl {
+        void              *stack_pointer;
+        void              *stack_region;
+        size_t             stack_region_size;
+        FiberMainFunction  fiber_main;
+        void              *fiber_arg;
+        FiberContextImpl  *next_free_context;
+        u32                stack_size_class;
+    };
+    using FiberContext = FiberContextImpl*;
+
+    constexpr ALWAYS_INLINE size_t MinFiberStackSize      = 0x4000;
+    constexpr ALWAYS_INLINE size_t FiberGuardPageSize     = 0x1000;
+    constexpr ALWAYS_INLINE u32    UnpooledStackSizeClass = 0xffff'ffff;
+
+    /* The context is stored at the top of it's stack region, above the usable stack */
+    constexpr ALWAYS_INLINE size_t GetFiberStackRegionSize(size_t stack_size) {
+        return util::AlignUp(stack_size + sizeof(FiberContextImpl), FiberGuardPageSize) + FiberGuardPageSize;
+    }
+
+    /* Platform stack regions are committed with a no access guard page at their base */
+    void *AllocateFiberStackRegion(size_t region_size);
+    void  FreeFiberStackRegion(void *stack_region, size_t region_size);
+
+    /* Rebuilds the platform initial frame so the next switch to the context enters it's fiber main */
+    void  InitializeFiberContextFrame(FiberContext fiber_context);
+
+    FiberContext ConvertThreadToFiberContext(void *arg);
+    FiberContext CreateFiberContext(size_t stack_size, FiberMainFunction fiber_main, void *arg);
+    void         DeleteFiberContext(FiberContext fiber_context);
+    void         SwitchToFiberContext(FiberContext fiber_context);
+    void        *GetFiberContextArgument();
+}
@@ -18,7 +18,6 @@
 namespace dd::ukern {
 
     typedef u32 UKernHandle;
-    typedef u64 UKernCoreMask;
 
     using ThreadFunction = void (*)(void *);
 
@@ -26,17 +25,24 @@ namespace dd::ukern {
     constexpr ALWAYS_INLINE size_t      MaxFiberNameLength           = 32;
     constexpr ALWAYS_INLINE s64         WindowsToUKernPriorityOffset = 2;
     constexpr ALWAYS_INLINE size_t      MainThreadHandle             = 1;
-    constexpr ALWAYS_INLINE size_t      MaxCoreCount                 = 32;
-    constexpr ALWAYS_INLINE size_t      MaxThreadCount               = 256;
+    constexpr ALWAYS_INLINE size_t      MaxCoreCount                 = 256;
+    constexpr ALWAYS_INLINE size_t      MaxThreadCount               = 0x10000;
+    constexpr ALWAYS_INLINE size_t      FiberLocalChunkSize          = 256;
+    constexpr ALWAYS_INLINE u32         PriorityLevelCount           = 5;
+    constexpr ALWAYS_INLINE u32         MaxFiberLocalSlotCount       = 8;
 
     static_assert(2 == (THREAD_PRIORITY_NORMAL + WindowsToUKernPriorityOffset));
 
+    /* Bit n selects ukern core n, or system processor n when passed to InitializeUKern */
+    using UKernCoreMask = util::BitSet<MaxCoreCount>;
+
     enum FiberState : u32 {
         FiberState_Scheduled,
         FiberState_Running,
         FiberState_Exiting,
         FiberState_Waiting,
-        FiberState_Suspended
+        FiberState_Suspended,
+        FiberState_Sleeping
     };
 
     enum ActivityLevel : u16 {
@@ -46,20 +52,27 @@ namespace dd::ukern {
 
     namespace impl {
         class WaitableObject;
+        class WaitAddressBucket;
     }
 
     struct FiberLocalStorage {
         s32                      priority;
+        s32                      base_priority;
         u32                      current_core;
+        u32                      first_allowed_core;
+        bool                     is_core_pinned;
         UKernCoreMask            core_mask;
         size_t                   stack_size;
         void*                    user_arg;
+        void*                    fiber_local_slot_array[MaxFiberLocalSlotCount];
         ThreadFunction           user_function;
         bool                     is_suspended;
         UKernHandle              ukern_fiber_handle;
-        void                    *win32_fiber_handle;
+        impl::FiberContext       fiber_context;
         util::IntrusiveListNode  scheduler_list_node;
         util::IntrusiveListNode  wait_list_node;
+        util::IntrusivePairingHeapNode timer_node;
+        util::IntrusivePairingHeapNode deadline_node;
 
         using WaitList = util::IntrusiveListTraits<FiberLocalStorage, &FiberLocalStorage::wait_list_node>::List;
         WaitList                 wait_list;
@@ -69,9 +82,20 @@ namespace dd::ukern {
         u32                     *lock_address;
         u32                     *wait_address;
         impl::WaitableObject    *waitable_object;
+        impl::WaitAddressBucket *wait_bucket;
         u64                      timeout;
         u32                      last_result;
         u32                      fiber_state;
+        u32                      run_list_index;
+        s64                      relative_deadline_tick;
+        s64                      deadline_budget_tick;
+        u64                      absolute_deadline;
+        s64                      deadline_budget_left;
+        u64                      dispatch_tick;
+        u32                      deadline_job_count;
+        u32                      deadline_miss_count;
+        u32                      deadline_overrun_count;
+        bool                     is_deadline_job_active;
         const char              *fiber_name;
         char                     fiber_name_storage[MaxFiberNameLength];
 
@@ -79,10 +103,40 @@ namespace dd::ukern {
 
         constexpr ALWAYS_INLINE FiberLocalStorage() {/*...*/}
 
-        bool IsSchedulable(u32 core_number, u64 time);
-        void ReleaseLockWaitListUnsafe();
+        /* Joiners wait on the fiber's storage, the handle table revalidates them against reuse */
+        constexpr ALWAYS_INLINE u32 *GetJoinAddress() { return std::addressof(fiber_state); }
+
+        /* Deadline fibers run ahead of static priorities while their current job has budget left */
+        constexpr ALWAYS_INLINE bool IsDeadlineRunnable() const { return is_deadline_job_active == true && 0 < deadline_budget_left; }
+
+        bool IsSchedulable(u32 core_number);
+        void SetCoreMaskUnsafe(const UKernCoreMask &allowed_core_mask);
+        void AddLockWaiterUnsafe(FiberLocalStorage *waiter);
+        s32  GetInheritedPriorityUnsafe() const;
+        void ReleaseLockWaitListUnsafe(u32 *lock_address);
     };
 
+    namespace impl {
+
+        /* Sleeping and timed waiting fibers are ordered by their absolute timeout */
+        struct FiberTimeoutComparator {
+            static constexpr ALWAYS_INLINE bool Compare(const FiberLocalStorage &lhs, const FiberLocalStorage &rhs) {
+                return lhs.timeout < rhs.timeout;
+            }
+        };
+
+        using FiberTimerHeap = util::IntrusivePairingHeapTraits<FiberLocalStorage, &FiberLocalStorage::timer_node, FiberTimeoutComparator>::Heap;
+
+        /* Runnable deadline fibers are ordered by their current job's absolute deadline */
+        struct FiberDeadlineComparator {
+            static constexpr ALWAYS_INLINE bool Compare(const FiberLocalStorage &lhs, const FiberLocalStorage &rhs) {
+                return lhs.absolute_deadline < rhs.absolute_deadline;
+            }
+        };
+
+        using FiberDeadlineHeap = util::IntrusivePairingHeapTraits<FiberLocalStorage, &FiberLocalStorage::deadline_node, FiberDeadlineComparator>::Heap;
+    }
+
     constexpr ALWAYS_INLINE size_t UserFiberStorageSize = MaxThreadCount * sizeof(FiberLocalStorage);
 
     typedef FiberLocalStorage ThreadType;
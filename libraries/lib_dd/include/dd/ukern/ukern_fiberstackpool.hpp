@@ -0,0 +1,55 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::ukern::impl {
+
+    /* Exited fiber stacks are cached by power of two size class, so a spawn is a free list pop and an initial frame rebuild */
+    class FiberStackPool {
+        public:
+            static constexpr u32    SizeClassCount     = 7;
+            static constexpr size_t MaxPooledStackSize = MinFiberStackSize << (SizeClassCount - 1);
+        private:
+            struct SizeClass {
+                BusyMutex     mutex;
+                FiberContext  free_list;
+
+                constexpr ALWAYS_INLINE SizeClass() : mutex(), free_list(nullptr) {/*...*/}
+            };
+        private:
+            SizeClass        m_size_class_array[SizeClassCount];
+            std::atomic<u64> m_hit_count;
+            std::atomic<u64> m_miss_count;
+            std::atomic<u64> m_bytes_held;
+        private:
+            static constexpr ALWAYS_INLINE u32 GetSizeClass(size_t stack_size) {
+                if (stack_size <= MinFiberStackSize)  { return 0; }
+                if (MaxPooledStackSize < stack_size) { return UnpooledStackSizeClass; }
+
+                /* Round up to the next power of two */
+                return (64 - util::CountLeftZeroBits64(stack_size - 1)) - (64 - util::CountLeftZeroBits64(MinFiberStackSize - 1));
+            }
+        public:
+            constexpr ALWAYS_INLINE FiberStackPool() : m_size_class_array(), m_hit_count(0), m_miss_count(0), m_bytes_held(0) {/*...*/}
+
+            FiberContext Allocate(size_t stack_size, FiberMainFunction fiber_main, void *arg);
+            void         Free(FiberContext fiber_context);
+
+            ALWAYS_INLINE u64 GetHitCount()  const { return m_hit_count.load(std::memory_order_relaxed); }
+            ALWAYS_INLINE u64 GetMissCount() const { return m_miss_count.load(std::memory_order_relaxed); }
+            ALWAYS_INLINE u64 GetBytesHeld() const { return m_bytes_held.load(std::memory_order_relaxed); }
+    };
+}
@@ -17,51 +17,101 @@
 
 namespace dd::ukern {
 
+    /* Handle lookups are wait-free, generation checked reads of chunked entries. Only reserve and free are serialized, growing the table by a chunk when it's free list is empty */
     class HandleTable {
         public:
-            static constexpr size_t MaxHandles = 256;
-            static constexpr size_t CounterBitOffset = 0xf;
+            static constexpr size_t IndexBitCount        = 16;
+            static constexpr size_t CounterBitOffset     = IndexBitCount;
+            static constexpr u32    IndexMask            = (1 << IndexBitCount) - 1;
+            static constexpr u32    MaxCounterValue      = 0x3fff;
+            static constexpr size_t ChunkEntryCountShift = 8;
+            static constexpr size_t ChunkEntryCount      = (1 << ChunkEntryCountShift);
+            static constexpr size_t MaxHandles           = (1 << IndexBitCount);
+            static constexpr size_t MaxChunkCount        = MaxHandles / ChunkEntryCount;
+            static constexpr u32    InvalidIndex         = 0xffff'ffff;
         private:
-            s16        m_counters[MaxHandles];
-            void      *m_objects[MaxHandles];
-            BusyMutex  m_table_mutex;
-            s32        m_indice_iter;
-            u16        m_active_handles;
-            u16        m_counter_value;
+            struct HandleEntry {
+                std::atomic<u32>    counter;
+                u32                 next_free_index;
+                std::atomic<void*>  object;
+            };
+        private:
+            std::atomic<HandleEntry*> m_chunk_array[MaxChunkCount];
+            BusyMutex                 m_table_mutex;
+            u32                       m_free_index;
+            u32                       m_chunk_count;
+            u32                       m_active_handles;
+            u16                       m_counter_value;
+        private:
+            ALWAYS_INLINE HandleEntry *GetEntry(u32 index) {
+                HandleEntry *chunk = m_chunk_array[index >> ChunkEntryCountShift].load(std::memory_order_acquire);
+                if (chunk == nullptr) { return nullptr; }
+                return chunk + (index & (ChunkEntryCount - 1));
+            }
+
+            bool AllocateChunkUnsafe() {
+
+                /* Fail once the index space is used */
+                if (MaxChunkCount <= m_chunk_count) { return false; }
+
+                HandleEntry *chunk = reinterpret_cast<HandleEntry*>(::malloc(sizeof(HandleEntry) * ChunkEntryCount));
+                if (chunk == nullptr) { return false; }
+
+                /* Link the new entries into the free list in index order */
+                const u32 base_index = m_chunk_count * ChunkEntryCount;
+                for (u32 i = ChunkEntryCount; i != 0; --i) {
+                    HandleEntry *entry = std::construct_at(chunk + i - 1);
+                    entry->counter.store(0, std::memory_order_relaxed);
+                    entry->object.store(nullptr, std::memory_order_relaxed);
+                    entry->next_free_index = m_free_index;
+                    m_free_index           = base_index + i - 1;
+                }
+
+                /* Publish the chunk to readers */
+                m_chunk_array[m_chunk_count].store(chunk, std::memory_order_release);
+                ++m_chunk_count;
+
+                return true;
+            }
         public:
-            constexpr ALWAYS_INLINE HandleTable() : m_counters{}, m_objects{}, m_table_mutex(), m_indice_iter(-1), m_active_handles(0), m_counter_value(1) {/*...*/}
+            constexpr ALWAYS_INLINE HandleTable() : m_chunk_array{}, m_table_mutex(), m_free_index(InvalidIndex), m_chunk_count(0), m_active_handles(0), m_counter_value(1) {/*...*/}
 
-            constexpr ALWAYS_INLINE void Initialize() {
-                m_active_handles = 0;
-                m_counter_value  = 1;
-                for (s32 i = 0; i < MaxHandles; ++i) {
-                    m_objects[i]  = nullptr;
-                    m_counters[i] = i - 1;
-                    m_indice_iter = i;
+            void Initialize() {
+                this->Finalize();
+                m_counter_value = 1;
+            }
+
+            /* Releases all chunks, no handles may be looked up concurrently */
+            void Finalize() {
+                for (u32 i = 0; i < m_chunk_count; ++i) {
+                    ::free(m_chunk_array[i].load(std::memory_order_relaxed));
+                    m_chunk_array[i].store(nullptr, std::memory_order_relaxed);
                 }
+                m_free_index     = InvalidIndex;
+                m_chunk_count    = 0;
+                m_active_handles = 0;
             }
 
             bool ReserveHandle(u32 *out_handle, void *object) {
                 ScopedBusyMutex lock(std::addressof(m_table_mutex));
 
-                if (MaxHandles <= m_active_handles) { return false; }
+                /* Grow on empty free list */
+                if (m_free_index == InvalidIndex && this->AllocateChunkUnsafe() == false) { return false; }
 
-                const u16 index = m_indice_iter;
-                m_indice_iter   = m_counters[index];
+                const u32 index    = m_free_index;
+                HandleEntry *entry = this->GetEntry(index);
+                m_free_index       = entry->next_free_index;
 
+                /* Publish the object before the counter so a reader matching the counter observes it */
                 const u16 counter = m_counter_value;
-                m_counters[index] = counter;
-                m_objects[index] = object;
+                entry->object.store(object, std::memory_order_release);
+                entry->counter.store(counter, std::memory_order_release);
 
                 ++m_active_handles;
 
-                u16 next = 1;
-                if (-1 < static_cast<s16>(m_counter_value + 1)) {
-                    next = m_counter_value + 1;
-                }
-                m_counter_value = next;
+                m_counter_value = (m_counter_value < MaxCounterValue) ? m_counter_value + 1 : 1;
 
-                *out_handle = (index & 0x7fff) | (counter << CounterBitOffset);
+                *out_handle = index | (static_cast<u32>(counter) << CounterBitOffset);
 
                 return true;
             }
@@ -69,28 +119,56 @@ namespace dd::ukern {
             bool FreeHandle(u32 handle) {
                 ScopedBusyMutex lock(std::addressof(m_table_mutex));
 
-                if ((handle == 0) || ((handle >> CounterBitOffset) == 0)) { return false; }
+                const u32 counter = (handle >> CounterBitOffset);
+                if ((handle == 0) || (counter == 0) || (MaxCounterValue < counter)) { return false; }
+
+                const u32 index    = (handle & IndexMask);
+                HandleEntry *entry = this->GetEntry(index);
+                if (entry == nullptr || entry->counter.load(std::memory_order_relaxed) != counter) { return false; }
 
-                const u32 index = (handle & 0x7fff);
-                if (MaxHandles < index || m_objects[index] == nullptr || (handle >> CounterBitOffset) != m_counters[index]) { return false; }
+                /* Invalidate the counter first, the object store releases it to readers */
+                entry->counter.store(0, std::memory_order_relaxed);
+                entry->object.store(nullptr, std::memory_order_release);
 
-                m_objects[index] = nullptr;
-                m_counters[index] = m_indice_iter;
-                m_indice_iter = index;
+                entry->next_free_index = m_free_index;
+                m_free_index           = index;
                 --m_active_handles;
 
                 return true;
             }
 
             void *GetObjectByHandle(u32 handle) {
-                ScopedBusyMutex lock(std::addressof(m_table_mutex));
 
-                if (((handle >> 0x1e) != 0) || (handle == 0) || ((handle >> 0xf) == 0)) { return nullptr; }
+                const u32 counter = (handle >> CounterBitOffset);
+                if ((handle == 0) || (counter == 0) || (MaxCounterValue < counter)) { return nullptr; }
+
+                const u32 index    = (handle & IndexMask);
+                HandleEntry *entry = this->GetEntry(index);
+                if (entry == nullptr) { return nullptr; }
 
-                const u32 index = (handle & 0x7fff);
-                if ((MaxHandles < index) || (handle >> 0xf != m_counters[index])) { return nullptr; }
+                /* Recheck the counter after the object load in case the entry was freed and reserved in between */
+                if (entry->counter.load(std::memory_order_acquire) != counter) { return nullptr; }
+                void *object = entry->object.load(std::memory_order_acquire);
+                if (entry->counter.load(std::memory_order_acquire) != counter) { return nullptr; }
 
-                return m_objects[index];
+                return object;
             }
+
+            /* Visits every reserved object, reserving and freeing handles waits meanwhile */
+            template<typename Function>
+            void ForEachObject(Function function) {
+                ScopedBusyMutex lock(std::addressof(m_table_mutex));
+
+                for (u32 i = 0; i < m_chunk_count * ChunkEntryCount; ++i) {
+                    void *object = this->GetEntry(i)->object.load(std::memory_order_relaxed);
+                    if (object != nullptr) { function(object); }
+                }
+            }
+
+            ALWAYS_INLINE u32 GetActiveHandleCount() const { return m_active_handles; }
     };
+    static_assert(MaxThreadCount <= HandleTable::MaxHandles);
+
+    /* Lock words store a handle with the waiter bit above it */
+    static_assert(((HandleTable::MaxHandles - 1) | (HandleTable::MaxCounterValue << HandleTable::CounterBitOffset)) < FiberLocalStorage::HasChildWaitersBit);
 }
@@ -17,5 +17,12 @@
 
 namespace dd::ukern {
 
-    void InitializeUKern(u64 core_mask);
+    /* Starts one ukern core per processor in the mask, processor indices are flat across processor groups */
+    void InitializeUKern(const UKernCoreMask &processor_mask);
+
+    /* Work stealing prefers cores closest in the topology, the single argument overload queries it from the OS */
+    void InitializeUKern(const UKernCoreMask &processor_mask, const sys::ProcessorTopology &processor_topology);
+
+    /* Cores are numbered contiguously from zero for core ids */
+    u32  GetCoreCount();
 }
@@ -0,0 +1,71 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::ukern {
+
+    class InternalBarrier {
+        public:
+            static constexpr u32 HasWaitersBit = 0x8000'0000;
+            static constexpr u32 PhaseMask     = ~HasWaitersBit;
+        private:
+            u32 m_expected_count;
+            u32 m_arrived_count;
+            u32 m_phase;
+        public:
+            constexpr ALWAYS_INLINE explicit InternalBarrier(u32 expected_count) : m_expected_count(expected_count), m_arrived_count(0), m_phase(0) {/*...*/}
+
+            /* Returns true for the last fiber to arrive in a phase */
+            bool ArriveAndWait() {
+
+                /* Read the phase before arriving, the last arrival can't advance it until we've arrived */
+                std::atomic_ref<u32> phase(m_phase);
+                const u32 arrive_phase = phase.load() & PhaseMask;
+
+                if (std::atomic_ref<u32>(m_arrived_count).fetch_add(1) + 1 == m_expected_count) {
+
+                    /* Reset for the next phase before releasing the waiters of this one */
+                    std::atomic_ref<u32>(m_arrived_count).store(0);
+                    const u32 last_phase = phase.exchange((arrive_phase + 1) & PhaseMask);
+
+                    if ((last_phase & HasWaitersBit) != 0) {
+                        impl::GetScheduler()->WakeByAddressImpl(std::addressof(m_phase), 0xffff'ffff);
+                    }
+                    return true;
+                }
+
+                for (;;) {
+                    u32 last_phase = phase.load();
+                    if ((last_phase & PhaseMask) != arrive_phase) { return false; }
+
+                    /* Mark waiters so the last arrival knows to wake */
+                    if ((last_phase & HasWaitersBit) == 0) {
+                        if (phase.compare_exchange_strong(last_phase, last_phase | HasWaitersBit) == false) { continue; }
+                    }
+
+                    const Result wait_result = impl::GetScheduler()->WaitForAddressIfEqualImpl(std::addressof(m_phase), arrive_phase | HasWaitersBit, TimeSpan::MaxTime);
+                    if (wait_result == ResultInvalidWaitAddressValue) { continue; }
+                    RESULT_ABORT_UNLESS(wait_result, ResultSuccess);
+                }
+            }
+
+            constexpr ALWAYS_INLINE u32 GetExpectedCount() const { return m_expected_count; }
+
+            void arrive_and_wait() {
+                this->ArriveAndWait();
+            }
+    };
+}
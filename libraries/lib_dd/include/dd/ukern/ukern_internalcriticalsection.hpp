@@ -20,30 +20,80 @@ namespace dd::ukern {
     class InternalCriticalSection {
         private:
             friend class InternalConditionVariable;
+        public:
+            static constexpr u32 MinSpinCount    = 4;
+            static constexpr u32 MaxSpinCount    = 64;
+            static constexpr u32 MaxBackoffCount = 8;
         private:
             UKernHandle m_handle;
+            u32         m_spin_history;
+        private:
+            bool TrySpinEnter(UKernHandle tag, UKernHandle owner) {
+
+                std::atomic_ref<UKernHandle> handle(m_handle);
+                std::atomic_ref<u32>         spin_history(m_spin_history);
+
+                /* Spin for up to twice the recent acquire time, locks held past the spin phase decay towards the minimum */
+                const u32 last_history = spin_history.load(std::memory_order_relaxed);
+                const u32 spin_limit   = (MaxSpinCount < (last_history * 2) + MinSpinCount) ? MaxSpinCount : (last_history * 2) + MinSpinCount;
+
+                u32 backoff_count = 1;
+                for (u32 spin_count = 0; spin_count < spin_limit; ++spin_count) {
+
+                    /* Waiters are handed the lock directly on release, and a switched out owner can not release during our spin */
+                    if ((owner & FiberLocalStorage::HasChildWaitersBit) != 0) { break; }
+                    if (owner != 0 && impl::GetScheduler()->IsFiberRunningImpl(owner) == false) { break; }
+
+                    /* Exponential backoff */
+                    for (u32 i = 0; i < backoff_count; ++i) {
+                        util::x64::pause();
+                    }
+                    backoff_count = (backoff_count < MaxBackoffCount) ? backoff_count << 1 : MaxBackoffCount;
+
+                    /* Try to acquire once released */
+                    owner = handle.load(std::memory_order_relaxed);
+                    if (owner != 0) { continue; }
+                    if (handle.compare_exchange_strong(owner, tag) == false) { continue; }
+
+                    /* Blend the acquire time into the lock's history */
+                    spin_history.store(last_history + ((static_cast<s32>(spin_count) - static_cast<s32>(last_history)) / 8), std::memory_order_relaxed);
+
+                    return true;
+                }
+
+                spin_history.store(last_history / 2, std::memory_order_relaxed);
+
+                return false;
+            }
         public:
-            constexpr ALWAYS_INLINE InternalCriticalSection() : m_handle(0) {/*...*/}
+            constexpr ALWAYS_INLINE InternalCriticalSection() : m_handle(0), m_spin_history(0) {/*...*/}
 
             void Enter() {
 
                 const ThreadType *current_thread = ukern::GetCurrentThread();
                 const UKernHandle tag            = current_thread->ukern_fiber_handle;
 
+                /* Try to acquire the critical section, then spin while the owner is running before arbitrating */
+                UKernHandle owner = 0;
+                if (std::atomic_ref<UKernHandle>(m_handle).compare_exchange_strong(owner, tag) == true) { return; }
+                if (this->TrySpinEnter(tag, owner) == true) { return; }
+
                 /* Acquire loop */
                 for (;;) {
                     /* Try to acquire the critical section */
-                    const UKernHandle other_waiter = ::InterlockedCompareExchange(std::addressof(m_handle), tag, 0);
-                    if (other_waiter == 0) { return; }
+                    UKernHandle other_waiter = 0;
+                    if (std::atomic_ref<UKernHandle>(m_handle).compare_exchange_strong(other_waiter, tag) == true) { return; }
 
                     /* Set tag bit */
                     if (((other_waiter >> 0x1e) & 1) == 0) {
-                        const UKernHandle prev_value = ::InterlockedOr(reinterpret_cast<volatile long int*>(std::addressof(m_handle)), FiberLocalStorage::HasChildWaitersBit);
+                        const UKernHandle prev_value = std::atomic_ref<UKernHandle>(m_handle).fetch_or(FiberLocalStorage::HasChildWaitersBit);
                         if (prev_value != other_waiter) { continue; }
                     }
 
-                    /* If we fail, lock the thread */
-                    RESULT_ABORT_UNLESS(impl::GetScheduler()->ArbitrateLockImpl(other_waiter & (~FiberLocalStorage::HasChildWaitersBit), std::addressof(m_handle), tag), ResultSuccess);
+                    /* If we fail, lock the thread. Retry if the owner released the critical section before we could wait on it */
+                    const Result wait_result = impl::GetScheduler()->ArbitrateLockImpl(other_waiter & (~FiberLocalStorage::HasChildWaitersBit), std::addressof(m_handle), tag);
+                    if (wait_result == ResultInvalidLockAddressValue) { continue; }
+                    RESULT_ABORT_UNLESS(wait_result, ResultSuccess);
                     if ((m_handle & (~FiberLocalStorage::HasChildWaitersBit)) == tag) {
                         return;
                     }
@@ -53,15 +103,18 @@ namespace dd::ukern {
             bool TryEnter() {
                 const ThreadType *current_thread = ukern::GetCurrentThread();
                 const UKernHandle tag            = current_thread->ukern_fiber_handle;
-                const UKernHandle other_waiter   = ::InterlockedCompareExchange(std::addressof(m_handle), tag, 0);
-                return other_waiter == 0;
+                UKernHandle other_waiter         = 0;
+                return std::atomic_ref<UKernHandle>(m_handle).compare_exchange_strong(other_waiter, tag);
             }
 
             void Leave() {
 
+                /* Release if there are no waiters, the compare exchange fails if a waiter sets the tag bit concurrently */
+                UKernHandle tag = ukern::GetCurrentThread()->ukern_fiber_handle;
+                if (std::atomic_ref<UKernHandle>(m_handle).compare_exchange_strong(tag, 0) == true) { return; }
+
                 /* Unlock waiters */
-                if (((m_handle >> 0x1e) & 1) == 1) { RESULT_ABORT_UNLESS(impl::GetScheduler()->ArbitrateUnlockImpl(std::addressof(m_handle)), ResultSuccess); }
-                else { ::InterlockedExchange(std::addressof(m_handle), 0); }
+                RESULT_ABORT_UNLESS(impl::GetScheduler()->ArbitrateUnlockImpl(std::addressof(m_handle)), ResultSuccess);
             }
 
             void lock() {
@@ -78,5 +131,5 @@ namespace dd::ukern {
                 return (m_handle & (~FiberLocalStorage::HasChildWaitersBit)) == ukern::GetCurrentThread()->ukern_fiber_handle;
             }
     };
-    static_assert(sizeof(InternalCriticalSection) == sizeof(UKernHandle));
+    static_assert(sizeof(InternalCriticalSection) == sizeof(UKernHandle) + sizeof(u32));
 }
@@ -0,0 +1,98 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::ukern {
+
+    class InternalLatch {
+        public:
+            static constexpr u32 HasWaitersBit = 0x8000'0000;
+            static constexpr u32 CountMask     = ~HasWaitersBit;
+        private:
+            u32 m_count;
+        public:
+            constexpr ALWAYS_INLINE explicit InternalLatch(u32 expected_count) : m_count(expected_count & CountMask) {/*...*/}
+
+            void CountDown(u32 count = 1) {
+
+                /* The count never borrows from the waiter bit while callers stay within the expected count */
+                const u32 last_count = std::atomic_ref<u32>(m_count).fetch_sub(count);
+                DD_ASSERT(count <= (last_count & CountMask));
+
+                /* Only wake when the count reaches zero with fibers waiting on it */
+                if ((last_count & CountMask) != count || (last_count & HasWaitersBit) == 0) { return; }
+
+                impl::GetScheduler()->WakeByAddressImpl(std::addressof(m_count), 0xffff'ffff);
+            }
+
+            bool TryWait() const {
+                return (std::atomic_ref<u32>(const_cast<u32&>(m_count)).load() & CountMask) == 0;
+            }
+
+            void Wait() {
+
+                std::atomic_ref<u32> latch_count(m_count);
+                for (;;) {
+                    u32 last_count = latch_count.load();
+                    if ((last_count & CountMask) == 0) { return; }
+
+                    /* Mark waiters so the final count down knows to wake */
+                    if ((last_count & HasWaitersBit) == 0) {
+                        if (latch_count.compare_exchange_strong(last_count, last_count | HasWaitersBit) == false) { continue; }
+                    }
+
+                    const Result wait_result = impl::GetScheduler()->WaitForAddressIfEqualImpl(std::addressof(m_count), last_count | HasWaitersBit, TimeSpan::MaxTime);
+                    if (wait_result == ResultInvalidWaitAddressValue) { continue; }
+                    RESULT_ABORT_UNLESS(wait_result, ResultSuccess);
+                }
+            }
+
+            Task<void> WaitAsync() {
+
+                std::atomic_ref<u32> latch_count(m_count);
+                for (;;) {
+                    u32 last_count = latch_count.load();
+                    if ((last_count & CountMask) == 0) { co_return; }
+
+                    if ((last_count & HasWaitersBit) == 0) {
+                        if (latch_count.compare_exchange_strong(last_count, last_count | HasWaitersBit) == false) { continue; }
+                    }
+
+                    const Result wait_result = co_await WaitForAddressIfEqualAsync(std::addressof(m_count), last_count | HasWaitersBit);
+                    if (wait_result == ResultInvalidWaitAddressValue) { continue; }
+                    impl::AbortUnlessAsyncWaitSucceeded(wait_result);
+                }
+            }
+
+            void ArriveAndWait(u32 count = 1) {
+                this->CountDown(count);
+                this->Wait();
+            }
+
+            void count_down(u32 count = 1) {
+                this->CountDown(count);
+            }
+            bool try_wait() const {
+                return this->TryWait();
+            }
+            void wait() {
+                this->Wait();
+            }
+            void arrive_and_wait(u32 count = 1) {
+                this->ArriveAndWait(count);
+            }
+    };
+}
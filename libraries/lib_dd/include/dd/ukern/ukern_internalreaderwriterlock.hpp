@@ -0,0 +1,142 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::ukern {
+
+    class InternalReaderWriterLock {
+        public:
+            static constexpr s32 MaxReaderCount = 0x4000'0000;
+        private:
+            InternalCriticalSection m_writer_cs;
+            s32                     m_reader_count;
+            s32                     m_departing_reader_count;
+            u32                     m_reader_wake_count;
+            u32                     m_writer_wake_count;
+        private:
+            static void WaitForWake(u32 *wake_count) {
+
+                std::atomic_ref<u32> wake_count_ref(*wake_count);
+                for (;;) {
+                    /* Consume a wake if one has been released */
+                    u32 last_count = wake_count_ref.load();
+                    while (last_count != 0) {
+                        if (wake_count_ref.compare_exchange_weak(last_count, last_count - 1) == true) { return; }
+                    }
+
+                    /* Otherwise wait for the next release, retry if one arrived before we could wait */
+                    const Result wait_result = impl::GetScheduler()->WaitForAddressIfEqualImpl(wake_count, 0, TimeSpan::MaxTime);
+                    if (wait_result == ResultInvalidWaitAddressValue) { continue; }
+                    RESULT_ABORT_UNLESS(wait_result, ResultSuccess);
+                }
+            }
+
+            static void ReleaseWake(u32 *wake_count, u32 count) {
+                std::atomic_ref<u32>(*wake_count).fetch_add(count);
+                impl::GetScheduler()->WakeByAddressImpl(wake_count, count);
+            }
+        public:
+            constexpr ALWAYS_INLINE InternalReaderWriterLock() : m_writer_cs(), m_reader_count(0), m_departing_reader_count(0), m_reader_wake_count(0), m_writer_wake_count(0) {/*...*/}
+
+            void EnterShared() {
+
+                /* Readers only wait once a writer has subtracted MaxReaderCount, the reader is still counted for the writer to admit on release */
+                if (0 <= std::atomic_ref<s32>(m_reader_count).fetch_add(1)) { return; }
+
+                WaitForWake(std::addressof(m_reader_wake_count));
+            }
+
+            bool TryEnterShared() {
+
+                /* Fail while a writer holds or is waiting for the lock */
+                std::atomic_ref<s32> reader_count(m_reader_count);
+                s32 last_count = reader_count.load();
+                while (0 <= last_count) {
+                    if (reader_count.compare_exchange_weak(last_count, last_count + 1) == true) { return true; }
+                }
+                return false;
+            }
+
+            void LeaveShared() {
+
+                /* Release if no writer is waiting */
+                if (0 < std::atomic_ref<s32>(m_reader_count).fetch_sub(1)) { return; }
+
+                /* The last reader ahead of a waiting writer hands it the lock */
+                if (std::atomic_ref<s32>(m_departing_reader_count).fetch_sub(1) == 1) {
+                    ReleaseWake(std::addressof(m_writer_wake_count), 1);
+                }
+            }
+
+            void Enter() {
+
+                /* Serialize writers */
+                m_writer_cs.Enter();
+
+                /* Block new readers, then wait for the readers already inside to leave */
+                const s32 active_reader_count = std::atomic_ref<s32>(m_reader_count).fetch_sub(MaxReaderCount);
+                if (active_reader_count != 0 && std::atomic_ref<s32>(m_departing_reader_count).fetch_add(active_reader_count) + active_reader_count != 0) {
+                    WaitForWake(std::addressof(m_writer_wake_count));
+                }
+            }
+
+            bool TryEnter() {
+
+                if (m_writer_cs.TryEnter() == false) { return false; }
+
+                /* Only succeed without readers */
+                s32 expected_count = 0;
+                if (std::atomic_ref<s32>(m_reader_count).compare_exchange_strong(expected_count, -MaxReaderCount) == true) { return true; }
+
+                m_writer_cs.Leave();
+                return false;
+            }
+
+            void Leave() {
+
+                /* Admit the readers that arrived while we held the lock before the next writer */
+                const s32 blocked_reader_count = std::atomic_ref<s32>(m_reader_count).fetch_add(MaxReaderCount) + MaxReaderCount;
+                if (blocked_reader_count != 0) {
+                    ReleaseWake(std::addressof(m_reader_wake_count), blocked_reader_count);
+                }
+
+                m_writer_cs.Leave();
+            }
+
+            void lock() {
+                this->Enter();
+            }
+            void unlock() {
+                this->Leave();
+            }
+            bool try_lock() {
+                return this->TryEnter();
+            }
+            void lock_shared() {
+                this->EnterShared();
+            }
+            void unlock_shared() {
+                this->LeaveShared();
+            }
+            bool try_lock_shared() {
+                return this->TryEnterShared();
+            }
+
+            bool IsLockedByCurrentThread() {
+                return m_writer_cs.IsLockedByCurrentThread() && std::atomic_ref<s32>(m_reader_count).load() < 0;
+            }
+    };
+}
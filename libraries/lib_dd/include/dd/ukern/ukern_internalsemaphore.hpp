@@ -0,0 +1,115 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::ukern {
+
+    class InternalSemaphore {
+        private:
+            u32 m_count;
+            u32 m_waiter_count;
+        public:
+            constexpr ALWAYS_INLINE explicit InternalSemaphore(u32 initial_count = 0) : m_count(initial_count), m_waiter_count(0) {/*...*/}
+
+            bool TryAcquire() {
+
+                /* Take a count if one is available */
+                std::atomic_ref<u32> count(m_count);
+                u32 last_count = count.load();
+                while (last_count != 0) {
+                    if (count.compare_exchange_weak(last_count, last_count - 1) == true) { return true; }
+                }
+                return false;
+            }
+
+            bool TimedAcquire(s64 timeout_ns) {
+
+                if (this->TryAcquire() == true) { return true; }
+
+                /* Register as a waiter before the final check, releasers only wake once they see a waiter */
+                std::atomic_ref<u32> waiter_count(m_waiter_count);
+                waiter_count.fetch_add(1);
+
+                /* Woken fibers compete with running ones for the count rather than being handed it, so a busy semaphore doesn't convoy */
+                const s64 absolute_timeout = impl::GetAbsoluteTimeToWakeup(timeout_ns);
+                bool is_acquired = false;
+                for (;;) {
+                    if (this->TryAcquire() == true) { is_acquired = true; break; }
+
+                    const Result wait_result = impl::GetScheduler()->WaitForAddressIfEqualImpl(std::addressof(m_count), 0, absolute_timeout);
+                    if (wait_result == ResultTimeout) { is_acquired = this->TryAcquire(); break; }
+                }
+
+                waiter_count.fetch_sub(1);
+
+                return is_acquired;
+            }
+
+            void Acquire() {
+                this->TimedAcquire(-1);
+            }
+
+            /* Coroutine acquire, waiting coroutines are woken by releases like fibers */
+            Task<bool> TimedAcquireAsync(s64 timeout_ns) {
+
+                if (this->TryAcquire() == true) { co_return true; }
+
+                std::atomic_ref<u32> waiter_count(m_waiter_count);
+                waiter_count.fetch_add(1);
+
+                const s64 absolute_timeout = impl::GetAbsoluteTimeToWakeup(timeout_ns);
+                bool is_acquired = false;
+                for (;;) {
+                    if (this->TryAcquire() == true) { is_acquired = true; break; }
+
+                    const Result wait_result = co_await impl::WaitForAddressIfEqualAwaiter(std::addressof(m_count), 0, absolute_timeout);
+                    if (wait_result == ResultTimeout) { is_acquired = this->TryAcquire(); break; }
+                }
+
+                waiter_count.fetch_sub(1);
+
+                co_return is_acquired;
+            }
+
+            Task<bool> AcquireAsync() {
+                return this->TimedAcquireAsync(-1);
+            }
+
+            void Release(u32 release_count = 1) {
+
+                std::atomic_ref<u32>(m_count).fetch_add(release_count);
+
+                /* Only involve the scheduler when fibers are waiting */
+                if (std::atomic_ref<u32>(m_waiter_count).load() == 0) { return; }
+
+                impl::GetScheduler()->WakeByAddressImpl(std::addressof(m_count), release_count);
+            }
+
+            u32 GetCount() const {
+                return std::atomic_ref<u32>(const_cast<u32&>(m_count)).load();
+            }
+
+            void acquire() {
+                this->Acquire();
+            }
+            void release() {
+                this->Release();
+            }
+            bool try_acquire() {
+                return this->TryAcquire();
+            }
+    };
+}
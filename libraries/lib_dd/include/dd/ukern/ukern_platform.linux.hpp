@@ -0,0 +1,177 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/* The ukern thread api keeps the Win32 priority range */
+#define THREAD_PRIORITY_LOWEST       -2
+#define THREAD_PRIORITY_BELOW_NORMAL -1
+#define THREAD_PRIORITY_NORMAL        0
+#define THREAD_PRIORITY_ABOVE_NORMAL  1
+#define THREAD_PRIORITY_HIGHEST       2
+
+namespace dd::ukern::impl {
+
+    /* Linux backend, fibers run on mmap'd stacks and cores park on a futex */
+    using CoreThreadHandle   = pthread_t;
+    using CoreThreadFunction = void (*)(size_t);
+
+    constexpr ALWAYS_INLINE s64 InfiniteParkTime = -1;
+
+    ALWAYS_INLINE long FutexWait(u32 *address, u32 compare_value, const struct timespec *timeout) {
+        return ::syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, compare_value, timeout, nullptr, 0);
+    }
+
+    ALWAYS_INLINE long FutexWake(u32 *address, u32 count) {
+        return ::syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+    }
+
+    class PlatformMutex {
+        private:
+            u32 m_state;
+        private:
+            static constexpr u32 State_Unlocked  = 0;
+            static constexpr u32 State_Locked    = 1;
+            static constexpr u32 State_Contended = 2;
+        public:
+            constexpr ALWAYS_INLINE PlatformMutex() : m_state(State_Unlocked) {/*...*/}
+
+            ALWAYS_INLINE void Enter() {
+                std::atomic_ref<u32> state(m_state);
+
+                /* Uncontended acquire */
+                u32 last_state = State_Unlocked;
+                if (state.compare_exchange_strong(last_state, State_Locked, std::memory_order_acquire) == true) { return; }
+
+                /* Mark contended and sleep until we take the mutex */
+                if (last_state != State_Contended) {
+                    last_state = state.exchange(State_Contended, std::memory_order_acquire);
+                }
+                while (last_state != State_Unlocked) {
+                    FutexWait(std::addressof(m_state), State_Contended, nullptr);
+                    last_state = state.exchange(State_Contended, std::memory_order_acquire);
+                }
+            }
+
+            ALWAYS_INLINE void Leave() {
+                std::atomic_ref<u32> state(m_state);
+                if (state.exchange(State_Unlocked, std::memory_order_release) == State_Contended) {
+                    FutexWake(std::addressof(m_state), 1);
+                }
+            }
+    };
+
+    /* Processor indices are cpu ids, cpus outside our cpuset keep the default affinity */
+    void SetCurrentThreadProcessor(u32 processor_index);
+
+    ALWAYS_INLINE void SetCurrentThreadMinimumTimerSlack() {
+        /* The default 50us slack would swallow short park timeouts */
+        ::prctl(PR_SET_TIMERSLACK, 1, 0, 0, 0);
+    }
+
+    ALWAYS_INLINE void YieldCoreThread() {
+        ::sched_yield();
+    }
+
+    template<CoreThreadFunction ThreadMain>
+    void *CoreThreadMain(void *arg) {
+        const size_t core_number = reinterpret_cast<size_t>(arg);
+
+        /* Affinity was set at creation */
+        SetCurrentThreadMinimumTimerSlack();
+        ThreadMain(core_number);
+
+        return nullptr;
+    }
+
+    template<CoreThreadFunction ThreadMain>
+    CoreThreadHandle CreateCoreThread(u32 core_number, u32 processor_index) {
+
+        /* Create with the processor's affinity so the thread starts on it */
+        cpu_set_t cpu_set;
+        CPU_ZERO(std::addressof(cpu_set));
+        CPU_SET(processor_index, std::addressof(cpu_set));
+
+        pthread_attr_t thread_attributes = {};
+        ::pthread_attr_init(std::addressof(thread_attributes));
+        ::pthread_attr_setaffinity_np(std::addressof(thread_attributes), sizeof(cpu_set_t), std::addressof(cpu_set));
+
+        CoreThreadHandle thread_handle = {};
+        int result = ::pthread_create(std::addressof(thread_handle), std::addressof(thread_attributes), CoreThreadMain<ThreadMain>, reinterpret_cast<void*>(static_cast<size_t>(core_number)));
+        if (result == EINVAL) {
+            /* The processor is outside our cpuset, keep the default affinity */
+            result = ::pthread_create(std::addressof(thread_handle), nullptr, CoreThreadMain<ThreadMain>, reinterpret_cast<void*>(static_cast<size_t>(core_number)));
+        }
+        DD_ASSERT(result == 0);
+
+        ::pthread_attr_destroy(std::addressof(thread_attributes));
+
+        return thread_handle;
+    }
+
+    ALWAYS_INLINE CoreThreadHandle OpenCurrentCoreThread(u32 processor_index) {
+        SetCurrentThreadProcessor(processor_index);
+        SetCurrentThreadMinimumTimerSlack();
+        return ::pthread_self();
+    }
+
+    ALWAYS_INLINE void SuspendCoreThread([[maybe_unused]] CoreThreadHandle thread_handle) {
+        /* Linux has no way to suspend a single thread, other cores keep running until the process exits */
+    }
+
+    /* Per core park word, a core publishes it's intent to park here before rechecking for work */
+    class CoreParker {
+        private:
+            std::atomic<u32> m_park_word;
+        private:
+            static constexpr u32 State_Running = 0;
+            static constexpr u32 State_Parked  = 1;
+        public:
+            constexpr ALWAYS_INLINE CoreParker() : m_park_word(State_Running) {/*...*/}
+
+            ALWAYS_INLINE void Initialize() {/*...*/}
+
+            ALWAYS_INLINE void PrepareToPark() {
+                m_park_word.store(State_Parked);
+            }
+
+            ALWAYS_INLINE void CancelPark() {
+                m_park_word.store(State_Running, std::memory_order_relaxed);
+            }
+
+            ALWAYS_INLINE void Park(s64 timeout_ns) {
+
+                /* Futex timeouts are relative and nanosecond precise, timer slack is dropped on core threads */
+                struct timespec timeout = {};
+                timeout.tv_sec  = timeout_ns / 1'000'000'000;
+                timeout.tv_nsec = timeout_ns % 1'000'000'000;
+
+                FutexWait(reinterpret_cast<u32*>(std::addressof(m_park_word)), State_Parked, (timeout_ns == InfiniteParkTime) ? nullptr : std::addressof(timeout));
+                m_park_word.store(State_Running, std::memory_order_relaxed);
+            }
+
+            /* Lockless hint, a core may park or wake right after */
+            ALWAYS_INLINE bool IsParked() const {
+                return m_park_word.load(std::memory_order_relaxed) == State_Parked;
+            }
+
+            ALWAYS_INLINE void Unpark() {
+                if (m_park_word.load() == State_Running) { return; }
+                if (m_park_word.exchange(State_Running) == State_Parked) {
+                    FutexWake(reinterpret_cast<u32*>(std::addressof(m_park_word)), 1);
+                }
+            }
+    };
+}
@@ -0,0 +1,177 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/* Older SDKs lack the high resolution timer flag (Windows 10 1803+) */
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace dd::ukern::impl {
+
+    /* Win32 backend, fibers run on VirtualAlloc'd stacks and cores park on an event and high resolution timer */
+    using CoreThreadHandle   = HANDLE;
+    using CoreThreadFunction = void (*)(size_t);
+
+    constexpr ALWAYS_INLINE s64 InfiniteParkTime = -1;
+
+    class PlatformMutex {
+        private:
+            SRWLOCK m_srwlock;
+        public:
+            constexpr ALWAYS_INLINE PlatformMutex() : m_srwlock{} {/*...*/}
+
+            ALWAYS_INLINE void Enter() {
+                ::AcquireSRWLockExclusive(std::addressof(m_srwlock));
+            }
+
+            ALWAYS_INLINE void Leave() {
+                ::ReleaseSRWLockExclusive(std::addressof(m_srwlock));
+            }
+    };
+
+    /* Maps a flat processor index onto it's processor group, groups are numbered in order of their active processors */
+    ALWAYS_INLINE GROUP_AFFINITY GetProcessorGroupAffinity(u32 processor_index) {
+
+        GROUP_AFFINITY group_affinity = {};
+
+        const u16 group_count = ::GetActiveProcessorGroupCount();
+        for (u16 group = 0; group < group_count; ++group) {
+            const u32 group_processor_count = ::GetActiveProcessorCount(group);
+            if (processor_index < group_processor_count) {
+                group_affinity.Group = group;
+                group_affinity.Mask  = (1ull << processor_index);
+                return group_affinity;
+            }
+            processor_index -= group_processor_count;
+        }
+
+        DD_ASSERT(false);
+        return group_affinity;
+    }
+
+    template<CoreThreadFunction ThreadMain>
+    long unsigned int CoreThreadMain(void *arg) {
+        ThreadMain(reinterpret_cast<size_t>(arg));
+        return 0;
+    }
+
+    template<CoreThreadFunction ThreadMain>
+    CoreThreadHandle CreateCoreThread(u32 core_number, u32 processor_index) {
+
+        /* Create suspended so the thread starts on it's processor */
+        CoreThreadHandle thread_handle = ::CreateThread(nullptr, 0x1000, CoreThreadMain<ThreadMain>, reinterpret_cast<void*>(static_cast<size_t>(core_number)), CREATE_SUSPENDED, nullptr);
+        DD_ASSERT(thread_handle != INVALID_HANDLE_VALUE);
+
+        /* Group affinity lets cores live outside the process's primary processor group */
+        const GROUP_AFFINITY group_affinity = GetProcessorGroupAffinity(processor_index);
+        const bool result = ::SetThreadGroupAffinity(thread_handle, std::addressof(group_affinity), nullptr);
+        DD_ASSERT(result == true);
+
+        ::ResumeThread(thread_handle);
+
+        return thread_handle;
+    }
+
+    ALWAYS_INLINE void YieldCoreThread() {
+        ::SwitchToThread();
+    }
+
+    ALWAYS_INLINE CoreThreadHandle OpenCurrentCoreThread(u32 processor_index) {
+
+        /* Pin the calling thread */
+        const GROUP_AFFINITY group_affinity = GetProcessorGroupAffinity(processor_index);
+        const bool result0 = ::SetThreadGroupAffinity(::GetCurrentThread(), std::addressof(group_affinity), nullptr);
+        DD_ASSERT(result0 == true);
+
+        /* Duplicate the pseudo handle so other threads can use it */
+        CoreThreadHandle thread_handle = nullptr;
+        const bool result1 = ::DuplicateHandle(::GetCurrentProcess(), ::GetCurrentThread(), ::GetCurrentProcess(), std::addressof(thread_handle), 0, false, DUPLICATE_SAME_ACCESS);
+        DD_ASSERT(result1 == true);
+
+        return thread_handle;
+    }
+
+    ALWAYS_INLINE void SuspendCoreThread(CoreThreadHandle thread_handle) {
+        ::SuspendThread(thread_handle);
+    }
+
+    /* Per core park word, a core publishes it's intent to park here before rechecking for work */
+    class CoreParker {
+        private:
+            std::atomic<u32> m_park_word;
+            HANDLE           m_wake_event;
+            HANDLE           m_park_timer;
+        private:
+            static constexpr u32 State_Running = 0;
+            static constexpr u32 State_Parked  = 1;
+        public:
+            constexpr ALWAYS_INLINE CoreParker() : m_park_word(State_Running), m_wake_event(nullptr), m_park_timer(nullptr) {/*...*/}
+
+            void Initialize() {
+
+                m_wake_event = ::CreateEventW(nullptr, false, false, nullptr);
+                DD_ASSERT(m_wake_event != nullptr);
+
+                /* WaitOnAddress timeouts are bound to the system tick, so timed parks wait on a high resolution timer */
+                m_park_timer = ::CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+                if (m_park_timer == nullptr) {
+                    /* Fallback for systems predating high resolution timers */
+                    m_park_timer = ::CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+                }
+                DD_ASSERT(m_park_timer != nullptr);
+            }
+
+            ALWAYS_INLINE void PrepareToPark() {
+                m_park_word.store(State_Parked);
+            }
+
+            ALWAYS_INLINE void CancelPark() {
+                m_park_word.store(State_Running, std::memory_order_relaxed);
+            }
+
+            void Park(s64 timeout_ns) {
+
+                if (timeout_ns == InfiniteParkTime) {
+                    ::WaitForSingleObject(m_wake_event, INFINITE);
+                } else {
+                    /* Relative due time in 100ns units, rounded up so we don't wake before the target */
+                    LARGE_INTEGER due_time = {};
+                    due_time.QuadPart = -((timeout_ns + 99) / 100);
+                    if (due_time.QuadPart == 0) { due_time.QuadPart = -1; }
+
+                    ::SetWaitableTimer(m_park_timer, std::addressof(due_time), 0, nullptr, nullptr, false);
+
+                    HANDLE wait_handles[2] = { m_wake_event, m_park_timer };
+                    ::WaitForMultipleObjects(2, wait_handles, false, INFINITE);
+                }
+
+                m_park_word.store(State_Running, std::memory_order_relaxed);
+            }
+
+            /* Lockless hint, a core may park or wake right after */
+            ALWAYS_INLINE bool IsParked() const {
+                return m_park_word.load(std::memory_order_relaxed) == State_Parked;
+            }
+
+            ALWAYS_INLINE void Unpark() {
+                if (m_park_word.load() == State_Running) { return; }
+                if (m_park_word.exchange(State_Running) == State_Parked) {
+                    ::SetEvent(m_wake_event);
+                }
+            }
+    };
+}
@@ -0,0 +1,221 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::ukern::impl {
+
+    /* Per-core set of runnable fibers, one list per priority level for each bucket and a deadline heap ahead of them */
+    class RunQueue {
+        public:
+            using PriorityList = util::IntrusiveListTraits<FiberLocalStorage, &FiberLocalStorage::scheduler_list_node>::List;
+
+            /* Fibers only allowed on this core are kept apart so stealers never visit them */
+            enum Bucket : u32 {
+                Bucket_Pinned,
+                Bucket_Migratable,
+                Bucket_Count
+            };
+
+            /* Run list index of fibers in the deadline heap */
+            static constexpr u32 DeadlineRunListIndex = Bucket_Count * PriorityLevelCount;
+
+            /* Loads are fixed point fiber counts */
+            static constexpr u32 LoadScale = 0x100;
+        private:
+            BusyMutex         m_queue_mutex;
+            std::atomic<u32>  m_ready_mask_array[Bucket_Count];
+            std::atomic<u32>  m_deadline_count;
+            std::atomic<u32>  m_ready_count;
+            std::atomic<u32>  m_running_count;
+            std::atomic<u32>  m_load_average;
+            std::atomic<u32>  m_balance_cursor;
+            u64               m_load_update_tick;
+            PriorityList      m_priority_list_array[Bucket_Count][PriorityLevelCount];
+            FiberDeadlineHeap m_deadline_heap;
+            FiberTimerHeap    m_sleep_heap;
+        private:
+            /* Bit 0 is the highest priority so a count of trailing zeros finds the next level to run */
+            static constexpr ALWAYS_INLINE u32 GetPriorityLevel(s32 priority) { return (PriorityLevelCount - 1) - priority; }
+
+            ALWAYS_INLINE FiberLocalStorage *ClaimUnsafe(FiberLocalStorage *fiber_local, u32 core_number) {
+
+                /* Delist and claim for the requesting core */
+                this->RemoveUnsafe(fiber_local);
+                fiber_local->fiber_state  = FiberState_Running;
+                fiber_local->current_core = core_number;
+
+                return fiber_local;
+            }
+        public:
+            constexpr ALWAYS_INLINE RunQueue() : m_queue_mutex(), m_ready_mask_array{}, m_deadline_count(0), m_ready_count(0), m_running_count(0), m_load_average(0), m_balance_cursor(0), m_load_update_tick(0), m_priority_list_array(), m_deadline_heap(), m_sleep_heap() {/*...*/}
+
+            ALWAYS_INLINE void PushBackUnsafe(FiberLocalStorage *fiber_local, bool is_pinned) {
+
+                m_ready_count.store(m_ready_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+                /* Deadline jobs with budget left are ordered by deadline instead of priority */
+                if (fiber_local->IsDeadlineRunnable() == true) {
+                    m_deadline_heap.Insert(*fiber_local);
+                    fiber_local->run_list_index = DeadlineRunListIndex;
+                    m_deadline_count.store(m_deadline_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    return;
+                }
+
+                const u32 bucket = (is_pinned == true) ? Bucket_Pinned : Bucket_Migratable;
+                const u32 level  = GetPriorityLevel(fiber_local->priority);
+
+                m_priority_list_array[bucket][level].PushBack(*fiber_local);
+                fiber_local->run_list_index = (bucket * PriorityLevelCount) + level;
+
+                m_ready_mask_array[bucket].store(m_ready_mask_array[bucket].load(std::memory_order_relaxed) | (1u << level), std::memory_order_relaxed);
+            }
+
+            ALWAYS_INLINE void RemoveUnsafe(FiberLocalStorage *fiber_local) {
+
+                m_ready_count.store(m_ready_count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+
+                if (fiber_local->run_list_index == DeadlineRunListIndex) {
+                    m_deadline_heap.Remove(*fiber_local);
+                    m_deadline_count.store(m_deadline_count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+                    return;
+                }
+
+                const u32 bucket = fiber_local->run_list_index / PriorityLevelCount;
+                const u32 level  = fiber_local->run_list_index % PriorityLevelCount;
+
+                fiber_local->scheduler_list_node.Unlink();
+
+                /* Clear the ready bit once the level is drained */
+                if (m_priority_list_array[bucket][level].IsEmpty() == true) {
+                    m_ready_mask_array[bucket].store(m_ready_mask_array[bucket].load(std::memory_order_relaxed) & ~(1u << level), std::memory_order_relaxed);
+                }
+            }
+
+            FiberLocalStorage *PopUnsafe(u32 core_number) {
+
+                /* The earliest deadline goes ahead of every priority level */
+                if (m_deadline_heap.IsEmpty() == false) {
+                    return this->ClaimUnsafe(std::addressof(m_deadline_heap.Top()), core_number);
+                }
+
+                /* Find the highest ready level across both buckets */
+                const u32 pinned_mask = m_ready_mask_array[Bucket_Pinned].load(std::memory_order_relaxed);
+                const u32 ready_mask  = pinned_mask | m_ready_mask_array[Bucket_Migratable].load(std::memory_order_relaxed);
+                if (ready_mask == 0) { return nullptr; }
+
+                const u32 level = util::CountRightZeroBits32(ready_mask);
+
+                /* Pinned fibers go first on a tie as only this core can run them */
+                const u32 bucket = ((pinned_mask & (1u << level)) != 0) ? Bucket_Pinned : Bucket_Migratable;
+
+                return this->ClaimUnsafe(std::addressof(m_priority_list_array[bucket][level].Front()), core_number);
+            }
+
+            FiberLocalStorage *StealUnsafe(u32 core_number) {
+
+                /* Take the earliest deadline if it may run on the stealing core */
+                if (m_deadline_heap.IsEmpty() == false && m_deadline_heap.Top().IsSchedulable(core_number) == true) {
+                    return this->ClaimUnsafe(std::addressof(m_deadline_heap.Top()), core_number);
+                }
+
+                /* Visit migratable levels from highest to lowest */
+                u32 ready_mask = m_ready_mask_array[Bucket_Migratable].load(std::memory_order_relaxed);
+                while (ready_mask != 0) {
+
+                    const u32 level = util::CountRightZeroBits32(ready_mask);
+
+                    /* Take the first fiber allowed to run on the stealing core, usually the front */
+                    for (FiberLocalStorage &runnable_fiber : m_priority_list_array[Bucket_Migratable][level]) {
+                        if (runnable_fiber.IsSchedulable(core_number) == false) { continue; }
+
+                        return this->ClaimUnsafe(std::addressof(runnable_fiber), core_number);
+                    }
+
+                    ready_mask &= ready_mask - 1;
+                }
+
+                return nullptr;
+            }
+
+            /* Sleepers are only ever touched by the owning core, so they need no lock */
+            ALWAYS_INLINE void PushSleeper(FiberLocalStorage *fiber_local) {
+                m_sleep_heap.Insert(*fiber_local);
+            }
+
+            template<typename WakeFunction>
+            void WakeExpiredSleepers(u64 tick, WakeFunction wake_function) {
+
+                /* Pop sleepers in timeout order until one has yet to expire */
+                while (m_sleep_heap.IsEmpty() == false && m_sleep_heap.Top().timeout <= tick) {
+                    wake_function(std::addressof(m_sleep_heap.Pop()));
+                }
+            }
+
+            ALWAYS_INLINE u64 GetNextSleepTick() const { return (m_sleep_heap.IsEmpty() == true) ? 0xffff'ffff'ffff'ffff : m_sleep_heap.Top().timeout; }
+
+            /* Lockless hints, only reliable under the queue mutex */
+            ALWAYS_INLINE bool IsEmpty() const { return (m_ready_mask_array[Bucket_Pinned].load(std::memory_order_relaxed) | m_ready_mask_array[Bucket_Migratable].load(std::memory_order_relaxed) | m_deadline_count.load(std::memory_order_relaxed)) == 0; }
+            ALWAYS_INLINE bool HasMigratableFibers() const { return (m_ready_mask_array[Bucket_Migratable].load(std::memory_order_relaxed) | m_deadline_count.load(std::memory_order_relaxed)) != 0; }
+            ALWAYS_INLINE bool HasReadyFibersAtOrAbove(s32 priority) const {
+                if (m_deadline_count.load(std::memory_order_relaxed) != 0) { return true; }
+
+                const u32 level_mask = (2u << GetPriorityLevel(priority)) - 1;
+                return ((m_ready_mask_array[Bucket_Pinned].load(std::memory_order_relaxed) | m_ready_mask_array[Bucket_Migratable].load(std::memory_order_relaxed)) & level_mask) != 0;
+            }
+
+            /* Load averaging is only done by the owning core */
+            ALWAYS_INLINE void SetRunning(bool is_running) {
+                m_running_count.store(is_running, std::memory_order_relaxed);
+            }
+
+            void UpdateLoadAverage(u64 tick, u64 update_period_tick, u64 window_tick) {
+
+                /* Rate limit so the scheduler loop rarely pays for the divide */
+                const u64 elapsed_tick = tick - m_load_update_tick;
+                if (elapsed_tick < update_period_tick) { return; }
+                m_load_update_tick = tick;
+
+                /* Move toward the instant load in proportion to the time elapsed over the window */
+                const s32 instant_load = this->GetInstantLoad();
+                const s32 last_load    = m_load_average.load(std::memory_order_relaxed);
+                const s32 next_load    = (window_tick <= elapsed_tick) ? instant_load : last_load + static_cast<s32>(((instant_load - last_load) * static_cast<s64>(elapsed_tick)) / static_cast<s64>(window_tick));
+                m_load_average.store(next_load, std::memory_order_relaxed);
+            }
+
+            /* A parked core stops averaging, so it's load is dropped until it runs again */
+            ALWAYS_INLINE void ResetLoadAverage(u64 tick) {
+                m_load_average.store(0, std::memory_order_relaxed);
+                m_load_update_tick = tick;
+            }
+
+            ALWAYS_INLINE bool IsRunning() const { return m_running_count.load(std::memory_order_relaxed) != 0; }
+
+            ALWAYS_INLINE u32 GetInstantLoad() const { return (m_ready_count.load(std::memory_order_relaxed) + m_running_count.load(std::memory_order_relaxed)) * LoadScale; }
+
+            /* Bursts count immediately while the average keeps a briefly idle busy core from looking free */
+            ALWAYS_INLINE u32 GetLoad() const { return util::math::Max(this->GetInstantLoad(), m_load_average.load(std::memory_order_relaxed)); }
+
+            /* Racy rotation is fine, it only spreads out which neighbour is sampled */
+            ALWAYS_INLINE u32 GetNextBalanceCursor(u32 cursor_count) {
+                u32 cursor = m_balance_cursor.load(std::memory_order_relaxed) + 1;
+                if (cursor_count <= cursor) { cursor = 0; }
+                m_balance_cursor.store(cursor, std::memory_order_relaxed);
+                return cursor;
+            }
+
+            constexpr ALWAYS_INLINE BusyMutex *GetMutex() { return std::addressof(m_queue_mutex); }
+    };
+}
@@ -19,6 +19,20 @@ namespace dd::ukern::impl {
 
     TickSpan GetAbsoluteTimeToWakeup(TimeSpan timeout_ns);
 
+    /* Fibers readied together publish once and wake each selected core at most once */
+    struct CoreWakeBatch {
+        UKernCoreMask wake_core_mask;
+        u32           ready_count;
+    };
+
+    /* Suspended coroutines queued to resume on a runner fiber */
+    struct CoroutineResumeNode {
+        util::IntrusiveListNode ready_list_node;
+        std::coroutine_handle<> handle;
+    };
+
+    class CoroutineWaiter;
+
     class UserScheduler {
         public:
             friend class ScopedSchedulerLock;
@@ -26,60 +40,75 @@ namespace dd::ukern::impl {
             friend class LockArbiter;
             friend class KeyArbiter;
             friend class WaitAddressArbiter;
+            friend class CoroutineWaiter;
         private:
-            using HighPriorityList        = util::IntrusiveListTraits<FiberLocalStorage, &FiberLocalStorage::scheduler_list_node>::List;
-            using AboveNormalPriorityList = util::IntrusiveListTraits<FiberLocalStorage, &FiberLocalStorage::scheduler_list_node>::List;
-            using NormalPriorityList      = util::IntrusiveListTraits<FiberLocalStorage, &FiberLocalStorage::scheduler_list_node>::List;
-            using BelowNormalPriorityList = util::IntrusiveListTraits<FiberLocalStorage, &FiberLocalStorage::scheduler_list_node>::List;
-            using LowPriorityList         = util::IntrusiveListTraits<FiberLocalStorage, &FiberLocalStorage::scheduler_list_node>::List;
             using SuspendList             = util::IntrusiveListTraits<FiberLocalStorage, &FiberLocalStorage::scheduler_list_node>::List;
-            using WaitList                = util::IntrusiveListTraits<FiberLocalStorage, &FiberLocalStorage::scheduler_list_node>::List;
+            using CoroutineReadyList      = util::IntrusiveListTraits<CoroutineResumeNode, &CoroutineResumeNode::ready_list_node>::List;
+        private:
+            /* Idle cores spin this long before parking */
+            static constexpr s64 RestSpinTimeUs          = 20;
+            static constexpr u32 RestSpinMaxBackoffCount = 64;
+
+            /* Core loads are averaged over this window, updated at most once per period */
+            static constexpr s64 LoadAverageWindowUs = 4000;
+            static constexpr s64 LoadUpdatePeriodUs  = 250;
+
+            /* Imbalance in fibers before a fiber leaves it's last core, crossing a cache domain loses the warm cache so costs more */
+            static constexpr u32 LocalMigrationImbalance  = 1 * RunQueue::LoadScale;
+            static constexpr u32 RemoteMigrationImbalance = 2 * RunQueue::LoadScale;
+
+            /* A core only considers shedding a fiber once one would have to wait */
+            static constexpr u32 MinBalanceLoad           = 2 * RunQueue::LoadScale;
         protected:
-            SRWLOCK                   m_scheduler_lock;
-            HANDLE                    m_scheduler_thread_table[MaxCoreCount];
-            void                     *m_scheduler_fiber_table[MaxCoreCount];
-            HighPriorityList          m_high_priority_list;
-            AboveNormalPriorityList   m_above_normal_priority_list;
-            NormalPriorityList        m_normal_priority_list;
-            BelowNormalPriorityList   m_below_normal_priority_list;
-            LowPriorityList           m_low_priority_list;
-            SRWLOCK                   m_suspend_lock;
+            PlatformMutex             m_scheduler_lock;
+            CoreThreadHandle          m_scheduler_thread_table[MaxCoreCount];
+            FiberContext              m_scheduler_fiber_table[MaxCoreCount];
+            RunQueue                  m_run_queue_table[MaxCoreCount];
+            CoreParker                m_core_parker_table[MaxCoreCount];
+            u32                       m_core_processor_table[MaxCoreCount];
+            sys::ProcessorTopology::ProcessorInfo m_core_topology_table[MaxCoreCount];
+            u8                        m_steal_order_table[MaxCoreCount][MaxCoreCount];
+            u64                       m_load_window_tick;
+            u64                       m_load_update_period_tick;
+            PlatformMutex             m_suspend_lock;
             SuspendList               m_suspended_list;
-            WaitList                  m_wait_list;
-            u64                       m_next_wakeup_time;
+            WaitAddressTable          m_wait_address_table;
+            BusyMutex                 m_wait_timer_mutex;
+            FiberTimerHeap            m_wait_timer_heap;
+            std::atomic<u64>          m_next_wakeup_time;
+            WaitAddressBucket         m_coroutine_runner_bucket;
+            CoroutineReadyList        m_coroutine_ready_list;
+            u32                       m_coroutine_runner_key;
+            bool                      m_is_coroutine_runner_exiting;
             UKernCoreMask             m_core_mask;
             u32                       m_allocated_user_threads;
             u32                       m_core_count;
-            u32                       m_active_cores;
-            u32                       m_runnable_fibers;
+            std::atomic<u32>          m_active_cores;
+            std::atomic<u32>          m_runnable_fibers;
+            u32                       m_fiber_local_slot_mask;
             HandleTable               m_handle_table;
+            FiberStackPool            m_fiber_stack_pool;
+            SchedulerTracer           m_tracer;
         private:
-            static long unsigned int InternalSchedulerFiberMain(void *arg) {
-
-                /* Assume argument is the scheduler thread core number */
-                const size_t core_number = reinterpret_cast<size_t>(arg);
+            static void InternalSchedulerFiberMain(size_t core_number) {
 
                 UserScheduler *scheduler = impl::GetScheduler();
 
                 /* Convert thread to Fiber */
-                scheduler->m_scheduler_fiber_table[core_number] = ::ConvertThreadToFiber(nullptr);
-                DD_ASSERT(scheduler->m_scheduler_fiber_table[core_number] != 0);
-
-                /* Acquire scheduler lock for first run */
-                ::AcquireSRWLockExclusive(std::addressof(scheduler->m_scheduler_lock));
+                SchedulerTracer::SetCurrentCoreNumber(core_number);
+                scheduler->m_scheduler_fiber_table[core_number] = ConvertThreadToFiberContext(nullptr);
+                DD_ASSERT(scheduler->m_scheduler_fiber_table[core_number] != nullptr);
 
                 /* Call into the scheduler */
                 scheduler->SchedulerFiberMain(core_number);
-
-                return 0;
             }
 
             static void InternalSchedulerMainThreadFiberMain(void *arg) {
 
                 UserScheduler *scheduler = impl::GetScheduler();
 
-                /* Add main fiber to scheduler */
-                scheduler->AddToSchedulerUnsafe(reinterpret_cast<FiberLocalStorage*>(arg));
+                /* Handle the main fiber's first switch out */
+                scheduler->FinishSwitchOut(reinterpret_cast<FiberLocalStorage*>(arg));
 
                 /* Call into the scheduler */
                 scheduler->SchedulerFiberMain(0);
@@ -91,9 +120,6 @@ namespace dd::ukern::impl {
                 FiberLocalStorage *fiber_local = reinterpret_cast<FiberLocalStorage*>(arg);
                 UserScheduler *scheduler = impl::GetScheduler();
 
-                /* Release scheduler lock for first run */
-                ::ReleaseSRWLockExclusive(std::addressof(scheduler->m_scheduler_lock));
-
                 /* Dispatch user fiber */
                 (fiber_local->user_function)(fiber_local->user_arg);
 
@@ -103,54 +129,159 @@ namespace dd::ukern::impl {
 
             void ExitFiberImpl();
         private:
-            void AddToSchedulerUnsafe(FiberLocalStorage *fiber_local) {
+            /* Cores sharing an L3 keep each other's working sets warm */
+            ALWAYS_INLINE bool IsSameCacheDomain(u32 core_number0, u32 core_number1) const {
+                return sys::ProcessorTopology::GetDistance(m_core_topology_table[core_number0], m_core_topology_table[core_number1]) <= sys::ProcessorDistance_SharedL3;
+            }
+
+            ALWAYS_INLINE u32 GetMigrationImbalance(u32 core_number0, u32 core_number1) const {
+                return (this->IsSameCacheDomain(core_number0, core_number1) == true) ? LocalMigrationImbalance : RemoteMigrationImbalance;
+            }
+
+            ALWAYS_INLINE u32 SelectCoreForFiber(FiberLocalStorage *fiber_local) {
+
+                /* Prefer the core the fiber last ran on to keep it's cache warm, otherwise use the first allowed core cached when the core mask was set */
+                const u32 home_core = (fiber_local->core_mask.IsSet(fiber_local->current_core) == true) ? fiber_local->current_core : fiber_local->first_allowed_core;
+                if (fiber_local->is_core_pinned == true) { return home_core; }
+
+                /* Stay unless the home core is loaded enough that we'd wait */
+                const u32 home_load = m_run_queue_table[home_core].GetLoad();
+                if (home_load < MinBalanceLoad) { return home_core; }
+
+                /* Sample one neighbour per placement, rotating through the steal order so placement stays O(1) */
+                const u32 candidate_core = m_steal_order_table[home_core][m_run_queue_table[home_core].GetNextBalanceCursor(m_core_count - 1)];
+                if (fiber_local->core_mask.IsSet(candidate_core) == false) { return home_core; }
+
+                /* Move only when the imbalance pays for the lost cache warmth */
+                const u32 candidate_load = m_run_queue_table[candidate_core].GetLoad();
+                return (candidate_load + this->GetMigrationImbalance(home_core, candidate_core) <= home_load) ? candidate_core : home_core;
+            }
+
+            void MarkCoreToWake(FiberLocalStorage *fiber_local, u32 core_number, CoreWakeBatch *wake_batch) {
+
+                /* The target core always gets a wake, Unpark is a single load if it's running */
+                wake_batch->wake_core_mask.Set(core_number);
+
+                /* A busy target leaves the fiber waiting, so also wake the nearest parked core that may steal it */
+                if (fiber_local->is_core_pinned == true || m_run_queue_table[core_number].IsRunning() == false) { return; }
+                if (m_active_cores.load(std::memory_order_relaxed) == m_core_count)                                { return; }
+
+                const u8 *steal_order = m_steal_order_table[core_number];
+                for (u32 i = 0; i < m_core_count - 1; ++i) {
+                    const u32 idle_core = steal_order[i];
+                    if (fiber_local->core_mask.IsSet(idle_core) == false || wake_batch->wake_core_mask.IsSet(idle_core) == true || m_core_parker_table[idle_core].IsParked() == false) { continue; }
+
+                    wake_batch->wake_core_mask.Set(idle_core);
+                    return;
+                }
+            }
+
+            ALWAYS_INLINE void AddToSchedulerUnsafe(FiberLocalStorage *fiber_local) {
+                CoreWakeBatch wake_batch = {};
+                this->AddToSchedulerUnsafe(fiber_local, std::addressof(wake_batch));
+                this->WakeCores(wake_batch);
+            }
+
+            void AddToSchedulerUnsafe(FiberLocalStorage *fiber_local, CoreWakeBatch *wake_batch) {
 
                 /* Handle suspension */
                 if (fiber_local->activity_level == ActivityLevel_Suspended) {
+                    m_suspend_lock.Enter();
                     fiber_local->fiber_state = FiberState_Suspended;
                     m_suspended_list.PushBack(*fiber_local);
+                    m_suspend_lock.Leave();
                     return;
                 }
 
-                /* Insert into runnable list based on priority */
-                if (fiber_local->priority == (THREAD_PRIORITY_NORMAL + WindowsToUKernPriorityOffset)) {
-                    m_normal_priority_list.PushBack(*fiber_local);
-                } else if (fiber_local->priority == (THREAD_PRIORITY_ABOVE_NORMAL + WindowsToUKernPriorityOffset)) {
-                    m_above_normal_priority_list.PushBack(*fiber_local);
-                } else if (fiber_local->priority == (THREAD_PRIORITY_BELOW_NORMAL + WindowsToUKernPriorityOffset)) {
-                    m_below_normal_priority_list.PushBack(*fiber_local);
-                } else if (fiber_local->priority == (THREAD_PRIORITY_HIGHEST + WindowsToUKernPriorityOffset)) {
-                    m_high_priority_list.PushBack(*fiber_local);
-                } else if (fiber_local->priority == (THREAD_PRIORITY_LOWEST + WindowsToUKernPriorityOffset)) {
-                    m_low_priority_list.PushBack(*fiber_local);
+                /* Release a new job for deadline fibers becoming runnable */
+                if (fiber_local->relative_deadline_tick != 0 && fiber_local->is_deadline_job_active == false) {
+                    fiber_local->absolute_deadline      = util::GetSystemTick() + fiber_local->relative_deadline_tick;
+                    fiber_local->deadline_budget_left   = fiber_local->deadline_budget_tick;
+                    fiber_local->is_deadline_job_active = true;
                 }
 
-                fiber_local->fiber_state = FiberState_Scheduled;
+                /* Insert into the run queue of the selected core */
+                const u32 core_number  = this->SelectCoreForFiber(fiber_local);
+                RunQueue *run_queue    = m_run_queue_table + core_number;
+                {
+                    ScopedBusyMutex lock(run_queue->GetMutex());
+                    fiber_local->current_core = core_number;
+                    fiber_local->fiber_state  = FiberState_Scheduled;
+                    run_queue->PushBackUnsafe(fiber_local, fiber_local->is_core_pinned);
+                }
+
+                /* Defer the wake to the end of the batch */
+                ++wake_batch->ready_count;
+                this->MarkCoreToWake(fiber_local, core_number, wake_batch);
+            }
+
+            void InitializeStealOrder();
+
+            FiberLocalStorage *StealFiber(u32 core_number);
 
-                ++m_runnable_fibers;
+            bool TryDequeueScheduledFiber(FiberLocalStorage *fiber_local);
 
-                /* Wake a sleeping core */
-                ::WakeByAddressSingle(std::addressof(m_runnable_fibers));
+            ALWAYS_INLINE void UpdateNextWakeupTimeUnsafe() {
+                m_next_wakeup_time.store((m_wait_timer_heap.IsEmpty() == true) ? 0xffff'ffff'ffff'ffff : m_wait_timer_heap.Top().timeout, std::memory_order_relaxed);
             }
 
+            /* Timed waiters are kept in a heap so expiry only visits fibers that have timed out, the heap lock is taken after a wait bucket's */
+            ALWAYS_INLINE void RegisterWaitTimer(FiberLocalStorage *fiber_local) {
+                if (static_cast<u64>(TimeSpan::MaxTime) <= fiber_local->timeout) { return; }
+
+                ScopedBusyMutex lock(std::addressof(m_wait_timer_mutex));
+                m_wait_timer_heap.Insert(*fiber_local);
+                this->UpdateNextWakeupTimeUnsafe();
+            }
+
+            ALWAYS_INLINE void UnregisterWaitTimer(FiberLocalStorage *fiber_local) {
+                if (static_cast<u64>(TimeSpan::MaxTime) <= fiber_local->timeout) { return; }
+
+                ScopedBusyMutex lock(std::addressof(m_wait_timer_mutex));
+                if (fiber_local->timer_node.IsLinked() == false) { return; }
+
+                m_wait_timer_heap.Remove(*fiber_local);
+                this->UpdateNextWakeupTimeUnsafe();
+            }
+
+            u32 WakeAddressWaitersUnsafe(WaitAddressBucket *wait_bucket, u32 *wait_address, u32 count);
+
+            void ScheduleCoroutineUnsafe(CoroutineResumeNode *resume_node, CoreWakeBatch *wake_batch);
+
+            void CancelExpiredWaits(u64 tick);
+
+            void RestCore(u32 core_number, u32 last_runnable_fibers);
+
+            void FinishSwitchOut(FiberLocalStorage *fiber_local);
+
+            void ChargeDeadlineJob(FiberLocalStorage *fiber_local);
+
             void Dispatch(FiberLocalStorage *fiber_local, u32 core_number);
         public:
-            constexpr ALWAYS_INLINE UserScheduler()  : m_scheduler_lock(0) , m_scheduler_thread_table{nullptr}, m_scheduler_fiber_table{nullptr} {/*...*/}
+            constexpr ALWAYS_INLINE UserScheduler()  : m_scheduler_lock() , m_scheduler_thread_table{}, m_scheduler_fiber_table{nullptr}, m_run_queue_table(), m_core_parker_table(), m_core_processor_table{}, m_core_topology_table{}, m_steal_order_table{}, m_load_window_tick(0), m_load_update_period_tick(0), m_suspend_lock(), m_wait_address_table(), m_wait_timer_mutex(), m_wait_timer_heap(), m_next_wakeup_time(0xffff'ffff'ffff'ffff), m_coroutine_runner_bucket(), m_coroutine_ready_list(), m_coroutine_runner_key(0), m_is_coroutine_runner_exiting(false), m_fiber_local_slot_mask(0) {/*...*/}
 
-            void Initialize(UKernCoreMask core_mask);
+            void Initialize(const UKernCoreMask &processor_mask, const sys::ProcessorTopology &processor_topology);
         private:
-            void SwapLockForSignalKey(FiberLocalStorage *waiting_fiber);
+            void ReacquireKeyLock(FiberLocalStorage *waiting_fiber, CoreWakeBatch *wake_batch);
         public:
             Result CreateThreadImpl(UKernHandle *out_handle, ThreadFunction thread_func, uintptr_t arg, size_t stack_size, s32 priority, u32 core_id);
 
             Result StartThread(UKernHandle handle);
             void   ExitThreadImpl(UKernHandle handle);
+            Result JoinThreadImpl(UKernHandle handle, s64 absolute_timeout);
+            Result JoinThreadsImpl(const UKernHandle *handle_array, u32 handle_count, s64 absolute_timeout);
 
             Result SetPriorityImpl(UKernHandle handle, s32 priority);
-            Result SetCoreMaskImpl(UKernHandle handle, u64 new_mask);
+            Result SetCoreMaskImpl(UKernHandle handle, const UKernCoreMask &core_mask);
             Result SetActivityImpl(UKernHandle handle, u16 activity_level);
+            Result SetDeadlineImpl(UKernHandle handle, s64 relative_deadline_tick, s64 budget_tick);
+            Result GetDeadlineStatisticsImpl(ThreadDeadlineStatistics *out_statistics, UKernHandle handle);
+
+            Result AllocateFiberLocalSlotImpl(u32 *out_slot);
+            Result FreeFiberLocalSlotImpl(u32 slot);
 
             void   SleepThreadImpl(u64 absolute_timeout);
+            void   YieldThreadImpl();
 
             Result ArbitrateLockImpl(UKernHandle handle, u32 *address, u32 tag);
             Result ArbitrateUnlockImpl(u32 *address);
@@ -164,8 +295,14 @@ namespace dd::ukern::impl {
             Result WakeByAddressIncrementEqualImpl(u32 *address, u32 value, u32 count);
             Result WakeByAddressModifyLessThanImpl(u32 *address, u32 value, u32 count);
 
+            Result WaitForAddressIfEqualAsyncImpl(CoroutineWaiter *coroutine_waiter, u32 *address, u32 value, s64 absolute_timeout);
+            void   ScheduleCoroutineImpl(CoroutineResumeNode *resume_node);
+            CoroutineResumeNode *WaitForReadyCoroutineImpl();
+            void   ExitCoroutineRunnersImpl();
+            void   ResetCoroutineRunnersImpl();
+
             ALWAYS_INLINE FiberLocalStorage *GetCurrentThreadImpl() {
-                return reinterpret_cast<FiberLocalStorage*>(::GetFiberData());
+                return reinterpret_cast<FiberLocalStorage*>(GetFiberContextArgument());
             }
 
             static void SetInitialFiberNameUnsafe(FiberLocalStorage *fiber_local) {
@@ -176,12 +313,57 @@ namespace dd::ukern::impl {
                 ::snprintf(fiber_local->fiber_name_storage, MaxFiberNameLength, "Thread0x%08x", reinterpret_cast<size_t>(fiber_local->user_function));
             }
 
-            constexpr ALWAYS_INLINE void *GetSchedulerFiber(FiberLocalStorage *fiber_local) {
+            constexpr ALWAYS_INLINE FiberContext GetSchedulerFiber(FiberLocalStorage *fiber_local) {
                 DD_ASSERT(m_core_count > fiber_local->current_core);
                 return m_scheduler_fiber_table[fiber_local->current_core];
             }
 
             FiberLocalStorage *GetFiberByHandle(UKernHandle handle);
+
+            void UpdateInheritedPriorityUnsafe(FiberLocalStorage *fiber_local);
+
+            void WakeCores(const CoreWakeBatch &wake_batch) {
+
+                if (wake_batch.ready_count == 0) { return; }
+
+                /* Signal the new runnable fibers */
+                m_runnable_fibers.fetch_add(wake_batch.ready_count);
+
+                /* Wake resting cores selected for the batch */
+                if (m_active_cores.load() < m_core_count) {
+                    for (u32 core_number = wake_batch.wake_core_mask.FindFirstSet(); core_number != UKernCoreMask::NotFound; core_number = wake_batch.wake_core_mask.FindNextSet(core_number)) {
+                        m_core_parker_table[core_number].Unpark();
+                    }
+                }
+            }
+
+            /* Fiber locals are never unmapped, so a stale lookup only reads an outdated state */
+            ALWAYS_INLINE bool IsFiberRunningImpl(UKernHandle handle) {
+                FiberLocalStorage *fiber_local = this->GetFiberByHandle(handle);
+                return (fiber_local != nullptr) && (std::atomic_ref<u32>(fiber_local->fiber_state).load(std::memory_order_relaxed) == FiberState_Running);
+            }
+
+            constexpr ALWAYS_INLINE u32 GetCoreCountImpl() const {
+                return m_core_count;
+            }
+
+            ALWAYS_INLINE Result EnableTraceImpl() {
+                return m_tracer.Enable(m_core_count);
+            }
+
+            ALWAYS_INLINE void DisableTraceImpl() {
+                m_tracer.Disable();
+            }
+
+            ALWAYS_INLINE Result ExportTraceImpl(const char *path) {
+                return m_tracer.ExportChromeTraceJson(path);
+            }
+
+            void GetFiberStackPoolStatisticsImpl(FiberStackPoolStatistics *out_statistics) {
+                out_statistics->hit_count  = m_fiber_stack_pool.GetHitCount();
+                out_statistics->miss_count = m_fiber_stack_pool.GetMissCount();
+                out_statistics->bytes_held = m_fiber_stack_pool.GetBytesHeld();
+            }
         public:
             void SuspendAllOtherCoresImpl() {
 
@@ -192,12 +374,12 @@ namespace dd::ukern::impl {
                 /* Suspend all cores except current */
                 for (u32 i = 0; i < m_core_count; ++i) {
                     if (current_core != i) {
-                        ::SuspendThread(m_scheduler_thread_table[i]);
+                        SuspendCoreThread(m_scheduler_thread_table[i]);
                     }
                 }
             }
 
-            void OutputBackTraceImpl(HANDLE file) {
+            void OutputBackTraceImpl([[maybe_unused]] Handle file) {
 
                 /* Print backtrace for this fiber */
                 FiberLocalStorage *current_fiber = this->GetCurrentThreadImpl();
@@ -211,13 +393,20 @@ namespace dd::ukern::impl {
     class ScopedSchedulerLock {
         private:
             UserScheduler *m_scheduler;
+            bool           m_is_locked;
         public:
-            explicit ALWAYS_INLINE ScopedSchedulerLock(UserScheduler *scheduler) : m_scheduler(scheduler) {
-                ::AcquireSRWLockExclusive(std::addressof(m_scheduler->m_scheduler_lock));
+            explicit ALWAYS_INLINE ScopedSchedulerLock(UserScheduler *scheduler) : m_scheduler(scheduler), m_is_locked(true) {
+                m_scheduler->m_scheduler_lock.Enter();
             }
 
             ALWAYS_INLINE ~ScopedSchedulerLock() {
-                ::ReleaseSRWLockExclusive(std::addressof(m_scheduler->m_scheduler_lock));
+                if (m_is_locked == false) { return; }
+                m_scheduler->m_scheduler_lock.Leave();
+            }
+
+            /* The scheduler fiber releases the lock once the waiting fiber has been switched out */
+            ALWAYS_INLINE void HandOffToScheduler() {
+                m_is_locked = false;
             }
     };
 }
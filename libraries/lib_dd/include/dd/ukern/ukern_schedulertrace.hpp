@@ -0,0 +1,99 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::ukern::impl {
+
+    enum SchedulerTraceEventType : u16 {
+        SchedulerTraceEventType_Dispatch,
+        SchedulerTraceEventType_Preempt,
+        SchedulerTraceEventType_Wait,
+        SchedulerTraceEventType_Wake,
+        SchedulerTraceEventType_Timeout,
+        SchedulerTraceEventType_Exit,
+    };
+
+    struct SchedulerTraceEvent {
+        s64         tick;
+        UKernHandle fiber_handle;
+        u16         event_type;
+        u16         core_number;
+        char        fiber_name[MaxFiberNameLength];
+    };
+
+    /* Single producer ring, only the owning core's thread records into it */
+    class SchedulerTraceRing {
+        public:
+            static constexpr size_t EventCountShift = 14;
+            static constexpr size_t EventCount      = (1 << EventCountShift);
+        private:
+            SchedulerTraceEvent *m_event_array;
+            std::atomic<u64>     m_write_count;
+        public:
+            constexpr ALWAYS_INLINE SchedulerTraceRing() : m_event_array(nullptr), m_write_count(0) {/*...*/}
+
+            bool Initialize() {
+                if (m_event_array == nullptr) {
+                    m_event_array = reinterpret_cast<SchedulerTraceEvent*>(::malloc(sizeof(SchedulerTraceEvent) * EventCount));
+                }
+                m_write_count.store(0, std::memory_order_relaxed);
+                return m_event_array != nullptr;
+            }
+
+            ALWAYS_INLINE void Record(SchedulerTraceEventType event_type, u32 core_number, FiberLocalStorage *fiber_local) {
+
+                const u64 write_count      = m_write_count.load(std::memory_order_relaxed);
+                SchedulerTraceEvent *event = m_event_array + (write_count & (EventCount - 1));
+                event->tick         = util::GetSystemTick();
+                event->fiber_handle = fiber_local->ukern_fiber_handle;
+                event->event_type   = event_type;
+                event->core_number  = core_number;
+                ::memcpy(event->fiber_name, fiber_local->fiber_name_storage, MaxFiberNameLength);
+
+                /* Publish the event to the exporter */
+                m_write_count.store(write_count + 1, std::memory_order_release);
+            }
+
+            ALWAYS_INLINE u64 GetWriteCount() const { return m_write_count.load(std::memory_order_acquire); }
+
+            ALWAYS_INLINE const SchedulerTraceEvent *GetEvent(u64 index) const { return m_event_array + (index & (EventCount - 1)); }
+    };
+
+    /* Opt-in scheduler event tracing, a disabled tracer costs one relaxed load per event site */
+    class SchedulerTracer {
+        private:
+            SchedulerTraceRing m_ring_array[MaxCoreCount];
+            std::atomic<bool>  m_is_enabled;
+            u32                m_core_count;
+        private:
+            void RecordImpl(SchedulerTraceEventType event_type, FiberLocalStorage *fiber_local);
+        public:
+            constexpr ALWAYS_INLINE SchedulerTracer() : m_ring_array(), m_is_enabled(false), m_core_count(0) {/*...*/}
+
+            /* Tracks the core of the calling core thread, fibers record into the ring of the core they run on */
+            static void SetCurrentCoreNumber(u32 core_number);
+
+            Result Enable(u32 core_count);
+            void   Disable();
+
+            Result ExportChromeTraceJson(const char *path);
+
+            ALWAYS_INLINE void Record(SchedulerTraceEventType event_type, FiberLocalStorage *fiber_local) {
+                if (m_is_enabled.load(std::memory_order_relaxed) == false) { return; }
+                this->RecordImpl(event_type, fiber_local);
+            }
+    };
+}
@@ -23,8 +23,22 @@ namespace dd::ukern {
         UserScheduler *GetScheduler();
     }
 
+    struct ThreadDeadlineStatistics {
+        u32 job_count;
+        u32 miss_count;
+        u32 overrun_count;
+    };
+
+    struct FiberStackPoolStatistics {
+        u64 hit_count;
+        u64 miss_count;
+        u64 bytes_held;
+    };
+
     Result CreateThread(UKernHandle *out_handle, ThreadFunction thread_func, uintptr_t arg, size_t stack_size, u32 priority, u32 core_id);
     void   ExitThread(UKernHandle handle);
+    Result JoinThread(UKernHandle handle, TimeSpan timeout_ns);
+    Result JoinThreads(const UKernHandle *handle_array, u32 handle_count, TimeSpan timeout_ns);
 
     Result StartThread(UKernHandle handle);
     Result ResumeThread (UKernHandle handle);
@@ -35,6 +49,9 @@ namespace dd::ukern {
     Result SetThreadPriority(UKernHandle handle, u32 priority);
     Result SetThreadCoreMask(UKernHandle handle, UKernCoreMask core_mask);
 
+    Result SetThreadDeadline(UKernHandle handle, TimeSpan relative_deadline, TimeSpan budget);
+    Result GetThreadDeadlineStatistics(ThreadDeadlineStatistics *out_statistics, UKernHandle handle);
+
     Result GetThreadPriority(u32 *out_priority, UKernHandle handle);
     Result GetThreadCoreMask(UKernCoreMask *out_core_mask, UKernHandle handle);
 
@@ -42,4 +59,23 @@ namespace dd::ukern {
     void YieldThread();
 
     ThreadType *GetCurrentThread();
+
+    /* Slots are cleared for every fiber when allocated, like Tls slots but indexed straight off the fiber */
+    Result AllocateFiberLocalSlot(u32 *out_slot);
+    Result FreeFiberLocalSlot(u32 slot);
+
+    ALWAYS_INLINE void *GetFiberLocal(ThreadType *thread, u32 slot) {
+        DD_ASSERT(slot < MaxFiberLocalSlotCount);
+        return thread->fiber_local_slot_array[slot];
+    }
+
+    ALWAYS_INLINE void SetFiberLocal(ThreadType *thread, u32 slot, void *value) {
+        DD_ASSERT(slot < MaxFiberLocalSlotCount);
+        thread->fiber_local_slot_array[slot] = value;
+    }
+
+    ALWAYS_INLINE void *GetFiberLocal(u32 slot)              { return GetFiberLocal(GetCurrentThread(), slot); }
+    ALWAYS_INLINE void  SetFiberLocal(u32 slot, void *value) { SetFiberLocal(GetCurrentThread(), slot, value); }
+
+    void GetFiberStackPoolStatistics(FiberStackPoolStatistics *out_statistics);
 }
@@ -21,20 +21,26 @@ namespace dd::ukern::impl {
         public:
             constexpr WaitableObject() {/*...*/}
 
-            virtual void EndWait(FiberLocalStorage *wait_fiber, Result wait_result);
-            virtual void CancelWait(FiberLocalStorage *wait_fiber, Result wait_result);
+            /* Readied fibers are added to the caller's wake batch, the caller wakes cores once it's done */
+            virtual void EndWait(FiberLocalStorage *wait_fiber, Result wait_result, CoreWakeBatch *wake_batch);
+            virtual void CancelWait(FiberLocalStorage *wait_fiber, Result wait_result, CoreWakeBatch *wake_batch);
 
-            void EndFiberWaitImpl(FiberLocalStorage *wait_fiber, Result wait_result) {
+            void EndFiberWaitImpl(FiberLocalStorage *wait_fiber, Result wait_result, CoreWakeBatch *wake_batch) {
 
-                /* Remove from suspend/wait list */
+                /* Remove from wait bucket */
                 wait_fiber->scheduler_list_node.Unlink();
 
+                /* Remove from the timer heap if the wait ended before it's timeout */
+                GetScheduler()->UnregisterWaitTimer(wait_fiber);
+
+                GetScheduler()->m_tracer.Record((wait_result == ResultTimeout) ? SchedulerTraceEventType_Timeout : SchedulerTraceEventType_Wake, wait_fiber);
+
                 /* Set Fiber state */
                 wait_fiber->fiber_state = FiberState_Scheduled;
                 wait_fiber->last_result = wait_result;
 
                 /* Add to scheduler */
-                GetScheduler()->AddToSchedulerUnsafe(wait_fiber);
+                GetScheduler()->AddToSchedulerUnsafe(wait_fiber, wake_batch);
             }
     };
 
@@ -42,70 +48,36 @@ namespace dd::ukern::impl {
         public:
             constexpr LockArbiter() {/*...*/}
 
-            virtual void EndWait(FiberLocalStorage *wait_fiber, Result wait_result) override {
-                EndFiberWaitImpl(wait_fiber, wait_result);
+            virtual void EndWait(FiberLocalStorage *wait_fiber, Result wait_result, CoreWakeBatch *wake_batch) override {
+                EndFiberWaitImpl(wait_fiber, wait_result, wake_batch);
             }
 
-            virtual void CancelWait(FiberLocalStorage *wait_fiber, Result wait_result) override {
+            virtual void CancelWait(FiberLocalStorage *wait_fiber, Result wait_result, [[maybe_unused]] CoreWakeBatch *wake_batch) override {
                 DD_ASSERT(false);
                 /* Remove from child list */
-                wait_fiber->ReleaseLockWaitListUnsafe();
+                wait_fiber->ReleaseLockWaitListUnsafe(wait_fiber->lock_address);
             }
     };
 
     class KeyArbiter : public WaitableObject {
+        private:
+            Result m_key_result;
         public:
-            constexpr KeyArbiter() {/*...*/}
+            constexpr KeyArbiter() : m_key_result(ResultSuccess) {/*...*/}
 
-            virtual void EndWait(FiberLocalStorage *wait_fiber, Result wait_result) override {
-                EndFiberWaitImpl(wait_fiber, wait_result);
+            virtual void EndWait(FiberLocalStorage *wait_fiber, Result wait_result, CoreWakeBatch *wake_batch) override {
+                /* Report the result of the key wait once the lock is reacquired */
+                EndFiberWaitImpl(wait_fiber, (wait_result == ResultSuccess) ? m_key_result : wait_result, wake_batch);
             }
 
-            virtual void CancelWait(FiberLocalStorage *wait_fiber, Result wait_result) override {
-
-                /* Transfer wait list or remove from child list */
-                if (wait_fiber->wait_list.IsEmpty() == false) {
-
-                    FiberLocalStorage *next_cv_parent = std::addressof(wait_fiber->wait_list.PopFront());
-                    for (FiberLocalStorage &waiting_fiber : wait_fiber->wait_list) {
-                        /* Detach from previous list */
-                        waiting_fiber.wait_list_node.Unlink();
-
-                        /* Add to new parent */
-                        next_cv_parent->wait_list.PushBack(waiting_fiber);
-                    }
-                } else if (wait_fiber->wait_list_node.IsLinked() == true) {
-                    wait_fiber->wait_list_node.Unlink();
-                } else {
-                    EndFiberWaitImpl(wait_fiber, wait_result);
-                    return;
-                }
-
-                /* Try to take the lock back */
-                const u32 prev_tag = *wait_fiber->lock_address;
-                u32       tag      =  wait_fiber->wait_tag;
-                if (prev_tag != 0) {
-                    tag |= FiberLocalStorage::HasChildWaitersBit;
-                }
-                *wait_fiber->lock_address = tag;
-
-                /* If there were other waiters */
-                if (prev_tag != 0) {
-                    /* Get fiber by handle */
-                    FiberLocalStorage *lock_fiber = impl::GetScheduler()->GetFiberByHandle(prev_tag & ~FiberLocalStorage::HasChildWaitersBit);
-
-                    /* Push back fiber waiter */
-                    lock_fiber->wait_list.PushBack(*wait_fiber);
-
-                    /* Swap to suspend list */
-                    lock_fiber->scheduler_list_node.Unlink();
-                    impl::GetScheduler()->m_suspended_list.PushBack(*lock_fiber);
-
-                } else {
-                    EndFiberWaitImpl(wait_fiber, wait_result);
-                }
-
-                return;
+            virtual void CancelWait(FiberLocalStorage *wait_fiber, Result wait_result, CoreWakeBatch *wake_batch) override {
+
+                /* Leave the wait bucket */
+                wait_fiber->scheduler_list_node.Unlink();
+
+                /* Take the lock back before returning the cancel result */
+                m_key_result = wait_result;
+                GetScheduler()->ReacquireKeyLock(wait_fiber, wake_batch);
             }
     };
 
@@ -113,13 +85,12 @@ namespace dd::ukern::impl {
         public:
             constexpr WaitAddressArbiter() {/*...*/}
 
-            virtual void EndWait(FiberLocalStorage *wait_fiber, Result wait_result) override {
-                EndFiberWaitImpl(wait_fiber, wait_result);
+            virtual void EndWait(FiberLocalStorage *wait_fiber, Result wait_result, CoreWakeBatch *wake_batch) override {
+                EndFiberWaitImpl(wait_fiber, wait_result, wake_batch);
             }
 
-            virtual void CancelWait(FiberLocalStorage *wait_fiber, Result wait_result) override {
-                
-                EndFiberWaitImpl(wait_fiber, wait_result);
+            virtual void CancelWait(FiberLocalStorage *wait_fiber, Result wait_result, CoreWakeBatch *wake_batch) override {
+                EndFiberWaitImpl(wait_fiber, wait_result, wake_batch);
             }
     };
 }
@@ -0,0 +1,99 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::ukern::impl {
+
+    /* Fibers waiting on addresses that hash to the same bucket, in FIFO order */
+    class WaitAddressBucket {
+        public:
+            using WaitList = util::IntrusiveListTraits<FiberLocalStorage, &FiberLocalStorage::scheduler_list_node>::List;
+        private:
+            BusyMutex m_bucket_mutex;
+            WaitList  m_wait_list;
+        public:
+            constexpr ALWAYS_INLINE WaitAddressBucket() : m_bucket_mutex(), m_wait_list() {/*...*/}
+
+            ALWAYS_INLINE void PushBackUnsafe(FiberLocalStorage *fiber_local) {
+                m_wait_list.PushBack(*fiber_local);
+            }
+
+            /* Visit waiters on an address in wait order until the visitor returns false, the visitor may unlink the visited fiber */
+            template<typename Visitor>
+            void VisitWaitersUnsafe(u32 *wait_address, Visitor visitor) {
+                for (FiberLocalStorage &waiting_fiber : m_wait_list) {
+                    if (waiting_fiber.wait_address != wait_address) { continue; }
+                    if (visitor(std::addressof(waiting_fiber)) == false) { return; }
+                }
+            }
+
+            u32 CountWaitersUnsafe(u32 *wait_address) {
+                u32 count = 0;
+                for (FiberLocalStorage &waiting_fiber : m_wait_list) {
+                    if (waiting_fiber.wait_address == wait_address) { ++count; }
+                }
+                return count;
+            }
+
+            bool HasWaitersUnsafe(u32 *wait_address) {
+                for (FiberLocalStorage &waiting_fiber : m_wait_list) {
+                    if (waiting_fiber.wait_address == wait_address) { return true; }
+                }
+                return false;
+            }
+
+            constexpr ALWAYS_INLINE BusyMutex *GetMutex() { return std::addressof(m_bucket_mutex); }
+    };
+
+    /* Futex style table of wait buckets keyed on address, waits and wakes on different buckets never contend */
+    class WaitAddressTable {
+        public:
+            static constexpr size_t BucketCountShift = 8;
+            static constexpr size_t BucketCount      = (1 << BucketCountShift);
+        private:
+            WaitAddressBucket m_bucket_array[BucketCount];
+        public:
+            constexpr ALWAYS_INLINE WaitAddressTable() : m_bucket_array() {/*...*/}
+
+            ALWAYS_INLINE WaitAddressBucket *GetBucket(u32 *wait_address) {
+
+                /* Fibonacci hash the address without it's alignment bits */
+                const u64 hash = (reinterpret_cast<uintptr_t>(wait_address) >> 2) * 0x9e37'79b9'7f4a'7c15;
+
+                return m_bucket_array + (hash >> (64 - BucketCountShift));
+            }
+    };
+
+    class ScopedWaitBucketLock {
+        private:
+            WaitAddressBucket *m_bucket;
+            bool               m_is_locked;
+        public:
+            explicit ALWAYS_INLINE ScopedWaitBucketLock(WaitAddressBucket *bucket) : m_bucket(bucket), m_is_locked(true) {
+                m_bucket->GetMutex()->Enter();
+            }
+
+            ALWAYS_INLINE ~ScopedWaitBucketLock() {
+                if (m_is_locked == false) { return; }
+                m_bucket->GetMutex()->Leave();
+            }
+
+            /* The scheduler fiber releases the bucket once the waiting fiber has been switched out */
+            ALWAYS_INLINE void HandOffToScheduler() {
+                m_is_locked = false;
+            }
+    };
+}
@@ -19,6 +19,7 @@
 #include <dd/util/util_result_ukern.h>
 #include <dd/util/util_result_trace.h>
 #include <dd/util/util_result_res.h>
+#include <dd/util/util_result_job.h>
 
 #include <dd/util/util_new.h>
 #include <dd/util/util_singleton.h>
@@ -26,8 +27,10 @@
 #include <dd/util/util_alignment.hpp>
 #include <dd/util/util_sizeconstants.hpp>
 #include <dd/util/util_countbits.hpp>
+#include <dd/util/util_bitset.hpp>
 #include <dd/util/util_member.hpp>
 #include <dd/util/util_intrusivelist.hpp>
+#include <dd/util/util_intrusivepairingheap.hpp>
 #include <dd/util/util_intrusivetreenode.hpp>
 #include <dd/util/util_typestorage.hpp>
 #include <dd/util/util_delegate.hpp>
@@ -35,6 +38,7 @@
 #include <dd/util/util_delegate2.hpp>
 #include <dd/util/util_runtimetypeinfo.hpp>
 #include <dd/util/util_fixedobjectallocator.hpp>
+#include <dd/util/util_chunkedobjectallocator.hpp>
 #include <dd/util/util_heapobjectallocator.hpp>
 #include <dd/util/util_pointerarray.hpp>
 #include <dd/util/util_heaparray.hpp>
@@ -60,9 +64,12 @@
 #include <dd/util/math/util_matrix44.hpp>
 #include <dd/util/math/util_clamp.hpp>
 
+/* The linux backend has no graphics api */
+#if !defined(DD_PLATFORM_LINUX)
 #include <dd/util/util_logicalframebuffer.hpp>
 #include <dd/util/util_viewport.hpp>
 #include <dd/util/util_camera.hpp>
 #include <dd/util/util_projection.hpp>
+#endif
 
 #include <dd/util/util_deltatime.h>
@@ -0,0 +1,141 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::util {
+
+    /* Fixed width bit set for masks wider than a machine word */
+    template<size_t BitCount>
+        requires (BitCount != 0 && (BitCount % 64) == 0)
+    class BitSet {
+        public:
+            static constexpr size_t WordCount = BitCount / 64;
+            static constexpr u32    NotFound  = 0xffff'ffff;
+        private:
+            u64 m_word_array[WordCount];
+        public:
+            constexpr ALWAYS_INLINE BitSet() : m_word_array{} {/*...*/}
+
+            /* Implicit so word sized masks keep working */
+            constexpr ALWAYS_INLINE BitSet(u64 low_word) : m_word_array{low_word} {/*...*/}
+
+            constexpr ALWAYS_INLINE bool IsSet(u32 index) const {
+                return (index < BitCount) && ((m_word_array[index / 64] >> (index % 64)) & 1) != 0;
+            }
+
+            constexpr ALWAYS_INLINE void Set(u32 index) {
+                m_word_array[index / 64] |= (1ull << (index % 64));
+            }
+
+            constexpr ALWAYS_INLINE void Clear(u32 index) {
+                m_word_array[index / 64] &= ~(1ull << (index % 64));
+            }
+
+            constexpr ALWAYS_INLINE void SetWord(u32 word_index, u64 value) {
+                m_word_array[word_index] = value;
+            }
+
+            constexpr ALWAYS_INLINE u64 GetWord(u32 word_index) const {
+                return m_word_array[word_index];
+            }
+
+            constexpr ALWAYS_INLINE bool IsEmpty() const {
+                for (size_t i = 0; i < WordCount; ++i) {
+                    if (m_word_array[i] != 0) { return false; }
+                }
+                return true;
+            }
+
+            constexpr ALWAYS_INLINE u32 Count() const {
+                u32 count = 0;
+                for (size_t i = 0; i < WordCount; ++i) {
+                    count += CountOneBits64(m_word_array[i]);
+                }
+                return count;
+            }
+
+            constexpr ALWAYS_INLINE u32 FindFirstSet() const {
+                for (size_t i = 0; i < WordCount; ++i) {
+                    if (m_word_array[i] != 0) { return i * 64 + CountRightZeroBits64(m_word_array[i]); }
+                }
+                return NotFound;
+            }
+
+            /* Returns the first set bit after index */
+            constexpr ALWAYS_INLINE u32 FindNextSet(u32 index) const {
+                u32 next_index = index + 1;
+                while (next_index < BitCount) {
+                    const u64 word = m_word_array[next_index / 64] >> (next_index % 64);
+                    if (word != 0) { return next_index + CountRightZeroBits64(word); }
+                    next_index = AlignDown(next_index, 64) + 64;
+                }
+                return NotFound;
+            }
+
+            static constexpr ALWAYS_INLINE BitSet MakeBit(u32 index) {
+                BitSet bit_set;
+                bit_set.Set(index);
+                return bit_set;
+            }
+
+            /* Sets bits [0, count) */
+            static constexpr ALWAYS_INLINE BitSet MakeLowBits(u32 count) {
+                BitSet bit_set;
+                for (size_t i = 0; i < WordCount; ++i) {
+                    if (64 <= count)    { bit_set.m_word_array[i] = 0xffff'ffff'ffff'ffff; count -= 64; }
+                    else if (count != 0) { bit_set.m_word_array[i] = (1ull << count) - 1; count = 0; }
+                }
+                return bit_set;
+            }
+
+            constexpr ALWAYS_INLINE BitSet operator&(const BitSet &rhs) const {
+                BitSet bit_set;
+                for (size_t i = 0; i < WordCount; ++i) {
+                    bit_set.m_word_array[i] = m_word_array[i] & rhs.m_word_array[i];
+                }
+                return bit_set;
+            }
+
+            constexpr ALWAYS_INLINE BitSet operator|(const BitSet &rhs) const {
+                BitSet bit_set;
+                for (size_t i = 0; i < WordCount; ++i) {
+                    bit_set.m_word_array[i] = m_word_array[i] | rhs.m_word_array[i];
+                }
+                return bit_set;
+            }
+
+            constexpr ALWAYS_INLINE BitSet &operator&=(const BitSet &rhs) {
+                for (size_t i = 0; i < WordCount; ++i) {
+                    m_word_array[i] &= rhs.m_word_array[i];
+                }
+                return *this;
+            }
+
+            constexpr ALWAYS_INLINE BitSet &operator|=(const BitSet &rhs) {
+                for (size_t i = 0; i < WordCount; ++i) {
+                    m_word_array[i] |= rhs.m_word_array[i];
+                }
+                return *this;
+            }
+
+            constexpr ALWAYS_INLINE bool operator==(const BitSet &rhs) const {
+                for (size_t i = 0; i < WordCount; ++i) {
+                    if (m_word_array[i] != rhs.m_word_array[i]) { return false; }
+                }
+                return true;
+            }
+    };
+}
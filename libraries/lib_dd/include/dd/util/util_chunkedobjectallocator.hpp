@@ -0,0 +1,96 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::util {
+
+    /* Free list allocator that grows by malloc'd chunks of ChunkObjectCount objects, objects never move and chunks are only released on Finalize */
+    template <class T, size_t ChunkObjectCount, size_t MaxChunkCount>
+        requires (sizeof(void*) <= sizeof(T)) && (ChunkObjectCount != 0) && (MaxChunkCount != 0)
+    class ChunkedObjectAllocator {
+        public:
+            static constexpr size_t MaxObjectCount = ChunkObjectCount * MaxChunkCount;
+        private:
+            struct FreeList {
+                FreeList *next;
+                char      _padding[sizeof(T) - sizeof(void*)];
+            };
+            static_assert(sizeof(T) == sizeof(FreeList) && alignof(T) == alignof(FreeList));
+            static_assert(alignof(T) <= alignof(max_align_t));
+        private:
+            FreeList *m_free_list;
+            FreeList *m_chunk_array[MaxChunkCount];
+            u32       m_chunk_count;
+        private:
+            bool AllocateChunk() {
+
+                /* Fail once all chunks are in use */
+                if (MaxChunkCount <= m_chunk_count) { return false; }
+
+                FreeList *chunk = reinterpret_cast<FreeList*>(::malloc(sizeof(T) * ChunkObjectCount));
+                if (chunk == nullptr) { return false; }
+
+                /* Construct a free list of the chunk's objects */
+                for (u32 i = 0; i < (ChunkObjectCount - 1); ++i) {
+                    chunk[i].next = chunk + i + 1;
+                }
+                chunk[ChunkObjectCount - 1].next = m_free_list;
+                m_free_list = chunk;
+
+                m_chunk_array[m_chunk_count] = chunk;
+                ++m_chunk_count;
+
+                return true;
+            }
+        public:
+            constexpr ALWAYS_INLINE ChunkedObjectAllocator() : m_free_list(nullptr), m_chunk_array{}, m_chunk_count(0) {/*...*/}
+
+            void Finalize() {
+                for (u32 i = 0; i < m_chunk_count; ++i) {
+                    ::free(m_chunk_array[i]);
+                    m_chunk_array[i] = nullptr;
+                }
+                m_free_list   = nullptr;
+                m_chunk_count = 0;
+            }
+
+            ALWAYS_INLINE T *Allocate() {
+
+                /* Grow on empty free list */
+                if (m_free_list == nullptr && this->AllocateChunk() == false) { return nullptr; }
+
+                /* Pop a free object */
+                T *allocation = reinterpret_cast<T*>(m_free_list);
+                m_free_list = m_free_list->next;
+
+                /* Initialize the object */
+                std::construct_at(allocation);
+
+                return allocation;
+            }
+
+            ALWAYS_INLINE void Free(T *allocated_object) {
+
+                /* Destruct the object */
+                std::destroy_at(allocated_object);
+
+                /* Add it to the front of the free list */
+                FreeList *new_node = reinterpret_cast<FreeList*>(allocated_object);
+                new_node->next = m_free_list;
+                m_free_list = new_node;
+            }
+    };
+}
@@ -29,4 +29,30 @@ namespace dd::util {
         }
         return __builtin_popcountll(value);
     }
+
+    constexpr ALWAYS_INLINE u32 CountRightZeroBits32(u32 value) {
+        if (std::is_constant_evaluated() == true) {
+            return std::countr_zero(value);
+        }
+        return (value == 0) ? 32 : __builtin_ctz(value);
+    }
+    constexpr ALWAYS_INLINE u32 CountRightZeroBits64(u64 value) {
+        if (std::is_constant_evaluated() == true) {
+            return std::countr_zero(value);
+        }
+        return (value == 0) ? 64 : __builtin_ctzll(value);
+    }
+
+    constexpr ALWAYS_INLINE u32 CountLeftZeroBits32(u32 value) {
+        if (std::is_constant_evaluated() == true) {
+            return std::countl_zero(value);
+        }
+        return (value == 0) ? 32 : __builtin_clz(value);
+    }
+    constexpr ALWAYS_INLINE u32 CountLeftZeroBits64(u64 value) {
+        if (std::is_constant_evaluated() == true) {
+            return std::countl_zero(value);
+        }
+        return (value == 0) ? 64 : __builtin_clzll(value);
+    }
 }
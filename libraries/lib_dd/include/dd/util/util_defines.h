@@ -19,6 +19,7 @@
 #define NO_INLINE __attribute__((noinline))
 #define NO_CONSTANT_PROPAGATION __attribute__((optimize("-fno-ipa-cp")))
 #define NO_RETURN __attribute__((noreturn))
+#define USED __attribute__((used))
 
 #define DD_UNLIKELY(expression) __builtin_expect((expression), 0)
 #define DD_LIKELY(expression)   __builtin_expect((expression), 1)
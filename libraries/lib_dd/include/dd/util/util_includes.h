@@ -17,12 +17,40 @@
 
 /* Libc */
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+#include <climits>
 
 /* STD */
 #include <memory>
 #include <type_traits>
 #include <mutex>
+#include <shared_mutex>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <algorithm>
+#include <coroutine>
+#include <utility>
+
+#if defined(DD_PLATFORM_LINUX)
+
+/* Linux */
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <immintrin.h>
+
+#else
 
 /* Windows */
 #define WIN32_LEAN_AND_MEAN
@@ -32,5 +60,7 @@
 #define VK_USE_PLATFORM_WIN32_KHR
 #include <vulkan/vulkan.h>
 
+#endif
+
 /* DD */
 #include "util_defines.h"
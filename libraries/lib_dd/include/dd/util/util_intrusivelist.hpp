@@ -76,23 +76,26 @@ namespace dd::util {
                     using pointer         = T*;
                     using const_pointer   = const T*;
                 private:
+                    IntrusiveListNode *m_node;
                     IntrusiveListNode *m_next;
                 public:
-                    constexpr ALWAYS_INLINE Iterator(IntrusiveListNode *node) : m_next(node->next()) {}
-                    constexpr ALWAYS_INLINE Iterator(const IntrusiveListNode *node) : m_next(const_cast<IntrusiveListNode*>(node->next())) {}
+                    /* The next node is cached so the current node may be unlinked during iteration */
+                    constexpr ALWAYS_INLINE Iterator(IntrusiveListNode *node) : m_node(node), m_next(node->next()) {}
+                    constexpr ALWAYS_INLINE Iterator(const IntrusiveListNode *node) : m_node(const_cast<IntrusiveListNode*>(node)), m_next(const_cast<IntrusiveListNode*>(node->next())) {}
 
                     ALWAYS_INLINE reference operator*() {
-                        return Traits::GetParentReference(m_next->prev());
+                        return Traits::GetParentReference(m_node);
                     }
                     ALWAYS_INLINE const_reference operator*() const {
-                        return Traits::GetParentReference(m_next->prev());
+                        return Traits::GetParentReference(m_node);
                     }
 
                     constexpr ALWAYS_INLINE bool operator!=(const Iterator<IsConst> &rhs) const {
-                        return m_next != rhs.m_next;
+                        return m_node != rhs.m_node;
                     }
 
                     constexpr ALWAYS_INLINE Iterator<IsConst> &operator++() {
+                        m_node = m_next;
                         m_next = m_next->next();
                         return *this;
                     }
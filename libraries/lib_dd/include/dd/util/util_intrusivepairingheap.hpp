@@ -0,0 +1,187 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::util {
+
+    class IntrusivePairingHeapNode {
+        public:
+            IntrusivePairingHeapNode *m_child;
+            IntrusivePairingHeapNode *m_next;
+            IntrusivePairingHeapNode *m_prev;
+        public:
+            constexpr ALWAYS_INLINE IntrusivePairingHeapNode() : m_child(nullptr), m_next(nullptr), m_prev(nullptr) {/*...*/}
+
+            /* The root links it's previous to itself, children link their previous sibling or parent */
+            constexpr ALWAYS_INLINE bool IsLinked() const {
+                return m_prev != nullptr;
+            }
+
+            constexpr ALWAYS_INLINE void Clear() {
+                m_child = nullptr;
+                m_next  = nullptr;
+                m_prev  = nullptr;
+            }
+    };
+
+    /* Intrusive min pairing heap, Comparator::Compare(lhs, rhs) returns true when lhs should be popped before rhs */
+    template<typename T, class Traits, class Comparator>
+    class IntrusivePairingHeap {
+        public:
+            using value_type      = T;
+            using reference       = T&;
+            using const_reference = const T&;
+            using pointer         = T*;
+            using const_pointer   = const T*;
+        private:
+            IntrusivePairingHeapNode *m_root;
+        private:
+            static ALWAYS_INLINE bool CompareNodes(IntrusivePairingHeapNode *lhs, IntrusivePairingHeapNode *rhs) {
+                return Comparator::Compare(Traits::GetParentReference(lhs), Traits::GetParentReference(rhs));
+            }
+
+            static ALWAYS_INLINE IntrusivePairingHeapNode *Meld(IntrusivePairingHeapNode *lhs, IntrusivePairingHeapNode *rhs) {
+
+                /* Keep the first node to pop as the parent */
+                if (CompareNodes(rhs, lhs) == true) {
+                    IntrusivePairingHeapNode *temp = lhs;
+                    lhs = rhs;
+                    rhs = temp;
+                }
+
+                /* Make the other node the first child */
+                rhs->m_prev = lhs;
+                rhs->m_next = lhs->m_child;
+                if (lhs->m_child != nullptr) { lhs->m_child->m_prev = rhs; }
+                lhs->m_child = rhs;
+
+                return lhs;
+            }
+
+            static IntrusivePairingHeapNode *MergePairs(IntrusivePairingHeapNode *first) {
+
+                if (first == nullptr) { return nullptr; }
+
+                /* Meld siblings in pairs from left to right, collecting the results in reverse */
+                IntrusivePairingHeapNode *pair_list = nullptr;
+                while (first != nullptr) {
+                    IntrusivePairingHeapNode *lhs = first;
+                    IntrusivePairingHeapNode *rhs = lhs->m_next;
+                    if (rhs == nullptr) {
+                        lhs->m_next = pair_list;
+                        pair_list   = lhs;
+                        break;
+                    }
+                    first = rhs->m_next;
+
+                    IntrusivePairingHeapNode *pair = Meld(lhs, rhs);
+                    pair->m_next = pair_list;
+                    pair_list    = pair;
+                }
+
+                /* Meld the pairs from right to left */
+                IntrusivePairingHeapNode *result = pair_list;
+                pair_list = pair_list->m_next;
+                while (pair_list != nullptr) {
+                    IntrusivePairingHeapNode *next = pair_list->m_next;
+                    result = Meld(result, pair_list);
+                    pair_list = next;
+                }
+
+                return result;
+            }
+
+            ALWAYS_INLINE void SetRoot(IntrusivePairingHeapNode *root) {
+                m_root = root;
+                if (root == nullptr) { return; }
+                root->m_next = nullptr;
+                root->m_prev = root;
+            }
+        public:
+            constexpr ALWAYS_INLINE IntrusivePairingHeap() : m_root(nullptr) {/*...*/}
+
+            constexpr ALWAYS_INLINE bool IsEmpty() const {
+                return m_root == nullptr;
+            }
+
+            ALWAYS_INLINE reference Top() {
+                return Traits::GetParentReference(m_root);
+            }
+            ALWAYS_INLINE const_reference Top() const {
+                return Traits::GetParentReference(m_root);
+            }
+
+            void Insert(reference obj) {
+                IntrusivePairingHeapNode *node = Traits::GetHeapNode(std::addressof(obj));
+                DD_ASSERT(node->IsLinked() == false);
+
+                node->m_child = nullptr;
+                this->SetRoot((m_root == nullptr) ? node : Meld(m_root, node));
+            }
+
+            reference Pop() {
+                IntrusivePairingHeapNode *root = m_root;
+
+                this->SetRoot(MergePairs(root->m_child));
+                root->Clear();
+
+                return Traits::GetParentReference(root);
+            }
+
+            void Remove(reference obj) {
+                IntrusivePairingHeapNode *node = Traits::GetHeapNode(std::addressof(obj));
+                DD_ASSERT(node->IsLinked() == true);
+
+                /* Removing the root is a pop */
+                if (node == m_root) { this->Pop(); return; }
+
+                /* Detach from parent or previous sibling */
+                if (node->m_prev->m_child == node) {
+                    node->m_prev->m_child = node->m_next;
+                } else {
+                    node->m_prev->m_next = node->m_next;
+                }
+                if (node->m_next != nullptr) { node->m_next->m_prev = node->m_prev; }
+
+                /* Merge the orphaned children back into the heap */
+                IntrusivePairingHeapNode *sub_heap = MergePairs(node->m_child);
+                if (sub_heap != nullptr) { this->SetRoot(Meld(m_root, sub_heap)); }
+
+                node->Clear();
+            }
+    };
+
+    template<class RP, auto M>
+    struct IntrusivePairingHeapMemberTraits {
+
+        static ALWAYS_INLINE RP &GetParentReference(IntrusivePairingHeapNode *node) {
+            return *reinterpret_cast<RP*>(reinterpret_cast<uintptr_t>(node) - OffsetOf(M));
+        }
+        static ALWAYS_INLINE const RP &GetParentReference(const IntrusivePairingHeapNode *node) {
+            return *reinterpret_cast<const RP*>(reinterpret_cast<uintptr_t>(node) - OffsetOf(M));
+        }
+
+        static ALWAYS_INLINE IntrusivePairingHeapNode *GetHeapNode(const RP *parent) {
+            return reinterpret_cast<IntrusivePairingHeapNode*>(reinterpret_cast<uintptr_t>(parent) + OffsetOf(M));
+        }
+    };
+
+    template<class RP, auto M, class Comparator>
+    struct IntrusivePairingHeapTraits {
+        using Traits = IntrusivePairingHeapMemberTraits<RP, M>;
+        using Heap   = IntrusivePairingHeap<ParentType<M>, Traits, Comparator>;
+    };
+}
@@ -4,6 +4,9 @@ namespace dd::mem {
     class Heap;
 }
 
+/* The linux backend builds without mem, so it keeps the default global allocation functions */
+#if !defined(DD_PLATFORM_LINUX)
+
 ALWAYS_INLINE void *operator new(size_t size);
 ALWAYS_INLINE void *operator new(size_t size, std::align_val_t alignment);
 ALWAYS_INLINE void *operator new(size_t size, const std::nothrow_t&);
@@ -14,6 +17,8 @@ ALWAYS_INLINE void *operator new[](size_t size, std::align_val_t alignment);
 ALWAYS_INLINE void *operator new[](size_t size, const std::nothrow_t&);
 ALWAYS_INLINE void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&);
 
+#endif
+
 /* Custom */
 ALWAYS_INLINE void *operator new(size_t size, dd::mem::Heap *heap, u32 alignment);
 ALWAYS_INLINE void *operator new(size_t size, dd::mem::Heap *heap, const std::nothrow_t&);
@@ -23,6 +28,8 @@ ALWAYS_INLINE void *operator new[](size_t size, dd::mem::Heap *heap, const std::
 ALWAYS_INLINE void *operator new[](size_t size, dd::mem::Heap *heap, u32 alignment, const std::nothrow_t&);
 
 /* Default overloads */
+#if !defined(DD_PLATFORM_LINUX)
+
 ALWAYS_INLINE void operator delete(void *address);
 ALWAYS_INLINE void operator delete(void *address, std::align_val_t);
 ALWAYS_INLINE void operator delete(void *address, size_t);
@@ -37,6 +44,8 @@ ALWAYS_INLINE void operator delete[](void *address, size_t, std::align_val_t);
 ALWAYS_INLINE void operator delete[](void *address, const std::nothrow_t&);
 ALWAYS_INLINE void operator delete[](void *address, std::align_val_t, const std::nothrow_t&);
 
+#endif
+
 /* Custom */
 ALWAYS_INLINE void operator delete(void *address, dd::mem::Heap *, u32);
 ALWAYS_INLINE void operator delete(void *address, dd::mem::Heap *, const std::nothrow_t&);
@@ -45,3 +54,69 @@ ALWAYS_INLINE void operator delete(void *address, dd::mem::Heap *, u32, const st
 ALWAYS_INLINE void operator delete[](void *address, dd::mem::Heap *, u32);
 ALWAYS_INLINE void operator delete[](void *address, dd::mem::Heap *, const std::nothrow_t&);
 ALWAYS_INLINE void operator delete[](void *address, dd::mem::Heap *, u32, const std::nothrow_t&);
+
+/* The linux backend has no mem heaps, so heap allocations fall back to the system allocator */
+#if defined(DD_PLATFORM_LINUX)
+
+namespace dd::mem::impl {
+
+    constexpr inline u32 SystemNewAlignment = 8;
+
+    ALWAYS_INLINE void *SystemNewImpl(size_t size, u32 alignment) {
+        return ::aligned_alloc(alignment, (size + alignment - 1) & ~(static_cast<size_t>(alignment) - 1));
+    }
+
+    ALWAYS_INLINE void SystemDeleteImpl(void *address) {
+        ::free(address);
+    }
+}
+
+ALWAYS_INLINE void *operator new(size_t size, dd::mem::Heap *, u32 alignment) {
+    return dd::mem::impl::SystemNewImpl(size, alignment);
+}
+
+ALWAYS_INLINE void *operator new(size_t size, dd::mem::Heap *, const std::nothrow_t&) {
+    return dd::mem::impl::SystemNewImpl(size, dd::mem::impl::SystemNewAlignment);
+}
+
+ALWAYS_INLINE void *operator new(size_t size, dd::mem::Heap *, u32 alignment, const std::nothrow_t&) {
+    return dd::mem::impl::SystemNewImpl(size, alignment);
+}
+
+ALWAYS_INLINE void *operator new[](size_t size, dd::mem::Heap *, u32 alignment) {
+    return dd::mem::impl::SystemNewImpl(size, alignment);
+}
+
+ALWAYS_INLINE void *operator new[](size_t size, dd::mem::Heap *, const std::nothrow_t&) {
+    return dd::mem::impl::SystemNewImpl(size, dd::mem::impl::SystemNewAlignment);
+}
+
+ALWAYS_INLINE void *operator new[](size_t size, dd::mem::Heap *, u32 alignment, const std::nothrow_t&) {
+    return dd::mem::impl::SystemNewImpl(size, alignment);
+}
+
+ALWAYS_INLINE void operator delete(void *address, dd::mem::Heap *, u32) {
+    dd::mem::impl::SystemDeleteImpl(address);
+}
+
+ALWAYS_INLINE void operator delete(void *address, dd::mem::Heap *, const std::nothrow_t&) {
+    dd::mem::impl::SystemDeleteImpl(address);
+}
+
+ALWAYS_INLINE void operator delete(void *address, dd::mem::Heap *, u32, const std::nothrow_t&) {
+    dd::mem::impl::SystemDeleteImpl(address);
+}
+
+ALWAYS_INLINE void operator delete[](void *address, dd::mem::Heap *, u32) {
+    dd::mem::impl::SystemDeleteImpl(address);
+}
+
+ALWAYS_INLINE void operator delete[](void *address, dd::mem::Heap *, const std::nothrow_t&) {
+    dd::mem::impl::SystemDeleteImpl(address);
+}
+
+ALWAYS_INLINE void operator delete[](void *address, dd::mem::Heap *, u32, const std::nothrow_t&) {
+    dd::mem::impl::SystemDeleteImpl(address);
+}
+
+#endif
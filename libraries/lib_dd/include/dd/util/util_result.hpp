@@ -23,11 +23,11 @@ namespace dd {
         constexpr ALWAYS_INLINE u32 DescriptionBits = 13;
         constexpr ALWAYS_INLINE u32 ReserveBits     = 9;
 
-        constexpr ALWAYS_INLINE GetModule(Result result) {
+        constexpr ALWAYS_INLINE u32 GetModule(Result result) {
             return result & ModuleBits;
         }
 
-        constexpr ALWAYS_INLINE GetDescription(Result result) {
+        constexpr ALWAYS_INLINE u32 GetDescription(Result result) {
             return (result >> ModuleBits) & DescriptionBits;
         }
 
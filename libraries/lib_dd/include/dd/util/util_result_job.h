@@ -0,0 +1,27 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace dd::job {
+
+    DECLARE_RESULT_MODULE(7);
+    DECLARE_RESULT(JobGraphFull,            1);
+    DECLARE_RESULT(DependencyTableFull,     2);
+    DECLARE_RESULT(InvalidJobHandle,        3);
+    DECLARE_RESULT(InvalidDependency,       4);
+    DECLARE_RESULT(JobGraphInFlight,        5);
+    DECLARE_RESULT(JobSystemNotInitialized, 6);
+}
@@ -38,4 +38,10 @@ namespace dd::ukern {
     DECLARE_RESULT(InvalidArbitrationType,       18);
     DECLARE_RESULT(InvalidSignalType,            19);
     DECLARE_RESULT(NoWaiters,                    20);
+    DECLARE_RESULT(TraceAllocationFailure,       21);
+    DECLARE_RESULT(TraceOutputFailure,           22);
+    DECLARE_RESULT(TraceNotEnabled,              23);
+    DECLARE_RESULT(InvalidDeadline,              24);
+    DECLARE_RESULT(FiberLocalSlotExhaustion,     25);
+    DECLARE_RESULT(InvalidFiberLocalSlot,        26);
 }
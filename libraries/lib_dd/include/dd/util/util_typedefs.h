@@ -25,7 +25,11 @@ typedef uint16_t u16;
 typedef uint32_t u32;
 typedef uint64_t u64;
 
+#if defined(DD_PLATFORM_LINUX)
+typedef int Handle;
+#else
 typedef HANDLE Handle;
+#endif
 
 namespace dd {
     typedef u32 Result;
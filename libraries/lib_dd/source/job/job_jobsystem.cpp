@@ -0,0 +1,303 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <dd.hpp>
+
+namespace dd::job {
+
+    namespace impl {
+
+        class JobSystem {
+            public:
+                static constexpr size_t WorkerStackSize = 0x10000;
+            private:
+                struct alignas(64) ReadyQueue {
+                    ukern::BusyMutex  mutex;
+                    Job              *head = nullptr;
+                };
+            private:
+                ReadyQueue               m_ready_queue_array[ukern::MaxCoreCount];
+                ukern::UKernHandle       m_worker_handle_array[ukern::MaxCoreCount];
+                u32                      m_worker_count;
+                u32                      m_submit_cursor;
+                bool                     m_is_exiting;
+                ukern::InternalSemaphore m_ready_job_semaphore;
+            private:
+                static void WorkerMain(void *arg);
+
+                void PushReadyJobs(u32 queue_index, Job *first_job, Job *last_job) {
+                    ReadyQueue *ready_queue = m_ready_queue_array + queue_index;
+
+                    ukern::ScopedBusyMutex lock(std::addressof(ready_queue->mutex));
+                    last_job->m_next_ready_job = ready_queue->head;
+                    std::atomic_ref<Job*>(ready_queue->head).store(first_job, std::memory_order_relaxed);
+                }
+
+                Job *TryPopReadyJob(u32 queue_index) {
+                    ReadyQueue *ready_queue = m_ready_queue_array + queue_index;
+
+                    /* Skip empty queues without touching their lock */
+                    if (std::atomic_ref<Job*>(ready_queue->head).load(std::memory_order_relaxed) == nullptr) { return nullptr; }
+
+                    ukern::ScopedBusyMutex lock(std::addressof(ready_queue->mutex));
+                    Job *job = ready_queue->head;
+                    if (job != nullptr) {
+                        std::atomic_ref<Job*>(ready_queue->head).store(job->m_next_ready_job, std::memory_order_relaxed);
+                    }
+                    return job;
+                }
+
+                Job *PopReadyJob(u32 worker_index) {
+
+                    /* Own queue first, then steal */
+                    u32 queue_index = worker_index;
+                    for (u32 i = 0; i < m_worker_count; ++i) {
+                        Job *job = this->TryPopReadyJob(queue_index);
+                        if (job != nullptr) { return job; }
+
+                        queue_index = (queue_index + 1 < m_worker_count) ? queue_index + 1 : 0;
+                    }
+
+                    return nullptr;
+                }
+
+                ALWAYS_INLINE u32 GetCurrentQueueIndex() const {
+                    const u32 current_core = ukern::GetCurrentThread()->current_core;
+                    return (current_core < m_worker_count) ? current_core : current_core % m_worker_count;
+                }
+
+                Job *RunJob(Job *job, u32 worker_index) {
+
+                    /* Forked jobs complete through their own latch and may be gone once the function returns */
+                    JobGraph *graph = job->m_graph;
+                    job->m_function(job->m_arg);
+                    if (graph == nullptr) { return nullptr; }
+
+                    /* Release successors whose last predecessor this was, the first continues on this worker without queueing */
+                    const u32 *successor_array = graph->m_successor_array + job->m_successor_index;
+                    Job       *next_job        = nullptr;
+                    Job       *first_ready_job = nullptr;
+                    Job       *last_ready_job  = nullptr;
+                    u32        ready_count     = 0;
+                    for (u32 i = 0; i < job->m_successor_count; ++i) {
+
+                        Job *successor = graph->m_job_array + successor_array[i];
+                        if (std::atomic_ref<u32>(successor->m_remaining_predecessor_count).fetch_sub(1) != 1) { continue; }
+
+                        if (next_job == nullptr) { next_job = successor; continue; }
+
+                        successor->m_next_ready_job = first_ready_job;
+                        if (last_ready_job == nullptr) { last_ready_job = successor; }
+                        first_ready_job = successor;
+                        ++ready_count;
+                    }
+
+                    /* Queue the rest locally for other workers to steal */
+                    if (ready_count != 0) {
+                        this->PushReadyJobs(worker_index, first_ready_job, last_ready_job);
+                        m_ready_job_semaphore.Release(ready_count);
+                    }
+
+                    /* The graph may be resubmitted once the last job counts down, so it must not be touched after */
+                    graph->m_completion_latch.CountDown();
+
+                    return next_job;
+                }
+
+                void FinalizeStartedWorkers(u32 started_count) {
+
+                    /* Workers exit on the next count they take */
+                    std::atomic_ref<bool>(m_is_exiting).store(true);
+                    m_ready_job_semaphore.Release(started_count);
+
+                    for (u32 i = 0; i < started_count; ++i) {
+                        ukern::ExitThread(m_worker_handle_array[i]);
+                    }
+                }
+
+                void WorkerLoop(u32 worker_index) {
+                    for (;;) {
+                        m_ready_job_semaphore.Acquire();
+                        if (std::atomic_ref<bool>(m_is_exiting).load() == true) { return; }
+
+                        /* Counts may outnumber queued jobs when a joining fiber takes jobs itself, so an empty scan goes back to waiting */
+                        Job *job = this->PopReadyJob(worker_index);
+                        while (job != nullptr) {
+                            job = this->RunJob(job, worker_index);
+                        }
+                    }
+                }
+            public:
+                constexpr JobSystem() : m_ready_queue_array(), m_worker_handle_array(), m_worker_count(0), m_submit_cursor(0), m_is_exiting(false), m_ready_job_semaphore(0) {/*...*/}
+
+                Result Initialize(u32 core_count) {
+
+                    DD_ASSERT(m_worker_count == 0);
+                    DD_ASSERT(core_count != 0 && core_count <= ukern::GetCoreCount());
+
+                    /* Start a worker pinned to each core, workers only wait on the semaphore until jobs are submitted */
+                    m_is_exiting = false;
+                    for (u32 i = 0; i < core_count; ++i) {
+                        m_ready_queue_array[i].head = nullptr;
+
+                        const Result result0 = ukern::CreateThread(std::addressof(m_worker_handle_array[i]), WorkerMain, i, WorkerStackSize, THREAD_PRIORITY_NORMAL, i);
+                        if (result0 != ResultSuccess) {
+                            this->FinalizeStartedWorkers(i);
+                            return result0;
+                        }
+
+                        ukern::SetThreadNamePointer(m_worker_handle_array[i], "JobWorker");
+
+                        /* StartThread only fails if worker i is already gone or already schedulable, so it's joined with the started workers */
+                        const Result result1 = ukern::StartThread(m_worker_handle_array[i]);
+                        if (result1 != ResultSuccess) {
+                            this->FinalizeStartedWorkers(i + 1);
+                            return result1;
+                        }
+                    }
+                    m_worker_count = core_count;
+
+                    return ResultSuccess;
+                }
+
+                void Finalize() {
+
+                    /* Every submitted graph must be complete */
+                    this->FinalizeStartedWorkers(m_worker_count);
+                    m_worker_count = 0;
+                }
+
+                Result Submit(JobGraph *graph) {
+
+                    /* Integrity checks */
+                    RESULT_RETURN_UNLESS(m_worker_count != 0, ResultJobSystemNotInitialized);
+                    RESULT_RETURN_UNLESS(graph->IsComplete() == true, ResultJobGraphInFlight);
+
+                    if (graph->m_is_compiled == false) { graph->Compile(); }
+                    if (graph->m_job_count == 0) { return ResultSuccess; }
+                    DD_ASSERT(graph->m_root_count != 0);
+
+                    /* Rearm the dependency counters and completion latch */
+                    for (u32 i = 0; i < graph->m_job_count; ++i) {
+                        graph->m_job_array[i].m_remaining_predecessor_count = graph->m_job_array[i].m_predecessor_count;
+                    }
+                    std::construct_at(std::addressof(graph->m_completion_latch), graph->m_job_count);
+
+                    /* Deal the roots out across the workers, one push per queue. Concurrent submits each claim their own run of the cursor */
+                    Job *first_job_array[ukern::MaxCoreCount] = {};
+                    Job *last_job_array[ukern::MaxCoreCount]  = {};
+                    u32  queue_index = std::atomic_ref<u32>(m_submit_cursor).fetch_add(graph->m_root_count, std::memory_order_relaxed) % m_worker_count;
+                    for (u32 i = 0; i < graph->m_job_count; ++i) {
+                        Job *job = graph->m_job_array + i;
+                        if (job->m_predecessor_count != 0) { continue; }
+
+                        job->m_next_ready_job = first_job_array[queue_index];
+                        if (last_job_array[queue_index] == nullptr) { last_job_array[queue_index] = job; }
+                        first_job_array[queue_index] = job;
+
+                        queue_index = (queue_index + 1 < m_worker_count) ? queue_index + 1 : 0;
+                    }
+
+                    for (u32 i = 0; i < m_worker_count; ++i) {
+                        if (first_job_array[i] == nullptr) { continue; }
+                        this->PushReadyJobs(i, first_job_array[i], last_job_array[i]);
+                    }
+                    m_ready_job_semaphore.Release(graph->m_root_count);
+
+                    return ResultSuccess;
+                }
+
+                void Fork(Job *job) {
+                    DD_ASSERT(job->m_graph == nullptr);
+
+                    this->PushReadyJobs(this->GetCurrentQueueIndex(), job, job);
+                    m_ready_job_semaphore.Release(1);
+                }
+
+                void Join(Job *job, ukern::InternalLatch *completion_latch) {
+
+                    /* Take the job back and run it inline if no worker stole it yet, only the newest job is retrieved */
+                    const u32   queue_index = this->GetCurrentQueueIndex();
+                    ReadyQueue *ready_queue = m_ready_queue_array + queue_index;
+                    if (std::atomic_ref<Job*>(ready_queue->head).load(std::memory_order_relaxed) == job) {
+                        bool is_unforked = false;
+                        {
+                            ukern::ScopedBusyMutex lock(std::addressof(ready_queue->mutex));
+                            if (ready_queue->head == job) {
+                                std::atomic_ref<Job*>(ready_queue->head).store(job->m_next_ready_job, std::memory_order_relaxed);
+                                is_unforked = true;
+                            }
+                        }
+                        if (is_unforked == true) { job->m_function(job->m_arg); return; }
+                    }
+
+                    /* Help with queued jobs while the thief finishes, blocking only once there is nothing left to run */
+                    while (completion_latch->TryWait() == false) {
+                        Job *next_job = this->PopReadyJob(queue_index);
+                        if (next_job == nullptr) { completion_latch->Wait(); return; }
+
+                        while (next_job != nullptr) {
+                            next_job = this->RunJob(next_job, queue_index);
+                        }
+                    }
+                }
+
+                constexpr ALWAYS_INLINE u32 GetWorkerCount() const { return m_worker_count; }
+        };
+
+        JobSystem JobSystemInstance = {};
+
+        void JobSystem::WorkerMain(void *arg) {
+            JobSystemInstance.WorkerLoop(reinterpret_cast<uintptr_t>(arg));
+        }
+    }
+
+    Result InitializeJobSystem() {
+        return impl::JobSystemInstance.Initialize(ukern::GetCoreCount());
+    }
+
+    Result InitializeJobSystem(u32 worker_count) {
+        return impl::JobSystemInstance.Initialize(worker_count);
+    }
+
+    void FinalizeJobSystem() {
+        impl::JobSystemInstance.Finalize();
+    }
+
+    Result SubmitJobGraph(JobGraph *graph) {
+        return impl::JobSystemInstance.Submit(graph);
+    }
+
+    Result RunJobGraph(JobGraph *graph) {
+        const Result result0 = impl::JobSystemInstance.Submit(graph);
+        RESULT_RETURN_UNLESS(result0 == ResultSuccess, result0);
+
+        graph->Wait();
+
+        return ResultSuccess;
+    }
+
+    void ForkJob(Job *job) {
+        impl::JobSystemInstance.Fork(job);
+    }
+
+    void JoinJob(Job *job, ukern::InternalLatch *completion_latch) {
+        impl::JobSystemInstance.Join(job, completion_latch);
+    }
+
+    u32 GetJobWorkerCount() {
+        return impl::JobSystemInstance.GetWorkerCount();
+    }
+}
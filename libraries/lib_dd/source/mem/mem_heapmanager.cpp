@@ -5,8 +5,9 @@ namespace dd::mem {
     namespace {
         constinit util::TypeStorage<HeapManager>  sHeapManagerStorage       = {};
         constinit Heap                           *sRootHeap                 = nullptr;
-        constinit sys::Mutex                      sHeapManagerMutex         = {};
+        constinit ukern::InternalReaderWriterLock sHeapManagerLock          = {};
         constinit bool                            sIsHeapManagerInitialized = false;
+        constinit u32                             sCurrentHeapFiberSlot     = 0;
     }
 
     void InitializeHeapManager(size_t size) {
@@ -25,6 +26,10 @@ namespace dd::mem {
     
         /* Create our root heap spanning the arena */
         sRootHeap = ExpHeap::TryCreate(heap_mgr->memory, heap_mgr->memory_size, "HeapManager::sRootHeap", false);
+
+        /* Fibers cache their current heap in a fiber local slot */
+        const Result result0 = ukern::AllocateFiberLocalSlot(std::addressof(sCurrentHeapFiberSlot));
+        DD_ASSERT(result0 == ResultSuccess);
         
         sIsHeapManagerInitialized = true;
     }
@@ -41,6 +46,11 @@ namespace dd::mem {
         DD_ASSERT(result != false);
         heap_mgr->memory = nullptr;
         heap_mgr->memory_size = 0;
+
+        /* Release the current heap slot */
+        sIsHeapManagerInitialized = false;
+        const Result result1 = ukern::FreeFiberLocalSlot(sCurrentHeapFiberSlot);
+        DD_ASSERT(result1 == ResultSuccess);
     }
 
     //Heap *FindContainedHeap(void *address) {
@@ -70,7 +80,7 @@ namespace dd::mem {
     //        }
     //    }
     //
-    //    std::scoped_lock l(sHeapManagerMutex);
+    //    std::shared_lock l(sHeapManagerLock);
     //
     //    /* Lookup all children in thread's lookup heap */
     //    if (last_lookup_heap != nullptr && last_lookup_heap->HasChildren() == true) {
@@ -109,16 +119,26 @@ namespace dd::mem {
     }
 
     Heap *FindHeapByName(const char *heap_name) {
-        std::scoped_lock l(sHeapManagerMutex);
+        std::shared_lock l(sHeapManagerLock);
         mem::Heap *heap = FindHeapByNameImpl(sRootHeap, heap_name);
         if (heap == nullptr && ::strcmp(heap_name, sRootHeap->GetName()) == 0) { return sRootHeap; }
         return heap;
     }
 
     Heap *GetCurrentThreadHeap() {
+
+        /* Fast path for fibers that have already looked up their heap */
+        ukern::ThreadType *fiber = (sIsHeapManagerInitialized == true) ? ukern::GetCurrentThread() : nullptr;
+        if (fiber != nullptr) {
+            Heap *cached_heap = reinterpret_cast<Heap*>(ukern::GetFiberLocal(fiber, sCurrentHeapFiberSlot));
+            if (cached_heap != nullptr) { return cached_heap; }
+        }
+
         sys::ThreadBase *thread = sys::ThreadManager::GetInstance()->GetCurrentThread();
         if (thread != nullptr) {
-            return thread->GetThreadHeap();
+            Heap *thread_heap = thread->GetThreadHeap();
+            if (fiber != nullptr) { ukern::SetFiberLocal(fiber, sCurrentHeapFiberSlot, thread_heap); }
+            return thread_heap;
         }
         return sRootHeap;
     }
@@ -129,13 +149,19 @@ namespace dd::mem {
 
     mem::Heap *GetRootHeap() {return sRootHeap; }
 
-    constexpr ALWAYS_INLINE sys::Mutex *GetHeapManagerLock() { return std::addressof(sHeapManagerMutex); }
+    constexpr ALWAYS_INLINE ukern::InternalReaderWriterLock *GetHeapManagerLock() { return std::addressof(sHeapManagerLock); }
 
     void SetCurrentThreadHeap(Heap *heap) {
         sys::ThreadBase *thread = sys::ThreadManager::GetInstance()->GetCurrentThread();
         if (thread != nullptr) {
             thread->SetThreadCurrentHeap(heap);
         }
+
+        /* Keep the fiber's cached heap in sync */
+        ukern::ThreadType *fiber = (sIsHeapManagerInitialized == true) ? ukern::GetCurrentThread() : nullptr;
+        if (fiber != nullptr) {
+            ukern::SetFiberLocal(fiber, sCurrentHeapFiberSlot, (thread != nullptr) ? heap : nullptr);
+        }
     }
 
     bool IsAddressFromAnyHeap(void *address) {
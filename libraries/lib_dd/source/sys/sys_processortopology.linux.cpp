@@ -0,0 +1,162 @@
+#include <dd.hpp>
+
+namespace dd::sys {
+
+    namespace {
+
+        using CpuMask = util::BitSet<ProcessorTopology::MaxProcessorCount>;
+
+        constexpr size_t SysfsPathLength = 128;
+
+        /* Parses sysfs cpu lists in the "0-3,8,10-11" format */
+        bool ReadCpuList(CpuMask *out_cpu_mask, const char *path) {
+
+            FILE *file = ::fopen(path, "r");
+            if (file == nullptr) { return false; }
+
+            char line_buffer[0x400] = {};
+            const bool result = ::fgets(line_buffer, sizeof(line_buffer), file) != nullptr;
+            ::fclose(file);
+            if (result == false) { return false; }
+
+            *out_cpu_mask = {};
+            const char *iter = line_buffer;
+            while ('0' <= *iter && *iter <= '9') {
+                char *range_end = nullptr;
+                const u32 first_cpu = ::strtoul(iter, std::addressof(range_end), 10);
+                u32       last_cpu  = first_cpu;
+                if (*range_end == '-') {
+                    last_cpu = ::strtoul(range_end + 1, std::addressof(range_end), 10);
+                }
+
+                for (u32 i = first_cpu; i <= last_cpu && i < ProcessorTopology::MaxProcessorCount; ++i) {
+                    out_cpu_mask->Set(i);
+                }
+
+                iter = (*range_end == ',') ? range_end + 1 : range_end;
+            }
+
+            return true;
+        }
+
+        bool ReadSysfsLine(char *out_line, size_t line_size, const char *path) {
+
+            FILE *file = ::fopen(path, "r");
+            if (file == nullptr) { return false; }
+
+            const bool result = ::fgets(out_line, line_size, file) != nullptr;
+            ::fclose(file);
+
+            return result;
+        }
+
+        /* Sysfs identifies shared resources by cpu lists, the lowest cpu of each list keys a dense domain id */
+        class DomainMapper {
+            private:
+                u16 m_domain_array[ProcessorTopology::MaxProcessorCount];
+                u32 m_domain_count;
+            public:
+                constexpr ALWAYS_INLINE DomainMapper() : m_domain_array{}, m_domain_count(0) {
+                    for (u32 i = 0; i < ProcessorTopology::MaxProcessorCount; ++i) { m_domain_array[i] = ProcessorTopology::InvalidDomain; }
+                }
+
+                u16 GetDomain(const CpuMask &shared_cpu_mask) {
+                    const u32 key_cpu = shared_cpu_mask.FindFirstSet();
+                    if (key_cpu == CpuMask::NotFound) { return ProcessorTopology::InvalidDomain; }
+
+                    if (m_domain_array[key_cpu] == ProcessorTopology::InvalidDomain) {
+                        m_domain_array[key_cpu] = m_domain_count;
+                        ++m_domain_count;
+                    }
+                    return m_domain_array[key_cpu];
+                }
+
+                constexpr ALWAYS_INLINE u32 GetDomainCount() const { return m_domain_count; }
+        };
+    }
+
+    void QueryProcessorTopology(ProcessorTopology *out_topology) {
+
+        /* Start flat in case sysfs is unavailable */
+        CpuMask online_mask = {};
+        if (ReadCpuList(std::addressof(online_mask), "/sys/devices/system/cpu/online") == false || online_mask.IsEmpty() == true) {
+            const long online_count = ::sysconf(_SC_NPROCESSORS_ONLN);
+            out_topology->SetFlat(util::math::Clamp(online_count, 1l, static_cast<long>(ProcessorTopology::MaxProcessorCount)));
+            return;
+        }
+
+        /* Cpu ids may be sparse, processor count covers the highest online cpu */
+        u32 last_cpu = online_mask.FindFirstSet();
+        for (u32 cpu = last_cpu; cpu != CpuMask::NotFound; cpu = online_mask.FindNextSet(cpu)) { last_cpu = cpu; }
+        out_topology->SetFlat(last_cpu + 1);
+
+        /* Cpus missing from a resource share nothing at that level */
+        for (u32 i = 0; i <= last_cpu; ++i) {
+            out_topology->processor_info_array[i] = ProcessorTopology::ProcessorInfo{ ProcessorTopology::InvalidDomain, ProcessorTopology::InvalidDomain, ProcessorTopology::InvalidDomain, ProcessorTopology::InvalidDomain };
+        }
+
+        DomainMapper core_mapper;
+        DomainMapper l2_mapper;
+        DomainMapper l3_mapper;
+        for (u32 cpu = online_mask.FindFirstSet(); cpu != CpuMask::NotFound; cpu = online_mask.FindNextSet(cpu)) {
+            ProcessorTopology::ProcessorInfo *processor_info = std::addressof(out_topology->processor_info_array[cpu]);
+            char    path[SysfsPathLength] = {};
+            CpuMask shared_mask           = {};
+
+            /* SMT siblings */
+            ::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/thread_siblings_list", cpu);
+            if (ReadCpuList(std::addressof(shared_mask), path) == true) {
+                processor_info->core_id = core_mapper.GetDomain(shared_mask);
+            }
+
+            /* Data and unified caches */
+            for (u32 cache_index = 0;; ++cache_index) {
+                char level_line[16] = {};
+                ::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/level", cpu, cache_index);
+                if (ReadSysfsLine(level_line, sizeof(level_line), path) == false) { break; }
+
+                char type_line[32] = {};
+                ::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/type", cpu, cache_index);
+                if (ReadSysfsLine(type_line, sizeof(type_line), path) == false || ::strncmp(type_line, "Instruction", 11) == 0) { continue; }
+
+                ::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", cpu, cache_index);
+                if (ReadCpuList(std::addressof(shared_mask), path) == false) { continue; }
+
+                const u32 level = ::strtoul(level_line, nullptr, 10);
+                if (level == 2) {
+                    processor_info->l2_domain = l2_mapper.GetDomain(shared_mask);
+                } else if (level == 3) {
+                    processor_info->l3_domain = l3_mapper.GetDomain(shared_mask);
+                }
+            }
+        }
+
+        /* Numa nodes list their cpus, memory only nodes have none */
+        u32 numa_node_count = 0;
+        for (u32 node = 0; node < ProcessorTopology::MaxProcessorCount; ++node) {
+            char    path[SysfsPathLength] = {};
+            CpuMask node_mask             = {};
+
+            ::snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node);
+            if (ReadCpuList(std::addressof(node_mask), path) == false || node_mask.IsEmpty() == true) { continue; }
+
+            for (u32 cpu = node_mask.FindFirstSet(); cpu != CpuMask::NotFound && cpu <= last_cpu; cpu = node_mask.FindNextSet(cpu)) {
+                out_topology->processor_info_array[cpu].numa_node = numa_node_count;
+            }
+            ++numa_node_count;
+        }
+
+        /* Kernels without numa support are a single node */
+        if (numa_node_count == 0) {
+            for (u32 cpu = online_mask.FindFirstSet(); cpu != CpuMask::NotFound; cpu = online_mask.FindNextSet(cpu)) {
+                out_topology->processor_info_array[cpu].numa_node = 0;
+            }
+            numa_node_count = 1;
+        }
+
+        out_topology->core_count      = core_mapper.GetDomainCount();
+        out_topology->l2_domain_count = l2_mapper.GetDomainCount();
+        out_topology->l3_domain_count = l3_mapper.GetDomainCount();
+        out_topology->numa_node_count = numa_node_count;
+    }
+}
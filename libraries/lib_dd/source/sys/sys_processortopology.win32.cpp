@@ -0,0 +1,99 @@
+#include <dd.hpp>
+
+namespace dd::sys {
+
+    namespace {
+
+        constexpr size_t MaxProcessorGroupCount = 64;
+
+        using DomainMember = u16 ProcessorTopology::ProcessorInfo::*;
+
+        void SetDomainForGroupMask(ProcessorTopology *topology, const u32 *group_base_array, u32 group_count, const GROUP_AFFINITY &group_affinity, DomainMember domain_member, u16 domain) {
+
+            if (group_count <= group_affinity.Group) { return; }
+
+            /* Translate the group relative mask to flat processor indices */
+            for (u64 group_mask = group_affinity.Mask; group_mask != 0; group_mask &= (group_mask - 1)) {
+                const u32 processor_index = group_base_array[group_affinity.Group] + util::CountRightZeroBits64(group_mask);
+                if (topology->processor_count <= processor_index) { continue; }
+
+                topology->processor_info_array[processor_index].*domain_member = domain;
+            }
+        }
+    }
+
+    void QueryProcessorTopology(ProcessorTopology *out_topology) {
+
+        /* Start flat in case the query fails */
+        const u32 processor_count = util::math::Min(static_cast<u32>(::GetActiveProcessorCount(ALL_PROCESSOR_GROUPS)), static_cast<u32>(ProcessorTopology::MaxProcessorCount));
+        out_topology->SetFlat(processor_count);
+
+        /* Flat index of each group's first processor */
+        const u32 group_count = util::math::Min(static_cast<u32>(::GetActiveProcessorGroupCount()), static_cast<u32>(MaxProcessorGroupCount));
+        u32 group_base_array[MaxProcessorGroupCount] = {};
+        for (u32 i = 1; i < group_count; ++i) {
+            group_base_array[i] = group_base_array[i - 1] + ::GetActiveProcessorCount(i - 1);
+        }
+
+        /* Query required buffer size */
+        DWORD buffer_size = 0;
+        ::GetLogicalProcessorInformationEx(RelationAll, nullptr, std::addressof(buffer_size));
+        if (::GetLastError() != ERROR_INSUFFICIENT_BUFFER || buffer_size == 0) { return; }
+
+        u8 *info_buffer = reinterpret_cast<u8*>(::malloc(buffer_size));
+        if (info_buffer == nullptr) { return; }
+
+        const bool result = ::GetLogicalProcessorInformationEx(RelationAll, reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(info_buffer), std::addressof(buffer_size));
+        if (result == false) { ::free(info_buffer); return; }
+
+        /* Processors missing from a relation share nothing at that level */
+        for (u32 i = 0; i < processor_count; ++i) {
+            out_topology->processor_info_array[i] = ProcessorTopology::ProcessorInfo{ ProcessorTopology::InvalidDomain, ProcessorTopology::InvalidDomain, ProcessorTopology::InvalidDomain, ProcessorTopology::InvalidDomain };
+        }
+
+        /* Assign dense domain ids in the order the relations are reported */
+        u32 core_count      = 0;
+        u32 l2_domain_count = 0;
+        u32 l3_domain_count = 0;
+        u32 numa_node_count = 0;
+        for (u32 offset = 0; offset < buffer_size;) {
+            const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(info_buffer + offset);
+
+            switch (info->Relationship) {
+                case RelationProcessorCore:
+                    for (u32 i = 0; i < info->Processor.GroupCount; ++i) {
+                        SetDomainForGroupMask(out_topology, group_base_array, group_count, info->Processor.GroupMask[i], &ProcessorTopology::ProcessorInfo::core_id, core_count);
+                    }
+                    ++core_count;
+                    break;
+                case RelationCache:
+                    /* Instruction caches don't hold fiber data */
+                    if (info->Cache.Type == CacheInstruction) { break; }
+
+                    if (info->Cache.Level == 2) {
+                        SetDomainForGroupMask(out_topology, group_base_array, group_count, info->Cache.GroupMask, &ProcessorTopology::ProcessorInfo::l2_domain, l2_domain_count);
+                        ++l2_domain_count;
+                    } else if (info->Cache.Level == 3) {
+                        SetDomainForGroupMask(out_topology, group_base_array, group_count, info->Cache.GroupMask, &ProcessorTopology::ProcessorInfo::l3_domain, l3_domain_count);
+                        ++l3_domain_count;
+                    }
+                    break;
+                case RelationNumaNode:
+                    SetDomainForGroupMask(out_topology, group_base_array, group_count, info->NumaNode.GroupMask, &ProcessorTopology::ProcessorInfo::numa_node, numa_node_count);
+                    ++numa_node_count;
+                    break;
+                default:
+                    break;
+            }
+
+            offset += info->Size;
+        }
+
+        ::free(info_buffer);
+
+        out_topology->core_count      = core_count;
+        out_topology->l2_domain_count = l2_domain_count;
+        out_topology->l3_domain_count = l3_domain_count;
+        out_topology->numa_node_count = numa_node_count;
+    }
+}
@@ -18,16 +18,40 @@ namespace dd::sys {
         DD_ASSERT(instance->system_info.wProcessorArchitecture == PROCESSOR_ARCHITECTURE_AMD64);
         DD_ASSERT(instance->system_info.dwPageSize == 0x1000);
 
-        /* Get active processor count from group 0 */
-        instance->active_processor_count = ::GetActiveProcessorCount(0);
-        DD_ASSERT(instance->active_processor_count != 0);
+        /* Get active processor count across all processor groups */
+        instance->processor_group_count  = ::GetActiveProcessorGroupCount();
+        instance->active_processor_count = ::GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+        DD_ASSERT(instance->active_processor_count != 0 && instance->active_processor_count <= SystemManager::MaximumSupportedProcessorCount);
 
-        /* Get current process affinity mask */
-        const bool result = ::GetProcessAffinityMask(::GetCurrentProcess(), std::addressof(instance->process_core_mask), std::addressof(instance->system_core_mask));
-        DD_ASSERT(result != false);
-        DD_ASSERT(instance->process_core_mask != 0 && instance->system_core_mask != 0);
+        /* Get current process affinity mask, both masks are 0 when the process already spans groups */
+        const bool result0 = ::GetProcessAffinityMask(::GetCurrentProcess(), std::addressof(instance->process_core_mask), std::addressof(instance->system_core_mask));
+        DD_ASSERT(result0 != false);
 
-        instance->process_core_count = util::CountOneBits64(instance->process_core_mask);
+        /* The process affinity mask only covers our primary group, threads may be placed in any other group */
+        GROUP_AFFINITY primary_affinity = {};
+        const bool result1 = ::GetThreadGroupAffinity(::GetCurrentThread(), std::addressof(primary_affinity));
+        DD_ASSERT(result1 != false);
+
+        u32 group_processor_base = 0;
+        for (u16 group = 0; group < instance->processor_group_count; ++group) {
+            const u32 group_processor_count = ::GetActiveProcessorCount(group);
+
+            u64 group_mask = (group_processor_count == 64) ? 0xffff'ffff'ffff'ffff : ((1ull << group_processor_count) - 1);
+            if (group == primary_affinity.Group && instance->process_core_mask != 0) {
+                group_mask &= instance->process_core_mask;
+            }
+
+            for (; group_mask != 0; group_mask &= (group_mask - 1)) {
+                instance->process_processor_mask.Set(group_processor_base + util::CountRightZeroBits64(group_mask));
+            }
+            group_processor_base += group_processor_count;
+        }
+
+        instance->process_core_count = instance->process_processor_mask.Count();
+        DD_ASSERT(instance->process_core_count != 0);
+
+        /* Get SMT, cache and numa topology */
+        QueryProcessorTopology(std::addressof(instance->processor_topology));
     }
 
     SystemManager *GetSystemManager() { return util::GetPointer(sSystemManagerStorage); }
@@ -36,6 +60,14 @@ namespace dd::sys {
         return GetSystemManager()->process_core_count;
     }
 
+    const SystemManager::ProcessorMask &GetProcessProcessorMask() {
+        return GetSystemManager()->process_processor_mask;
+    }
+
+    const ProcessorTopology *GetProcessorTopology() {
+        return std::addressof(GetSystemManager()->processor_topology);
+    }
+
     u32 GetCurrentThreadCoreNumber() {
         return ::GetCurrentProcessorNumber();
     }
@@ -43,15 +43,7 @@ namespace dd::trace::impl {
         /* Try to create an output file for crash data */
         char file_path[256] = {};
         ::snprintf(file_path, 256, "crash_report_module_%d_desc_%d.txt", result::GetModule(result), result::GetDescription(result));
-        HANDLE crash_file = ::CreateFile(file_path, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
-
-        /* Try write output to file */
-        if (crash_file == INVALID_HANDLE_VALUE) {
-            ::puts("failed to create file");
-            Abort(result);
-        }
-        const bool write_result = ::WriteFile(crash_file, output, output_length, nullptr, nullptr);
-        if (write_result == false) {
+        if (OutputCrashReport(file_path, output, output_length) == false) {
             Abort(result);
         }
 
@@ -61,10 +53,4 @@ namespace dd::trace::impl {
         /* Abort */
         Abort(result);
     }
-
-    void Abort(const Result result) {
-        /* Signal debugger if able */
-        Break();
-        ::ExitProcess(result);
-    }
 }
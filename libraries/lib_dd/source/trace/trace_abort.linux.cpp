@@ -0,0 +1,67 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <dd.hpp>
+
+namespace dd::trace {
+
+    bool IsDebuggerPresent() {
+
+        /* A non-zero tracer pid means a debugger is attached */
+        const int status_file = ::open("/proc/self/status", O_RDONLY);
+        if (status_file < 0) { return false; }
+
+        char status[1024] = {};
+        const ssize_t read_size = ::read(status_file, status, sizeof(status) - 1);
+        ::close(status_file);
+        if (read_size <= 0) { return false; }
+
+        const char *tracer_pid = ::strstr(status, "TracerPid:");
+        if (tracer_pid == nullptr) { return false; }
+
+        return ::atoi(tracer_pid + sizeof("TracerPid:") - 1) != 0;
+    }
+
+    void Break() {
+        if (IsDebuggerPresent() == true) {
+            ::raise(SIGTRAP);
+        }
+    }
+
+    namespace impl {
+
+        bool OutputCrashReport(const char *file_path, const char *output, size_t output_length) {
+
+            /* Try to create an output file for crash data */
+            const int crash_file = ::open(file_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (crash_file < 0) {
+                ::puts("failed to create file");
+                return false;
+            }
+
+            /* Try write output to file */
+            const ssize_t write_size = ::write(crash_file, output, output_length);
+            ::close(crash_file);
+
+            return write_size == static_cast<ssize_t>(output_length);
+        }
+
+        void Abort(const Result result) {
+            /* Signal debugger if able */
+            Break();
+            ::_exit(result);
+        }
+    }
+}
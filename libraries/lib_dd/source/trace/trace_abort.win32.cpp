@@ -0,0 +1,51 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <dd.hpp>
+
+namespace dd::trace {
+
+    bool IsDebuggerPresent() {
+        return ::IsDebuggerPresent();
+    }
+
+    void Break() {
+        if (IsDebuggerPresent() == true) {
+            ::DebugBreak();
+        }
+    }
+
+    namespace impl {
+
+        bool OutputCrashReport(const char *file_path, const char *output, size_t output_length) {
+
+            /* Try to create an output file for crash data */
+            HANDLE crash_file = ::CreateFile(file_path, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (crash_file == INVALID_HANDLE_VALUE) {
+                ::puts("failed to create file");
+                return false;
+            }
+
+            /* Try write output to file */
+            return ::WriteFile(crash_file, output, output_length, nullptr, nullptr);
+        }
+
+        void Abort(const Result result) {
+            /* Signal debugger if able */
+            Break();
+            ::ExitProcess(result);
+        }
+    }
+}
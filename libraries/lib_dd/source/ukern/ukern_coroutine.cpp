@@ -0,0 +1,84 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <dd.hpp>
+
+namespace dd::ukern {
+
+    namespace {
+
+        constexpr size_t CoroutineRunnerStackSize = 0x10000;
+
+        UKernHandle sCoroutineRunnerHandleArray[MaxCoreCount] = {};
+        u32         sCoroutineRunnerCount                     = 0;
+
+        void CoroutineRunnerMain(void *) {
+
+            /* Resume coroutines until the runners exit, a resumed coroutine runs until it's next suspension */
+            for (;;) {
+                impl::CoroutineResumeNode *resume_node = impl::GetScheduler()->WaitForReadyCoroutineImpl();
+                if (resume_node == nullptr) { return; }
+
+                resume_node->handle.resume();
+            }
+        }
+    }
+
+    namespace impl {
+
+        void AbortUnlessAsyncWaitSucceeded(Result wait_result) {
+            RESULT_ABORT_UNLESS(wait_result, ResultSuccess);
+        }
+    }
+
+    Result StartCoroutineRunners() {
+
+        DD_ASSERT(sCoroutineRunnerCount == 0);
+        impl::GetScheduler()->ResetCoroutineRunnersImpl();
+
+        /* Start a runner pinned to each core */
+        const u32 core_count = GetCoreCount();
+        for (u32 i = 0; i < core_count; ++i) {
+            const Result result0 = CreateThread(std::addressof(sCoroutineRunnerHandleArray[i]), CoroutineRunnerMain, 0, CoroutineRunnerStackSize, THREAD_PRIORITY_NORMAL, i);
+            if (result0 != ResultSuccess) {
+                ExitCoroutineRunners();
+                return result0;
+            }
+
+            SetThreadNamePointer(sCoroutineRunnerHandleArray[i], "CoroutineRunner");
+
+            /* StartThread only fails if runner i is already gone or already schedulable, so it's exited with the started runners */
+            const Result result1 = StartThread(sCoroutineRunnerHandleArray[i]);
+            sCoroutineRunnerCount = i + 1;
+            if (result1 != ResultSuccess) {
+                ExitCoroutineRunners();
+                return result1;
+            }
+        }
+
+        return ResultSuccess;
+    }
+
+    void ExitCoroutineRunners() {
+
+        /* Runners drain the ready coroutines before exiting */
+        impl::GetScheduler()->ExitCoroutineRunnersImpl();
+
+        for (u32 i = 0; i < sCoroutineRunnerCount; ++i) {
+            ExitThread(sCoroutineRunnerHandleArray[i]);
+        }
+        sCoroutineRunnerCount = 0;
+    }
+}
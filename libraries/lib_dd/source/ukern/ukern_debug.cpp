@@ -22,8 +22,23 @@ namespace dd::ukern::impl {
         scheduler->SuspendAllOtherCoresImpl();
     }
 
-    void OutputBackTraceToFileAll(HANDLE file) {
+    void OutputBackTraceToFileAll(Handle file) {
        impl::UserScheduler *scheduler = impl::GetScheduler();
         scheduler->OutputBackTraceImpl(file);
     }
 }
+
+namespace dd::ukern {
+
+    Result EnableSchedulerTrace() {
+        return impl::GetScheduler()->EnableTraceImpl();
+    }
+
+    void DisableSchedulerTrace() {
+        impl::GetScheduler()->DisableTraceImpl();
+    }
+
+    Result ExportSchedulerTrace(const char *path) {
+        return impl::GetScheduler()->ExportTraceImpl(path);
+    }
+}
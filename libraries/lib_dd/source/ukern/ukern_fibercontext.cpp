@@ -0,0 +1,45 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <dd.hpp>
+
+namespace dd::ukern::impl {
+
+    FiberContext CreateFiberContext(size_t stack_size, FiberMainFunction fiber_main, void *arg) {
+
+        /* Allocate stack region */
+        if (stack_size < MinFiberStackSize) { stack_size = MinFiberStackSize; }
+        const size_t region_size = GetFiberStackRegionSize(stack_size);
+        void *stack_region = AllocateFiberStackRegion(region_size);
+        if (stack_region == nullptr) { return nullptr; }
+
+        /* Setup context at the top of the stack region */
+        FiberContext fiber_context = reinterpret_cast<FiberContext>(reinterpret_cast<uintptr_t>(stack_region) + region_size - sizeof(FiberContextImpl));
+        fiber_context->stack_region      = stack_region;
+        fiber_context->stack_region_size = region_size;
+        fiber_context->fiber_main        = fiber_main;
+        fiber_context->fiber_arg         = arg;
+        fiber_context->next_free_context = nullptr;
+        fiber_context->stack_size_class  = UnpooledStackSizeClass;
+
+        InitializeFiberContextFrame(fiber_context);
+
+        return fiber_context;
+    }
+
+    void DeleteFiberContext(FiberContext fiber_context) {
+        FreeFiberStackRegion(fiber_context->stack_region, fiber_context->stack_region_size);
+    }
+}
@@ -0,0 +1,145 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <dd.hpp>
+
+namespace dd::ukern::impl {
+
+    /* Saves the callee-saved registers and fpu control state of the current context to it's stack, then restores the next context's */
+    extern "C" void UKernSwitchFiberContextImpl(void **out_stack_pointer, void *next_stack_pointer);
+
+    /* First return target of a new fiber context, calls UKernFiberContextMain with the context held in r12. UKernFiberContextMain is marked used since only this asm references it */
+    extern "C" void UKernFiberContextEntry();
+
+    asm (
+        ".text\n"
+        ".globl UKernSwitchFiberContextImpl\n"
+        ".type UKernSwitchFiberContextImpl, @function\n"
+        "UKernSwitchFiberContextImpl:\n"
+        "    pushq %rbp\n"
+        "    pushq %rbx\n"
+        "    pushq %r12\n"
+        "    pushq %r13\n"
+        "    pushq %r14\n"
+        "    pushq %r15\n"
+        "    subq $8, %rsp\n"
+        "    stmxcsr (%rsp)\n"
+        "    fnstcw 4(%rsp)\n"
+        "    movq %rsp, (%rdi)\n"
+        "    movq %rsi, %rsp\n"
+        "    ldmxcsr (%rsp)\n"
+        "    fldcw 4(%rsp)\n"
+        "    addq $8, %rsp\n"
+        "    popq %r15\n"
+        "    popq %r14\n"
+        "    popq %r13\n"
+        "    popq %r12\n"
+        "    popq %rbx\n"
+        "    popq %rbp\n"
+        "    ret\n"
+        ".size UKernSwitchFiberContextImpl, .-UKernSwitchFiberContextImpl\n"
+        ".globl UKernFiberContextEntry\n"
+        ".type UKernFiberContextEntry, @function\n"
+        "UKernFiberContextEntry:\n"
+        "    movq %r12, %rdi\n"
+        "    call UKernFiberContextMain\n"
+        "    ud2\n"
+        ".size UKernFiberContextEntry, .-UKernFiberContextEntry\n"
+    );
+
+    extern "C" USED NO_RETURN void UKernFiberContextMain(FiberContext fiber_context) {
+
+        /* Fiber mains switch away instead of returning */
+        (fiber_context->fiber_main)(fiber_context->fiber_arg);
+
+        ::abort();
+    }
+
+    namespace {
+
+        /* Initial register frame of a new context, popped by UKernSwitchFiberContextImpl */
+        struct InitialContextFrame {
+            u32   mxcsr;
+            u16   fpu_control_word;
+            u16   reserved;
+            u64   r15;
+            u64   r14;
+            u64   r13;
+            u64   r12;
+            u64   rbx;
+            u64   rbp;
+            void *return_address;
+        };
+        static_assert(sizeof(InitialContextFrame) == 0x40);
+
+        constexpr u32 DefaultMxcsr          = 0x1f80;
+        constexpr u16 DefaultFpuControlWord = 0x37f;
+
+        thread_local FiberContextImpl  sThreadFiberContext  = {};
+        thread_local FiberContext      sCurrentFiberContext = nullptr;
+    }
+
+    FiberContext ConvertThreadToFiberContext(void *arg) {
+
+        /* The thread's own stack backs it's context, the stack pointer is filled on the first switch out */
+        FiberContext thread_context = std::addressof(sThreadFiberContext);
+        thread_context->fiber_arg   = arg;
+        sCurrentFiberContext        = thread_context;
+
+        return thread_context;
+    }
+
+    void *AllocateFiberStackRegion(size_t region_size) {
+
+        /* Map stack with a guard page below it */
+        void *stack_region = ::mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+        if (stack_region == MAP_FAILED) { return nullptr; }
+
+        ::mprotect(stack_region, FiberGuardPageSize, PROT_NONE);
+
+        return stack_region;
+    }
+
+    void FreeFiberStackRegion(void *stack_region, size_t region_size) {
+        ::munmap(stack_region, region_size);
+    }
+
+    void InitializeFiberContextFrame(FiberContext fiber_context) {
+
+        /* Build the initial frame so the first switch returns into the entry stub with an aligned stack */
+        const uintptr_t stack_top  = util::AlignDown(reinterpret_cast<uintptr_t>(fiber_context), 0x10);
+        InitialContextFrame *frame = reinterpret_cast<InitialContextFrame*>(stack_top - sizeof(InitialContextFrame));
+        *frame = {};
+        frame->mxcsr            = DefaultMxcsr;
+        frame->fpu_control_word = DefaultFpuControlWord;
+        frame->r12              = reinterpret_cast<u64>(fiber_context);
+        frame->return_address   = reinterpret_cast<void*>(UKernFiberContextEntry);
+
+        fiber_context->stack_pointer = frame;
+    }
+
+    NO_INLINE void SwitchToFiberContext(FiberContext fiber_context) {
+
+        /* Fibers may resume on another core's thread, so thread locals are not touched after the switch */
+        FiberContext last_context = sCurrentFiberContext;
+        sCurrentFiberContext      = fiber_context;
+
+        UKernSwitchFiberContextImpl(std::addressof(last_context->stack_pointer), fiber_context->stack_pointer);
+    }
+
+    NO_INLINE void *GetFiberContextArgument() {
+        return sCurrentFiberContext->fiber_arg;
+    }
+}
@@ -0,0 +1,191 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <dd.hpp>
+
+namespace dd::ukern::impl {
+
+    /* Saves the Win64 callee-saved registers, fpu control state and TIB stack bounds of the current context to it's stack, then restores the next context's */
+    extern "C" void UKernSwitchFiberContextImpl(void **out_stack_pointer, void *next_stack_pointer);
+
+    /* First return target of a new fiber context, calls UKernFiberContextMain with the context held in r12. UKernFiberContextMain is marked used since only this asm references it */
+    extern "C" void UKernFiberContextEntry();
+
+    asm (
+        ".text\n"
+        ".globl UKernSwitchFiberContextImpl\n"
+        "UKernSwitchFiberContextImpl:\n"
+        "    pushq %rbp\n"
+        "    pushq %rbx\n"
+        "    pushq %rdi\n"
+        "    pushq %rsi\n"
+        "    pushq %r12\n"
+        "    pushq %r13\n"
+        "    pushq %r14\n"
+        "    pushq %r15\n"
+        "    pushq %gs:0x08\n"
+        "    pushq %gs:0x10\n"
+        "    pushq %gs:0x1478\n"
+        "    subq $0xa8, %rsp\n"
+        "    stmxcsr (%rsp)\n"
+        "    fnstcw 4(%rsp)\n"
+        "    movups %xmm6,  0x08(%rsp)\n"
+        "    movups %xmm7,  0x18(%rsp)\n"
+        "    movups %xmm8,  0x28(%rsp)\n"
+        "    movups %xmm9,  0x38(%rsp)\n"
+        "    movups %xmm10, 0x48(%rsp)\n"
+        "    movups %xmm11, 0x58(%rsp)\n"
+        "    movups %xmm12, 0x68(%rsp)\n"
+        "    movups %xmm13, 0x78(%rsp)\n"
+        "    movups %xmm14, 0x88(%rsp)\n"
+        "    movups %xmm15, 0x98(%rsp)\n"
+        "    movq %rsp, (%rcx)\n"
+        "    movq %rdx, %rsp\n"
+        "    ldmxcsr (%rsp)\n"
+        "    fldcw 4(%rsp)\n"
+        "    movups 0x08(%rsp), %xmm6\n"
+        "    movups 0x18(%rsp), %xmm7\n"
+        "    movups 0x28(%rsp), %xmm8\n"
+        "    movups 0x38(%rsp), %xmm9\n"
+        "    movups 0x48(%rsp), %xmm10\n"
+        "    movups 0x58(%rsp), %xmm11\n"
+        "    movups 0x68(%rsp), %xmm12\n"
+        "    movups 0x78(%rsp), %xmm13\n"
+        "    movups 0x88(%rsp), %xmm14\n"
+        "    movups 0x98(%rsp), %xmm15\n"
+        "    addq $0xa8, %rsp\n"
+        "    popq %gs:0x1478\n"
+        "    popq %gs:0x10\n"
+        "    popq %gs:0x08\n"
+        "    popq %r15\n"
+        "    popq %r14\n"
+        "    popq %r13\n"
+        "    popq %r12\n"
+        "    popq %rsi\n"
+        "    popq %rdi\n"
+        "    popq %rbx\n"
+        "    popq %rbp\n"
+        "    ret\n"
+        ".globl UKernFiberContextEntry\n"
+        "UKernFiberContextEntry:\n"
+        "    movq %r12, %rcx\n"
+        "    subq $0x20, %rsp\n"
+        "    call UKernFiberContextMain\n"
+        "    ud2\n"
+    );
+
+    extern "C" USED NO_RETURN void UKernFiberContextMain(FiberContext fiber_context) {
+
+        /* Fiber mains switch away instead of returning */
+        (fiber_context->fiber_main)(fiber_context->fiber_arg);
+
+        ::abort();
+    }
+
+    namespace {
+
+        /* Initial register frame of a new context, popped by UKernSwitchFiberContextImpl */
+        struct InitialContextFrame {
+            u32   mxcsr;
+            u16   fpu_control_word;
+            u16   reserved;
+            u64   xmm6_15[20];
+            void *deallocation_stack;
+            void *stack_limit;
+            void *stack_base;
+            u64   r15;
+            u64   r14;
+            u64   r13;
+            u64   r12;
+            u64   rsi;
+            u64   rdi;
+            u64   rbx;
+            u64   rbp;
+            void *return_address;
+        };
+        static_assert(sizeof(InitialContextFrame) == 0x108);
+
+        constexpr u32 DefaultMxcsr          = 0x1f80;
+        constexpr u16 DefaultFpuControlWord = 0x27f;
+
+        /* The current context is kept in the TIB's fiber data slot, which Win32 fibers are no longer using */
+        ALWAYS_INLINE void SetCurrentFiberContext(FiberContext fiber_context) {
+            asm volatile ("movq %0, %%gs:0x20" : : "r" (fiber_context) : "memory");
+        }
+
+        ALWAYS_INLINE FiberContext GetCurrentFiberContext() {
+            FiberContext fiber_context = nullptr;
+            asm volatile ("movq %%gs:0x20, %0" : "=r" (fiber_context) : : "memory");
+            return fiber_context;
+        }
+
+        thread_local FiberContextImpl sThreadFiberContext = {};
+    }
+
+    FiberContext ConvertThreadToFiberContext(void *arg) {
+
+        /* The thread's own stack backs it's context, the stack pointer is filled on the first switch out */
+        FiberContext thread_context = std::addressof(sThreadFiberContext);
+        thread_context->fiber_arg   = arg;
+        SetCurrentFiberContext(thread_context);
+
+        return thread_context;
+    }
+
+    void *AllocateFiberStackRegion(size_t region_size) {
+
+        /* Commit stack with a guard page below it */
+        void *stack_region = ::VirtualAlloc(nullptr, region_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        if (stack_region == nullptr) { return nullptr; }
+
+        long unsigned int old_protect = 0;
+        ::VirtualProtect(stack_region, FiberGuardPageSize, PAGE_NOACCESS, std::addressof(old_protect));
+
+        return stack_region;
+    }
+
+    void FreeFiberStackRegion(void *stack_region, [[maybe_unused]] size_t region_size) {
+        ::VirtualFree(stack_region, 0, MEM_RELEASE);
+    }
+
+    void InitializeFiberContextFrame(FiberContext fiber_context) {
+
+        /* Build the initial frame so the first switch returns into the entry stub with an aligned stack */
+        const uintptr_t stack_top  = util::AlignDown(reinterpret_cast<uintptr_t>(fiber_context), 0x10);
+        InitialContextFrame *frame = reinterpret_cast<InitialContextFrame*>(stack_top - sizeof(InitialContextFrame));
+        *frame = {};
+        frame->mxcsr              = DefaultMxcsr;
+        frame->fpu_control_word   = DefaultFpuControlWord;
+        frame->deallocation_stack = fiber_context->stack_region;
+        frame->stack_limit        = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(fiber_context->stack_region) + FiberGuardPageSize);
+        frame->stack_base         = reinterpret_cast<void*>(stack_top);
+        frame->r12                = reinterpret_cast<u64>(fiber_context);
+        frame->return_address     = reinterpret_cast<void*>(UKernFiberContextEntry);
+
+        fiber_context->stack_pointer = frame;
+    }
+
+    NO_INLINE void SwitchToFiberContext(FiberContext fiber_context) {
+
+        FiberContext last_context = GetCurrentFiberContext();
+        SetCurrentFiberContext(fiber_context);
+
+        UKernSwitchFiberContextImpl(std::addressof(last_context->stack_pointer), fiber_context->stack_pointer);
+    }
+
+    NO_INLINE void *GetFiberContextArgument() {
+        return GetCurrentFiberContext()->fiber_arg;
+    }
+}
@@ -17,35 +17,86 @@
 
 namespace dd::ukern {
 
-    bool FiberLocalStorage::IsSchedulable(u32 core_number, u64 time) {
-        if (fiber_state != FiberState_Scheduled)          { return false; }
-        if ((core_mask & (1 << core_number)) == 0)        { return false; }
-        if (waitable_object != nullptr && timeout < time) { waitable_object->CancelWait(this, ResultTimeout); return true; }
-        if (timeout < time)                               { return true; }
+    bool FiberLocalStorage::IsSchedulable(u32 core_number) {
+        if (fiber_state != FiberState_Scheduled)        { return false; }
+        if (core_mask.IsSet(core_number) == false)      { return false; }
 
-        return false;
+        return true;
     }
 
-    void FiberLocalStorage::ReleaseLockWaitListUnsafe() {
+    void FiberLocalStorage::SetCoreMaskUnsafe(const UKernCoreMask &allowed_core_mask) {
 
-        DD_ASSERT(this->wait_list.IsEmpty() == false);
+        /* Cache the fallback core and pinning so core selection doesn't scan the mask */
+        core_mask          = allowed_core_mask;
+        first_allowed_core = allowed_core_mask.FindFirstSet();
+        is_core_pinned     = allowed_core_mask.FindNextSet(first_allowed_core) == UKernCoreMask::NotFound;
+    }
 
-        /* Get waiter to signal */
-        FiberLocalStorage &next_owner = this->wait_list.PopFront();
+    void FiberLocalStorage::AddLockWaiterUnsafe(FiberLocalStorage *waiter) {
 
-        /* Set wait tag and clear state */
-        *next_owner.lock_address = (this->wait_list.IsEmpty() == true) ? next_owner.wait_tag : next_owner.wait_tag | HasChildWaitersBit;
-        next_owner.lock_address  = nullptr;
-        next_owner.wait_tag      = 0;
+        /* Keep lock waiters ordered by priority, first come first served within a level */
+        for (FiberLocalStorage &queued_waiter : this->wait_list) {
+            if (queued_waiter.priority < waiter->priority) {
+                queued_waiter.wait_list_node.LinkNext(std::addressof(waiter->wait_list_node));
+                return;
+            }
+        }
+
+        this->wait_list.PushBack(*waiter);
+    }
+
+    s32 FiberLocalStorage::GetInheritedPriorityUnsafe() const {
+
+        /* The front waiter has the highest priority across all locks we hold */
+        if (this->wait_list.IsEmpty() == true) { return base_priority; }
+
+        const s32 waiter_priority = this->wait_list.Front().priority;
+        return (base_priority < waiter_priority) ? waiter_priority : base_priority;
+    }
+
+    void FiberLocalStorage::ReleaseLockWaitListUnsafe(u32 *lock_address) {
 
-        /* Transfer waiters to new owner */
+        /* Find the highest priority waiter on this lock, we may hold other locks */
+        FiberLocalStorage *next_owner = nullptr;
         for (FiberLocalStorage &waiter : this->wait_list) {
+            if (waiter.lock_address == lock_address) {
+                next_owner = std::addressof(waiter);
+                break;
+            }
+        }
+
+        /* A waiter may have tagged the lock without reaching arbitration yet, release it so the waiter retries */
+        if (next_owner == nullptr) {
+            *lock_address = 0;
+            return;
+        }
+        next_owner->wait_list_node.Unlink();
+
+        /* Transfer waiters on this lock to the new owner */
+        bool has_waiters = false;
+        for (FiberLocalStorage &waiter : this->wait_list) {
+            if (waiter.lock_address != lock_address) { continue; }
+
             waiter.wait_list_node.Unlink();
-            next_owner.wait_list.PushBack(waiter);
+            next_owner->AddLockWaiterUnsafe(std::addressof(waiter));
+            has_waiters = true;
         }
 
-        /* End next owner's wait */
-        next_owner.waitable_object->EndWait(std::addressof(next_owner), ResultSuccess);
-        next_owner.waitable_object = nullptr;
+        /* Drop the priority inherited through this lock, the next owner inherits from the remaining waiters */
+        impl::UserScheduler *scheduler = impl::GetScheduler();
+        scheduler->UpdateInheritedPriorityUnsafe(this);
+        scheduler->UpdateInheritedPriorityUnsafe(next_owner);
+
+        /* Set wait tag and clear state */
+        *lock_address = (has_waiters == false) ? next_owner->wait_tag : next_owner->wait_tag | HasChildWaitersBit;
+        next_owner->lock_address  = nullptr;
+        next_owner->wait_tag      = 0;
+
+        /* End next owner's wait, the next owner may run as soon as it's wait ends */
+        impl::WaitableObject *waitable_object = next_owner->waitable_object;
+        next_owner->waitable_object = nullptr;
+        impl::CoreWakeBatch wake_batch = {};
+        waitable_object->EndWait(next_owner, ResultSuccess, std::addressof(wake_batch));
+        scheduler->WakeCores(wake_batch);
     }
 }
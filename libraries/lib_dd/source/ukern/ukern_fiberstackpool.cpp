@@ -0,0 +1,81 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <dd.hpp>
+
+namespace dd::ukern::impl {
+
+    FiberContext FiberStackPool::Allocate(size_t stack_size, FiberMainFunction fiber_main, void *arg) {
+
+        /* Oversized stacks are not pooled */
+        const u32 size_class = GetSizeClass(stack_size);
+        if (size_class == UnpooledStackSizeClass) {
+            m_miss_count.fetch_add(1, std::memory_order_relaxed);
+            return CreateFiberContext(stack_size, fiber_main, arg);
+        }
+
+        /* Try to pop a free stack of our size class */
+        SizeClass    *pool_class    = m_size_class_array + size_class;
+        FiberContext  fiber_context = nullptr;
+        {
+            ScopedBusyMutex lock(std::addressof(pool_class->mutex));
+            fiber_context = pool_class->free_list;
+            if (fiber_context != nullptr) {
+                pool_class->free_list = fiber_context->next_free_context;
+            }
+        }
+
+        /* Miss, create a new stack of the full class size */
+        if (fiber_context == nullptr) {
+            m_miss_count.fetch_add(1, std::memory_order_relaxed);
+
+            fiber_context = CreateFiberContext(MinFiberStackSize << size_class, fiber_main, arg);
+            if (fiber_context == nullptr) { return nullptr; }
+
+            fiber_context->stack_size_class = size_class;
+
+            return fiber_context;
+        }
+
+        /* Hit, reinitialize the recycled context */
+        m_hit_count.fetch_add(1, std::memory_order_relaxed);
+        m_bytes_held.fetch_sub(fiber_context->stack_region_size, std::memory_order_relaxed);
+
+        fiber_context->fiber_main        = fiber_main;
+        fiber_context->fiber_arg         = arg;
+        fiber_context->next_free_context = nullptr;
+        InitializeFiberContextFrame(fiber_context);
+
+        return fiber_context;
+    }
+
+    void FiberStackPool::Free(FiberContext fiber_context) {
+
+        /* Release unpooled stacks */
+        const u32 size_class = fiber_context->stack_size_class;
+        if (size_class == UnpooledStackSizeClass) {
+            DeleteFiberContext(fiber_context);
+            return;
+        }
+
+        /* Push the stack to it's size class */
+        m_bytes_held.fetch_add(fiber_context->stack_region_size, std::memory_order_relaxed);
+
+        SizeClass *pool_class = m_size_class_array + size_class;
+        ScopedBusyMutex lock(std::addressof(pool_class->mutex));
+        fiber_context->next_free_context = pool_class->free_list;
+        pool_class->free_list            = fiber_context;
+    }
+}
@@ -25,7 +25,20 @@ namespace dd::ukern {
         }
     }
 
-    void InitializeUKern(u64 core_mask) {
-        impl::SchedulerInstance.Initialize(core_mask);
+    void InitializeUKern(const UKernCoreMask &processor_mask) {
+
+        /* Query the topology ourselves, the system manager may not be initialized yet */
+        sys::ProcessorTopology processor_topology = {};
+        sys::QueryProcessorTopology(std::addressof(processor_topology));
+
+        impl::SchedulerInstance.Initialize(processor_mask, processor_topology);
+    }
+
+    void InitializeUKern(const UKernCoreMask &processor_mask, const sys::ProcessorTopology &processor_topology) {
+        impl::SchedulerInstance.Initialize(processor_mask, processor_topology);
+    }
+
+    u32 GetCoreCount() {
+        return impl::SchedulerInstance.GetCoreCountImpl();
     }
 }
\ No newline at end of file
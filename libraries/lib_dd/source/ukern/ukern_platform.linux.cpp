@@ -0,0 +1,28 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <dd.hpp>
+
+namespace dd::ukern::impl {
+
+    void SetCurrentThreadProcessor(u32 processor_index) {
+
+        /* Processors outside our cpuset keep the default affinity */
+        cpu_set_t cpu_set;
+        CPU_ZERO(std::addressof(cpu_set));
+        CPU_SET(processor_index, std::addressof(cpu_set));
+        ::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set_t), std::addressof(cpu_set));
+    }
+}
@@ -17,10 +17,13 @@
 
 namespace dd::ukern::impl {
 
-    constinit util::FixedObjectAllocator<FiberLocalStorage, MaxThreadCount> UserFiberLocalAllocator = {};
+    constinit util::ChunkedObjectAllocator<FiberLocalStorage, FiberLocalChunkSize, MaxThreadCount / FiberLocalChunkSize> UserFiberLocalAllocator = {};
 
     TickSpan GetAbsoluteTimeToWakeup(TimeSpan timeout_ns) {
 
+        /* Negative timeouts wait forever, GetTick would return their magnitude */
+        if (timeout_ns.GetNanoSeconds() < 0) { return TimeSpan::MaxTime; }
+
         /* Convert to tick */
         const s64 timeout_tick = timeout_ns.GetTick();
 
@@ -37,125 +40,304 @@ namespace dd::ukern::impl {
 
     NO_RETURN void UserScheduler::SchedulerFiberMain(size_t core_num) {
 
-        /* Label for post dispatch/rest restart */
-        _ukern_scheduler_restart:
-        
         const u32 core_number = core_num;
+        RunQueue *run_queue   = m_run_queue_table + core_number;
 
-        /* Get current time for fibers on a timeout */
-        const u64 tick = util::GetSystemTick();
+        for (;;) {
 
-        /* Visit waiting thread list for timeouts */
-        for (FiberLocalStorage &waiting_fiber : m_wait_list) {
+            /* Sample the runnable counter before looking for work, so a fiber queued during the search can't be missed while resting */
+            const u32 last_runnable_fibers = m_runnable_fibers.load();
 
-            /* Check if the waiter has become schedulable */
-            if (waiting_fiber.IsSchedulable(core_number, tick) == false) { continue; }
+            /* Get current time for fibers on a timeout */
+            const u64 tick = util::GetSystemTick();
 
-            /* Cancel the wait */
-            waiting_fiber.waitable_object->CancelWait(std::addressof(waiting_fiber), ResultTimeout);
-        }
+            /* Cancel timed out waits, the timer heap is only locked once a wait has expired */
+            if (m_next_wakeup_time.load(std::memory_order_relaxed) <= tick) {
+                this->CancelExpiredWaits(tick);
+            }
 
-        /* Run first available thread by priority */
-        for (FiberLocalStorage &runnable_fiber : m_high_priority_list) {
-            if (runnable_fiber.IsSchedulable(core_number, tick) == true) { this->Dispatch(std::addressof(runnable_fiber), core_number); goto _ukern_scheduler_restart; }
-        }
-        for (FiberLocalStorage &runnable_fiber : m_above_normal_priority_list) {
-            if (runnable_fiber.IsSchedulable(core_number, tick) == true) { this->Dispatch(std::addressof(runnable_fiber), core_number); goto _ukern_scheduler_restart; }
-        }
-        for (FiberLocalStorage &runnable_fiber : m_normal_priority_list) {
-            if (runnable_fiber.IsSchedulable(core_number, tick) == true) { this->Dispatch(std::addressof(runnable_fiber), core_number); goto _ukern_scheduler_restart; }
+            /* Track how busy we are for placement and stealing */
+            run_queue->UpdateLoadAverage(tick, m_load_update_period_tick, m_load_window_tick);
+
+            /* Requeue our expired sleepers */
+            CoreWakeBatch wake_batch = {};
+            run_queue->WakeExpiredSleepers(tick, [&](FiberLocalStorage *sleeping_fiber) {
+                m_tracer.Record(SchedulerTraceEventType_Timeout, sleeping_fiber);
+                this->AddToSchedulerUnsafe(sleeping_fiber, std::addressof(wake_batch));
+            });
+            this->WakeCores(wake_batch);
+
+            /* Run the highest priority fiber from our own run queue */
+            FiberLocalStorage *next_fiber = nullptr;
+            if (run_queue->IsEmpty() == false) {
+                ScopedBusyMutex lock(run_queue->GetMutex());
+                next_fiber = run_queue->PopUnsafe(core_number);
+            }
+
+            /* Otherwise try to steal work from another core */
+            if (next_fiber == nullptr) {
+                next_fiber = this->StealFiber(core_number);
+            }
+
+            if (next_fiber != nullptr) {
+                run_queue->SetRunning(true);
+                this->Dispatch(next_fiber, core_number);
+                continue;
+            }
+
+            /* Rest core until a new fiber is schedulable or a timeout expires */
+            run_queue->SetRunning(false);
+            this->RestCore(core_number, last_runnable_fibers);
         }
-        for (FiberLocalStorage &runnable_fiber : m_below_normal_priority_list) {
-            if (runnable_fiber.IsSchedulable(core_number, tick) == true) { this->Dispatch(std::addressof(runnable_fiber), core_number); goto _ukern_scheduler_restart; }
+    }
+
+    void UserScheduler::InitializeStealOrder() {
+
+        /* Order victims by topology distance, starting from our neighbour within a distance to spread out contention */
+        static_assert(MaxCoreCount <= 0x100);
+        for (u32 core_number = 0; core_number < m_core_count; ++core_number) {
+
+            u32 order_count = 0;
+            for (u32 distance = sys::ProcessorDistance_SmtSibling; distance <= sys::ProcessorDistance_Remote; ++distance) {
+                for (u32 i = 1; i < m_core_count; ++i) {
+
+                    u32 victim_core = core_number + i;
+                    if (m_core_count <= victim_core) { victim_core -= m_core_count; }
+
+                    if (sys::ProcessorTopology::GetDistance(m_core_topology_table[core_number], m_core_topology_table[victim_core]) != distance) { continue; }
+
+                    m_steal_order_table[core_number][order_count] = victim_core;
+                    ++order_count;
+                }
+            }
+            DD_ASSERT(order_count == m_core_count - 1);
         }
-        for (FiberLocalStorage &runnable_fiber : m_low_priority_list) {
-            if (runnable_fiber.IsSchedulable(core_number, tick) == true) { this->Dispatch(std::addressof(runnable_fiber), core_number); goto _ukern_scheduler_restart; }
+    }
+
+    FiberLocalStorage *UserScheduler::StealFiber(u32 core_number) {
+
+        /* Visit cores sharing our caches first */
+        const u8 *steal_order = m_steal_order_table[core_number];
+        for (u32 i = 0; i < m_core_count - 1; ++i) {
+
+            const u32 victim_core = steal_order[i];
+
+            /* Skip run queues without migratable fibers without touching their lock */
+            RunQueue *victim_queue = m_run_queue_table + victim_core;
+            if (victim_queue->HasMigratableFibers() == false) { continue; }
+
+            /* Leave a fiber in a foreign cache domain unless it's core is loaded past the migration threshold */
+            if (this->IsSameCacheDomain(core_number, victim_core) == false && victim_queue->GetLoad() < RemoteMigrationImbalance) { continue; }
+
+            /* Take the highest priority fiber allowed to run on this core */
+            ScopedBusyMutex lock(victim_queue->GetMutex());
+            FiberLocalStorage *stolen_fiber = victim_queue->StealUnsafe(core_number);
+            if (stolen_fiber != nullptr) { return stolen_fiber; }
         }
 
-        --m_active_cores;
+        return nullptr;
+    }
+
+    bool UserScheduler::TryDequeueScheduledFiber(FiberLocalStorage *fiber_local) {
 
-        /* If we are the last core, and there are no runnable fibers, then we have deadlocked */
-        if (m_runnable_fibers == 0 && m_active_cores == 0) { 
-            /* Kill process */
-            DD_ASSERT(false);
-        } else if (m_active_cores == 0) {
-            /* Alert another waiting core to check if they can run a fiber */
-            ::WakeByAddressSingle(std::addressof(m_runnable_fibers));
+        /* The fiber may be stolen or dispatched before we hold it's run queue, so revalidate under the queue lock */
+        while (fiber_local->fiber_state == FiberState_Scheduled) {
+
+            const u32 queue_core = fiber_local->current_core;
+            RunQueue *run_queue  = m_run_queue_table + queue_core;
+
+            ScopedBusyMutex lock(run_queue->GetMutex());
+            if (fiber_local->fiber_state != FiberState_Scheduled || fiber_local->current_core != queue_core) { continue; }
+
+            run_queue->RemoveUnsafe(fiber_local);
+
+            return true;
         }
 
-        do {
-            /* Find next wakeup time */
-            u64 timeout_tick = 0xffff'ffff'ffff'ffff;
-            for (FiberLocalStorage &waiting_fiber : m_wait_list) {
-                if ((waiting_fiber.core_mask & (1 << core_number)) != 0  && waiting_fiber.timeout < timeout_tick)  { timeout_tick = waiting_fiber.timeout; }
-            }
-            for (FiberLocalStorage &runnable_fiber : m_high_priority_list) {
-                if ((runnable_fiber.core_mask & (1 << core_number)) != 0 && runnable_fiber.timeout < timeout_tick) { timeout_tick = runnable_fiber.timeout; }
-            }
-            for (FiberLocalStorage &runnable_fiber : m_above_normal_priority_list) {
-                if ((runnable_fiber.core_mask & (1 << core_number)) != 0 && runnable_fiber.timeout < timeout_tick) { timeout_tick = runnable_fiber.timeout; }
-            }
-            for (FiberLocalStorage &runnable_fiber : m_normal_priority_list) {
-                if ((runnable_fiber.core_mask & (1 << core_number)) != 0 && runnable_fiber.timeout < timeout_tick) { timeout_tick = runnable_fiber.timeout; }
-            }
-            for (FiberLocalStorage &runnable_fiber : m_below_normal_priority_list) {
-                if ((runnable_fiber.core_mask & (1 << core_number)) != 0 && runnable_fiber.timeout < timeout_tick) { timeout_tick = runnable_fiber.timeout; }
+        return false;
+    }
+
+    void UserScheduler::CancelExpiredWaits(u64 tick) {
+
+        CoreWakeBatch wake_batch = {};
+        for (;;) {
+
+            /* Find the earliest expired waiter and it's wait bucket */
+            FiberLocalStorage *waiting_fiber = nullptr;
+            WaitAddressBucket *wait_bucket   = nullptr;
+            {
+                ScopedBusyMutex timer_lock(std::addressof(m_wait_timer_mutex));
+                if (m_wait_timer_heap.IsEmpty() == true || tick < m_wait_timer_heap.Top().timeout) { break; }
+
+                waiting_fiber = std::addressof(m_wait_timer_heap.Top());
+                wait_bucket   = waiting_fiber->wait_bucket;
             }
-            for (FiberLocalStorage &runnable_fiber : m_low_priority_list) {
-                if ((runnable_fiber.core_mask & (1 << core_number)) != 0 && runnable_fiber.timeout < timeout_tick) { timeout_tick = runnable_fiber.timeout; }
+
+            /* Buckets are locked before the timer heap, so revalidate as the wait may have ended in between, coroutine wait entries are freed with their frame so check identity first */
+            ScopedWaitBucketLock bucket_lock(wait_bucket);
+            {
+                ScopedBusyMutex timer_lock(std::addressof(m_wait_timer_mutex));
+                if (m_wait_timer_heap.IsEmpty() == true || std::addressof(m_wait_timer_heap.Top()) != waiting_fiber) { continue; }
+                if (waiting_fiber->wait_bucket != wait_bucket || tick < waiting_fiber->timeout)                     { continue; }
+
+                m_wait_timer_heap.Remove(*waiting_fiber);
+                this->UpdateNextWakeupTimeUnsafe();
             }
 
-            /* Release scheduler lock */
-            ::ReleaseSRWLockExclusive(std::addressof(m_scheduler_lock));
+            /* Cancel the wait */
+            waiting_fiber->waitable_object->CancelWait(waiting_fiber, ResultTimeout, std::addressof(wake_batch));
+        }
+
+        /* Wake cores for every expired waiter at once */
+        this->WakeCores(wake_batch);
+    }
 
-            /* Rest core until a new fiber is schedulable, or another rester is looking to sleep */
-            u32 wait_value = m_runnable_fibers;
-            u32 time_left = dd::TimeSpan::GetTimeLeftOnTarget(timeout_tick).GetMilliSeconds();
-            if (time_left == 0) { ::AcquireSRWLockExclusive(std::addressof(m_scheduler_lock)); break; }
+    void UserScheduler::RestCore(u32 core_number, u32 last_runnable_fibers) {
 
-            ::WaitOnAddress(std::addressof(m_runnable_fibers), std::addressof(wait_value), sizeof(u32), time_left);
+        /* Find next wakeup time from our sleepers and timed waiters */
+        u64       timeout_tick = m_next_wakeup_time.load(std::memory_order_relaxed);
+        const u64 sleep_tick   = m_run_queue_table[core_number].GetNextSleepTick();
+        if (sleep_tick < timeout_tick) { timeout_tick = sleep_tick; }
 
-            /* Reacquire scheduler lock */
-            ::AcquireSRWLockExclusive(std::addressof(m_scheduler_lock));
-        } while (m_runnable_fibers == 0);
+        /* Spin before parking, fibers readied and timeouts expiring within the window skip the OS round trip */
+        const u64 tick          = util::GetSystemTick();
+        const u64 spin_end_tick = tick + static_cast<u64>(TimeSpan::FromMicroSeconds(RestSpinTimeUs).GetTick());
+        u32       backoff_count = 1;
+        for (;;) {
+            if (m_runnable_fibers.load(std::memory_order_relaxed) != last_runnable_fibers) { return; }
 
-        ++m_active_cores;
+            const u64 spin_tick = util::GetSystemTick();
+            if (timeout_tick <= spin_tick) { return; }
+            if (spin_end_tick <= spin_tick) { break; }
 
-        /* Attempt to schedule a fiber */
-        goto _ukern_scheduler_restart;
+            for (u32 i = 0; i < backoff_count; ++i) {
+                util::x64::pause();
+            }
+            if (backoff_count < RestSpinMaxBackoffCount) { backoff_count = backoff_count << 1; }
+        }
+
+        /* Park with nanosecond precision until the next timeout */
+        s64 time_left = InfiniteParkTime;
+        if (timeout_tick < static_cast<u64>(TimeSpan::MaxTime)) {
+            const u64 park_tick = util::GetSystemTick();
+            if (timeout_tick <= park_tick) { return; }
+
+            time_left = TimeSpan::FromTick(timeout_tick - park_tick).GetNanoSeconds();
+        }
+
+        /* Rest core until a new fiber is schedulable, publishing the park before the final recheck */
+        CoreParker *core_parker = m_core_parker_table + core_number;
+        m_run_queue_table[core_number].ResetLoadAverage(util::GetSystemTick());
+        m_active_cores.fetch_sub(1);
+        core_parker->PrepareToPark();
+        if (m_runnable_fibers.load() == last_runnable_fibers) {
+            core_parker->Park(time_left);
+        } else {
+            core_parker->CancelPark();
+        }
+        m_active_cores.fetch_add(1);
     }
 
     void UserScheduler::Dispatch(FiberLocalStorage *fiber_local, u32 core_number) {
 
-        /* Set fiber runtime args */
-        fiber_local->fiber_state = FiberState_Running;
-        fiber_local->current_core = core_number;
-        DD_ASSERT(m_core_count > fiber_local->current_core);
-        
-        /* Delist from scheduler */
-        fiber_local->scheduler_list_node.Unlink();
+        /* The fiber was claimed for this core when it was taken from a run queue */
+        DD_ASSERT(fiber_local->fiber_state == FiberState_Running && fiber_local->current_core == core_number);
+
+        m_tracer.Record(SchedulerTraceEventType_Dispatch, fiber_local);
+
+        /* Deadline fibers are charged for the time they run */
+        if (fiber_local->relative_deadline_tick != 0) {
+            fiber_local->dispatch_tick = util::GetSystemTick();
+        }
 
         /* Switch to user fiber */
-        ::SwitchToFiber(fiber_local->win32_fiber_handle);
+        SwitchToFiberContext(fiber_local->fiber_context);
 
         DD_ASSERT(core_number == fiber_local->current_core);
 
         /* Handle previous fiber */
+        this->FinishSwitchOut(fiber_local);
+
+        return;
+    }
+
+    void UserScheduler::ChargeDeadlineJob(FiberLocalStorage *fiber_local) {
+
+        if (fiber_local->is_deadline_job_active == false) { return; }
+
+        /* Charge the budget, an overrun job falls back to it's static priority */
+        const u64  tick       = util::GetSystemTick();
+        const bool had_budget = 0 < fiber_local->deadline_budget_left;
+        fiber_local->deadline_budget_left -= static_cast<s64>(tick - fiber_local->dispatch_tick);
+        if (had_budget == true && fiber_local->deadline_budget_left <= 0) {
+            ++fiber_local->deadline_overrun_count;
+        }
+
+        /* The job completes once the fiber stops running */
+        if (fiber_local->fiber_state == FiberState_Running) { return; }
+
+        fiber_local->is_deadline_job_active = false;
+        ++fiber_local->deadline_job_count;
+        if (fiber_local->absolute_deadline < tick) {
+            ++fiber_local->deadline_miss_count;
+        }
+    }
+
+    void UserScheduler::FinishSwitchOut(FiberLocalStorage *fiber_local) {
+
+        /* Account deadline jobs before the fiber can be woken elsewhere */
+        if (fiber_local->relative_deadline_tick != 0) {
+            this->ChargeDeadlineJob(fiber_local);
+        }
+
         switch (fiber_local->fiber_state) {
             case FiberState_Running:
+                m_tracer.Record(SchedulerTraceEventType_Preempt, fiber_local);
+
                 /* Readd the fiber to the scheduler */
                 this->AddToSchedulerUnsafe(fiber_local);
 
+                break;
+            case FiberState_Sleeping:
+                /* Sleepers register with our core's timer heap before switching out */
+                m_tracer.Record(SchedulerTraceEventType_Wait, fiber_local);
                 break;
             case FiberState_Exiting:
-                /* Delete Win32 fiber */
-                ::DeleteFiber(fiber_local->win32_fiber_handle);
+                {
+                    m_tracer.Record(SchedulerTraceEventType_Exit, fiber_local);
+
+                    /* Hold the join bucket while releasing the handle, so a joiner either sees the exit or is woken by it */
+                    u32               *join_address = fiber_local->GetJoinAddress();
+                    WaitAddressBucket *join_bucket  = m_wait_address_table.GetBucket(join_address);
+                    ScopedWaitBucketLock bucket_lock(join_bucket);
+                    {
+                        /* Lock scheduler for the handle table and fiber allocator */
+                        ScopedSchedulerLock lock(this);
+
+                        /* Release the handle so joiners can observe the exit */
+                        m_handle_table.FreeHandle(fiber_local->ukern_fiber_handle);
+
+                        /* The fiber is switched out, so it's stack can be recycled */
+                        m_fiber_stack_pool.Free(fiber_local->fiber_context);
 
-                /* Free fiber local */
-                UserFiberLocalAllocator.Free(fiber_local);
+                        /* Free fiber local */
+                        UserFiberLocalAllocator.Free(fiber_local);
+                    }
 
+                    /* Release joiners, the storage stays mapped so it's address remains a valid wait key */
+                    this->WakeAddressWaitersUnsafe(join_bucket, join_address, 0xffff'ffff);
+                }
                 break;
             case FiberState_Waiting:
+                m_tracer.Record(SchedulerTraceEventType_Wait, fiber_local);
+
+                /* Release the lock handed off by the now switched out waiter, address waiters hand off their wait bucket */
+                if (fiber_local->wait_bucket != nullptr) {
+                    fiber_local->wait_bucket->GetMutex()->Leave();
+                } else {
+                    m_scheduler_lock.Leave();
+                }
+
                 break;
             default:
                 DD_ASSERT(false);
@@ -164,40 +346,58 @@ namespace dd::ukern::impl {
         return;
     }
 
-	void UserScheduler::Initialize(UKernCoreMask core_mask) {
+	void UserScheduler::Initialize(const UKernCoreMask &processor_mask, const sys::ProcessorTopology &processor_topology) {
 
 		/* Get and set initial core count */
-		const u32 core_count = util::CountOneBits64(core_mask);
+		const u32 core_count = processor_mask.Count();
+        DD_ASSERT(core_count != 0);
 		m_active_cores = core_count;
 		m_core_count   = core_count;
-        m_core_mask    = core_mask;
+        m_core_mask    = UKernCoreMask::MakeLowBits(core_count);
+
+        /* Core n runs on the n'th processor of the mask, processors may span groups or be sparse */
+        u32 processor_index = processor_mask.FindFirstSet();
+        for (u32 i = 0; i < core_count; ++i) {
+            m_core_processor_table[i] = processor_index;
+            m_core_topology_table[i]  = processor_topology.GetProcessorInfo(processor_index);
+            processor_index           = processor_mask.FindNextSet(processor_index);
+        }
+        this->InitializeStealOrder();
+
+        /* Load averaging windows depend on the tick frequency */
+        m_load_window_tick        = TimeSpan::FromMicroSeconds(LoadAverageWindowUs).GetTick();
+        m_load_update_period_tick = TimeSpan::FromMicroSeconds(LoadUpdatePeriodUs).GetTick();
 
-		/* Set main thread core mask to core 0 */
-		const u64 main_thread_mask = 1;
-		::SetThreadAffinityMask(::GetCurrentThread(), main_thread_mask);
-        
         /* Initialize handle table */
         m_handle_table.Initialize();
 
-		/* Set main thread handle */
-		HANDLE main_thread_handle = nullptr;
-		const bool result0 = ::DuplicateHandle(::GetCurrentProcess(), ::GetCurrentThread(), ::GetCurrentProcess(), std::addressof(main_thread_handle), 0, false, DUPLICATE_SAME_ACCESS);
-        DD_ASSERT(result0 == true);
-		m_scheduler_thread_table[0] = main_thread_handle;
+        /* Initialize core parkers before any core may rest */
+        for (u32 i = 0; i < core_count; ++i) {
+            m_core_parker_table[i].Initialize();
+        }
+
+		/* Set main thread handle, pinning it to core 0 */
+        SchedulerTracer::SetCurrentCoreNumber(0);
+		m_scheduler_thread_table[0] = OpenCurrentCoreThread(m_core_processor_table[0]);
 
 		/* Setup main thread fiber local */
 		FiberLocalStorage *main_fiber_local = UserFiberLocalAllocator.Allocate();
 
 		main_fiber_local->priority           = 2;
+		main_fiber_local->base_priority      = 2;
 		main_fiber_local->current_core       = 0;
-		main_fiber_local->core_mask          = 1;
+		main_fiber_local->SetCoreMaskUnsafe(1);
 		main_fiber_local->fiber_state        = FiberState_Running;
 		main_fiber_local->activity_level     = ActivityLevel_Schedulable;
-        main_fiber_local->win32_fiber_handle = ::ConvertThreadToFiber(main_fiber_local);
-        DD_ASSERT(main_fiber_local->win32_fiber_handle != nullptr);
+		main_fiber_local->relative_deadline_tick = 0;
+		main_fiber_local->is_deadline_job_active = false;
+        ::memset(main_fiber_local->fiber_local_slot_array, 0, sizeof(main_fiber_local->fiber_local_slot_array));
+        main_fiber_local->fiber_context      = ConvertThreadToFiberContext(main_fiber_local);
+        DD_ASSERT(main_fiber_local->fiber_context != nullptr);
+        m_run_queue_table[0].SetRunning(true);
 
         /* Create main thread scheduler fiber */
-		m_scheduler_fiber_table[0] = ::CreateFiber(0x2000, InternalSchedulerMainThreadFiberMain, main_fiber_local);
+		m_scheduler_fiber_table[0] = CreateFiberContext(0x2000, InternalSchedulerMainThreadFiberMain, main_fiber_local);
         DD_ASSERT(m_scheduler_fiber_table[0] != nullptr);
 
         /* Reserve main thread */
@@ -208,12 +408,7 @@ namespace dd::ukern::impl {
 
 		/* Allocate scheduler worker fibers */
 		for (u32 i = 1; i < core_count; ++i) {
-			m_scheduler_thread_table[i] = ::CreateThread(nullptr, 0x1000, InternalSchedulerFiberMain, reinterpret_cast<void*>(i), CREATE_SUSPENDED, nullptr);
-			DD_ASSERT(m_scheduler_thread_table[i] != INVALID_HANDLE_VALUE);
-
-            u64 secondary_mask = (1 << i);
-			::SetThreadAffinityMask(m_scheduler_thread_table[i], secondary_mask);
-			::ResumeThread(m_scheduler_thread_table[i]);
+			m_scheduler_thread_table[i] = CreateCoreThread<InternalSchedulerFiberMain>(i, m_core_processor_table[i]);
 		}
 
 		return;
@@ -223,6 +418,36 @@ namespace dd::ukern::impl {
         return reinterpret_cast<FiberLocalStorage*>(m_handle_table.GetObjectByHandle(handle));
     }
 
+    void UserScheduler::UpdateInheritedPriorityUnsafe(FiberLocalStorage *fiber_local) {
+
+        /* Walk up the chain of lock owners while the inherited priority changes */
+        while (fiber_local != nullptr) {
+
+            const s32 new_priority = fiber_local->GetInheritedPriorityUnsafe();
+            if (new_priority == fiber_local->priority) { return; }
+
+            fiber_local->priority = new_priority;
+
+            /* Requeue at the new level, running fibers pick it up when next requeued */
+            if (this->TryDequeueScheduledFiber(fiber_local) == true) {
+                this->AddToSchedulerUnsafe(fiber_local);
+                return;
+            }
+
+            /* Only lock waiters pass their priority on */
+            if (fiber_local->lock_address == nullptr || fiber_local->wait_list_node.IsLinked() == false) { return; }
+
+            FiberLocalStorage *owner_fiber = this->GetFiberByHandle((*fiber_local->lock_address) & (~FiberLocalStorage::HasChildWaitersBit));
+            if (owner_fiber == nullptr) { return; }
+
+            /* Reorder ourselves in the owner's waiters */
+            fiber_local->wait_list_node.Unlink();
+            owner_fiber->AddLockWaiterUnsafe(fiber_local);
+
+            fiber_local = owner_fiber;
+        }
+    }
+
     /* Service api */
     Result UserScheduler::CreateThreadImpl(UKernHandle *out_handle, ThreadFunction thread_func, uintptr_t arg, size_t stack_size, s32 priority, u32 core_id) {
 
@@ -230,7 +455,7 @@ namespace dd::ukern::impl {
         RESULT_RETURN_UNLESS(thread_func != nullptr,              ResultInvalidThreadFunctionPointer);
         RESULT_RETURN_UNLESS(stack_size  != 0,                    ResultInvalidStackSize);
         RESULT_RETURN_UNLESS(-2 <= priority && priority <= 2,     ResultInvalidPriority);
-        RESULT_RETURN_UNLESS(((1 << core_id) & m_core_mask) != 0, ResultInvalidCoreId);
+        RESULT_RETURN_UNLESS(m_core_mask.IsSet(core_id) == true,  ResultInvalidCoreId);
 
         /* Lock the scheduler */
         ScopedSchedulerLock lock(this);
@@ -245,21 +470,35 @@ namespace dd::ukern::impl {
 
         /* Set fiber args */
         fiber_local->priority       = priority + WindowsToUKernPriorityOffset;
+        fiber_local->base_priority  = priority + WindowsToUKernPriorityOffset;
         fiber_local->stack_size     = stack_size;
-        fiber_local->core_mask      = (1 << core_id);
-        fiber_local->user_arg       = reinterpret_cast<void*>(arg);
-        fiber_local->user_function  = thread_func;
-        fiber_local->fiber_state    = FiberState_Suspended;
-        fiber_local->activity_level = ActivityLevel_Suspended;
+        fiber_local->SetCoreMaskUnsafe(UKernCoreMask::MakeBit(core_id));
+        fiber_local->current_core    = core_id;
+        fiber_local->user_arg        = reinterpret_cast<void*>(arg);
+        ::memset(fiber_local->fiber_local_slot_array, 0, sizeof(fiber_local->fiber_local_slot_array));
+        fiber_local->user_function   = thread_func;
+        fiber_local->waitable_object = nullptr;
+        fiber_local->wait_bucket     = nullptr;
+        fiber_local->timeout         = 0;
+        fiber_local->fiber_state     = FiberState_Suspended;
+        fiber_local->relative_deadline_tick = 0;
+        fiber_local->deadline_budget_tick   = 0;
+        fiber_local->deadline_job_count     = 0;
+        fiber_local->deadline_miss_count    = 0;
+        fiber_local->deadline_overrun_count = 0;
+        fiber_local->is_deadline_job_active = false;
+        fiber_local->activity_level  = ActivityLevel_Suspended;
 
         this->SetInitialFiberNameUnsafe(fiber_local);
 
-        /* Create win32 fiber */
-        fiber_local->win32_fiber_handle = ::CreateFiber(stack_size, UserFiberMain, fiber_local);
-        DD_ASSERT(fiber_local->win32_fiber_handle != nullptr);
+        /* Take a fiber context from the stack pool */
+        fiber_local->fiber_context = m_fiber_stack_pool.Allocate(stack_size, UserFiberMain, fiber_local);
+        DD_ASSERT(fiber_local->fiber_context != nullptr);
 
         /* Add to suspend list */
+        m_suspend_lock.Enter();
         m_suspended_list.PushBack(*fiber_local);
+        m_suspend_lock.Leave();
 
         *out_handle = fiber_local->ukern_fiber_handle;
 
@@ -271,30 +510,73 @@ namespace dd::ukern::impl {
         /* Get current fiber */
         FiberLocalStorage *fiber_local = this->GetCurrentThreadImpl();
 
-        /* Acquire scheduler lock */
-        ::AcquireSRWLockExclusive(std::addressof(m_scheduler_lock));
-
         /* Set state */
         fiber_local->fiber_state = FiberState_Exiting;
 
-        /* Swap to scheduler */
-        ::SwitchToFiber(this->GetSchedulerFiber(fiber_local));
+        /* Swap to scheduler, our scheduler core will free the fiber once we are switched out */
+        SwitchToFiberContext(this->GetSchedulerFiber(fiber_local));
     }
 
     void UserScheduler::ExitThreadImpl(UKernHandle handle) {
+        this->JoinThreadImpl(handle, TimeSpan::MaxTime);
+    }
+
+    Result UserScheduler::JoinThreadImpl(UKernHandle handle, s64 absolute_timeout) {
+
+        /* Get current fiber */
+        FiberLocalStorage *current_fiber = this->GetCurrentThreadImpl();
+
+        /* Nothing to join if the fiber already exited */
         FiberLocalStorage *exit_fiber = this->GetFiberByHandle(handle);
+        if (exit_fiber == nullptr) { return ResultSuccess; }
+        RESULT_RETURN_IF(exit_fiber == current_fiber, ResultInvalidHandle);
+
+        /* Lock the exiting fiber's join bucket */
+        u32               *join_address = exit_fiber->GetJoinAddress();
+        WaitAddressBucket *wait_bucket  = m_wait_address_table.GetBucket(join_address);
+        ScopedWaitBucketLock bucket_lock(wait_bucket);
+
+        /* The handle is released under the join bucket lock, so revalidate now that we hold it */
+        if (this->GetFiberByHandle(handle) != exit_fiber) { return ResultSuccess; }
+        RESULT_RETURN_IF(absolute_timeout <= 0, ResultTimeout);
+
+        /* Set join wait state */
+        WaitAddressArbiter wait_address_arbiter = {};
+        current_fiber->waitable_object = std::addressof(wait_address_arbiter);
+        current_fiber->wait_bucket     = wait_bucket;
+        current_fiber->wait_address    = join_address;
+        current_fiber->fiber_state     = FiberState_Waiting;
+        current_fiber->timeout         = absolute_timeout;
+
+        /* Wait in the join bucket until the exiting core releases us */
+        wait_bucket->PushBackUnsafe(current_fiber);
+        this->RegisterWaitTimer(current_fiber);
+
+        /* Swap to scheduler */
+        bucket_lock.HandOffToScheduler();
+        SwitchToFiberContext(this->GetSchedulerFiber(current_fiber));
+
+        return current_fiber->last_result;
+    }
+
+    Result UserScheduler::JoinThreadsImpl(const UKernHandle *handle_array, u32 handle_count, s64 absolute_timeout) {
+
+        /* Integrity checks */
+        RESULT_RETURN_IF(handle_array == nullptr && handle_count != 0, ResultInvalidAddress);
 
-        /* Sleep loop while handle is valid */
-        while (exit_fiber != nullptr) {
-            this->SleepThreadImpl(0);
-            exit_fiber = this->GetFiberByHandle(handle);
+        /* A fiber waits in one bucket at a time, so join in order against the shared deadline */
+        for (u32 i = 0; i < handle_count; ++i) {
+            const Result join_result = this->JoinThreadImpl(handle_array[i], absolute_timeout);
+            RESULT_RETURN_IF(join_result != ResultSuccess, join_result);
         }
+
+        return ResultSuccess;
     }
 
     Result UserScheduler::SetPriorityImpl(UKernHandle handle, s32 priority) {
     
         /* Verify input */
-        if (-2 <= priority && priority <= 2) { return ResultInvalidPriority; }
+        RESULT_RETURN_UNLESS(-2 <= priority && priority <= 2, ResultInvalidPriority);
         
         /* Get fiber by handle  */
         FiberLocalStorage *fiber_local = this->GetFiberByHandle(handle);
@@ -304,22 +586,24 @@ namespace dd::ukern::impl {
         ScopedSchedulerLock lock(this);
         
         /* Same value check */
-        if (fiber_local->priority == priority) { return ResultSamePriority; }
+        const s32 ukern_priority = priority + WindowsToUKernPriorityOffset;
+        if (fiber_local->base_priority == ukern_priority) { return ResultSamePriority; }
 
-        /* Change priority */
-        fiber_local->priority = priority;
+        /* Change base priority, an inherited priority from our lock waiters may still dominate */
+        fiber_local->base_priority = ukern_priority;
 
-        /* Reschedule if necessary */
-        if (fiber_local->fiber_state == FiberState_Scheduled) {
-            fiber_local->scheduler_list_node.Unlink();
-            this->AddToSchedulerUnsafe(fiber_local);
-        }
+        /* Requeue and pass the change to lock owners if necessary */
+        this->UpdateInheritedPriorityUnsafe(fiber_local);
 
         return ResultSuccess;
     }
 
-    Result UserScheduler::SetCoreMaskImpl(UKernHandle handle, UKernCoreMask core_mask) {
+    Result UserScheduler::SetCoreMaskImpl(UKernHandle handle, const UKernCoreMask &core_mask) {
         
+        /* Integrity checks, cores past our core count are dropped */
+        const UKernCoreMask allowed_core_mask = core_mask & m_core_mask;
+        RESULT_RETURN_UNLESS(allowed_core_mask.IsEmpty() == false, ResultInvalidCoreId);
+
         /* Get fiber by handle  */
         FiberLocalStorage *fiber_local = this->GetFiberByHandle(handle);
         RESULT_RETURN_UNLESS(fiber_local != nullptr, ResultInvalidHandle);
@@ -328,14 +612,13 @@ namespace dd::ukern::impl {
         ScopedSchedulerLock lock(this);
         
         /* Same value check */
-        if (fiber_local->core_mask == core_mask) { return ResultSameCoreMask; }
+        if (fiber_local->core_mask == allowed_core_mask) { return ResultSameCoreMask; }
         
         /* Change core mask */
-        fiber_local->core_mask = core_mask;
+        fiber_local->SetCoreMaskUnsafe(allowed_core_mask);
 
-        /* Reschedule if necessary */
-        if (fiber_local->fiber_state == FiberState_Scheduled) {
-            fiber_local->scheduler_list_node.Unlink();
+        /* Migrate to an allowed core's run queue if necessary, running fibers migrate when next requeued */
+        if (this->TryDequeueScheduledFiber(fiber_local) == true) {
             this->AddToSchedulerUnsafe(fiber_local);
         }
         
@@ -356,36 +639,152 @@ namespace dd::ukern::impl {
         /* Same value check */
         RESULT_RETURN_IF(fiber_local->activity_level == activity_level, ResultSameActivityLevel);
 
+        /* Lock suspend list */
+        m_suspend_lock.Enter();
+
         fiber_local->activity_level = static_cast<ActivityLevel>(activity_level);
 
-        /* Reschedule if necessary */
-        if (fiber_local->fiber_state == FiberState_Scheduled || fiber_local->fiber_state == FiberState_Suspended) {
-            fiber_local->scheduler_list_node.Unlink();
+        /* Reschedule if necessary, running and waiting fibers are handled when they are next requeued */
+        bool is_resumed = false;
+        if (activity_level == ActivityLevel_Schedulable && fiber_local->fiber_state == FiberState_Suspended) {
+            m_suspended_list.Remove(*fiber_local);
+            is_resumed = true;
+        } else if (activity_level == ActivityLevel_Suspended && this->TryDequeueScheduledFiber(fiber_local) == true) {
+            fiber_local->fiber_state = FiberState_Suspended;
+            m_suspended_list.PushBack(*fiber_local);
+        }
+
+        m_suspend_lock.Leave();
+
+        if (is_resumed == true) {
+            this->AddToSchedulerUnsafe(fiber_local);
+        }
+
+        return ResultSuccess;
+    }
+
+    Result UserScheduler::SetDeadlineImpl(UKernHandle handle, s64 relative_deadline_tick, s64 budget_tick) {
+
+        /* Verify input, a zero deadline returns the fiber to it's static priority */
+        RESULT_RETURN_UNLESS(0 <= relative_deadline_tick, ResultInvalidDeadline);
+        RESULT_RETURN_UNLESS(relative_deadline_tick == 0 || (0 < budget_tick && budget_tick <= relative_deadline_tick), ResultInvalidDeadline);
+
+        /* Get fiber by handle */
+        FiberLocalStorage *fiber_local = this->GetFiberByHandle(handle);
+        RESULT_RETURN_UNLESS(fiber_local != nullptr, ResultInvalidHandle);
+
+        /* Lock scheduler */
+        ScopedSchedulerLock lock(this);
+
+        /* Change deadline class, the next job is released when the fiber is next queued */
+        fiber_local->relative_deadline_tick = relative_deadline_tick;
+        fiber_local->deadline_budget_tick   = (relative_deadline_tick == 0) ? 0 : budget_tick;
+        fiber_local->is_deadline_job_active = false;
+
+        /* Requeue between the deadline heap and priority lists if necessary */
+        if (this->TryDequeueScheduledFiber(fiber_local) == true) {
             this->AddToSchedulerUnsafe(fiber_local);
         }
 
         return ResultSuccess;
     }
 
+    Result UserScheduler::GetDeadlineStatisticsImpl(ThreadDeadlineStatistics *out_statistics, UKernHandle handle) {
+
+        /* Integrity checks */
+        RESULT_RETURN_UNLESS(out_statistics != nullptr, ResultInvalidAddress);
+
+        /* Get fiber by handle */
+        FiberLocalStorage *fiber_local = this->GetFiberByHandle(handle);
+        RESULT_RETURN_UNLESS(fiber_local != nullptr, ResultInvalidHandle);
+
+        /* Counters are only written by the fiber's scheduler core, a snapshot may be a job behind */
+        out_statistics->job_count     = std::atomic_ref<u32>(fiber_local->deadline_job_count).load(std::memory_order_relaxed);
+        out_statistics->miss_count    = std::atomic_ref<u32>(fiber_local->deadline_miss_count).load(std::memory_order_relaxed);
+        out_statistics->overrun_count = std::atomic_ref<u32>(fiber_local->deadline_overrun_count).load(std::memory_order_relaxed);
+
+        return ResultSuccess;
+    }
+
+    Result UserScheduler::AllocateFiberLocalSlotImpl(u32 *out_slot) {
+
+        /* Integrity checks */
+        RESULT_RETURN_UNLESS(out_slot != nullptr, ResultInvalidAddress);
+
+        /* Lock scheduler so no fiber is created while the slot is cleared */
+        ScopedSchedulerLock lock(this);
+
+        /* Take the lowest free slot */
+        const u32 free_slot_mask = ~m_fiber_local_slot_mask & ((1u << MaxFiberLocalSlotCount) - 1);
+        RESULT_RETURN_IF(free_slot_mask == 0, ResultFiberLocalSlotExhaustion);
+
+        const u32 slot = util::CountRightZeroBits32(free_slot_mask);
+        m_fiber_local_slot_mask |= (1u << slot);
+
+        /* Clear any value left behind by the slot's last owner */
+        m_handle_table.ForEachObject([slot](void *object) {
+            reinterpret_cast<FiberLocalStorage*>(object)->fiber_local_slot_array[slot] = nullptr;
+        });
+
+        *out_slot = slot;
+
+        return ResultSuccess;
+    }
+
+    Result UserScheduler::FreeFiberLocalSlotImpl(u32 slot) {
+
+        /* Lock scheduler */
+        ScopedSchedulerLock lock(this);
+
+        /* Integrity checks */
+        RESULT_RETURN_UNLESS(slot < MaxFiberLocalSlotCount && (m_fiber_local_slot_mask & (1u << slot)) != 0, ResultInvalidFiberLocalSlot);
+
+        m_fiber_local_slot_mask &= ~(1u << slot);
+
+        return ResultSuccess;
+    }
+
     void UserScheduler::SleepThreadImpl(u64 absolute_timeout) {
 
         /* Get current fiber */
         FiberLocalStorage *current_fiber = this->GetCurrentThreadImpl();
 
-        ScopedSchedulerLock lock(this);
-
-        /* Only set timeout if required */
+        /* Only set timeout if required, sleepers are kept off the run queues until they expire */
         if (absolute_timeout != 0) {
             /* Set timeout */
-            current_fiber->timeout = absolute_timeout;
+            current_fiber->timeout     = absolute_timeout;
+            current_fiber->fiber_state = FiberState_Sleeping;
+
+            /* Park on our core's timer heap, only our core's scheduler fiber pops it once we are switched out */
+            m_run_queue_table[current_fiber->current_core].PushSleeper(current_fiber);
         }
 
-        /* Switch to scheduler */
-        ::SwitchToFiber(this->GetSchedulerFiber(current_fiber));
+        /* Switch to scheduler, our scheduler core requeues us once we are switched out */
+        SwitchToFiberContext(this->GetSchedulerFiber(current_fiber));
 
         return;
     }
 
+    void UserScheduler::YieldThreadImpl() {
+
+        /* Get current fiber */
+        FiberLocalStorage *current_fiber = this->GetCurrentThreadImpl();
+        const u32          current_core  = current_fiber->current_core;
+        RunQueue          *run_queue     = m_run_queue_table + current_core;
+
+        /* Skip the scheduler when it would only redispatch us, a competitor missed by the lockless hints is seen on the next yield */
+        const u64  tick         = util::GetSystemTick();
+        const bool is_contended = run_queue->HasReadyFibersAtOrAbove(current_fiber->priority) == true
+                               || run_queue->GetNextSleepTick() <= tick
+                               || m_next_wakeup_time.load(std::memory_order_relaxed) <= tick
+                               || current_fiber->activity_level != ActivityLevel_Schedulable
+                               || current_fiber->core_mask.IsSet(current_core) == false;
+        if (is_contended == false) { return; }
+
+        /* Requeue behind our competitors */
+        this->SleepThreadImpl(0);
+    }
+
     Result UserScheduler::ArbitrateLockImpl(UKernHandle handle, u32 *lock_address, u32 tag) {
 
         /* Integrity checks */
@@ -408,19 +807,18 @@ namespace dd::ukern::impl {
         /* Set lock state */
         LockArbiter lock_arbiter = {};
         current_fiber->waitable_object = std::addressof(lock_arbiter);
+        current_fiber->wait_bucket     = nullptr;
         current_fiber->lock_address    = lock_address;
         current_fiber->wait_tag        = tag;
         current_fiber->fiber_state     = FiberState_Waiting;
 
-        /* Push back thread waiter */
-        handle_fiber->wait_list.PushBack(*current_fiber);
-
-        /* Swap fiber to suspend list */
-        current_fiber->scheduler_list_node.Unlink();
-        m_suspended_list.PushBack(*current_fiber);
+        /* Add waiter in priority order and lend our priority to the owner */
+        handle_fiber->AddLockWaiterUnsafe(current_fiber);
+        this->UpdateInheritedPriorityUnsafe(handle_fiber);
 
         /* Swap to scheduler */
-        ::SwitchToFiber(this->GetSchedulerFiber(current_fiber));
+        lock.HandOffToScheduler();
+        SwitchToFiberContext(this->GetSchedulerFiber(current_fiber));
 
         return current_fiber->last_result;
     }
@@ -437,11 +835,10 @@ namespace dd::ukern::impl {
         ScopedSchedulerLock lock(this);
 
         /* Integrity checks */
-        RESULT_RETURN_UNLESS(current_fiber->wait_list.IsEmpty() == false,                                                       ResultRequiresLock);
         RESULT_RETURN_UNLESS(current_fiber->ukern_fiber_handle == ((*lock_address) & (~FiberLocalStorage::HasChildWaitersBit)), ResultInvalidLockAddressValue);
 
         /* Release lock */
-        current_fiber->ReleaseLockWaitListUnsafe();
+        current_fiber->ReleaseLockWaitListUnsafe(lock_address);
 
         return ResultSuccess;
     }
@@ -455,78 +852,81 @@ namespace dd::ukern::impl {
         /* Get current fiber */
         FiberLocalStorage *current_fiber = this->GetCurrentThreadImpl();
 
-        /* Lock scheduler */
-        ScopedSchedulerLock lock(this);
+        /* Lock the cv key's wait bucket */
+        WaitAddressBucket *wait_bucket = m_wait_address_table.GetBucket(cv_key);
+        ScopedWaitBucketLock bucket_lock(wait_bucket);
+        {
+            /* Lock scheduler */
+            ScopedSchedulerLock lock(this);
 
-        /* Integrity checks */
-        RESULT_RETURN_UNLESS(current_fiber->wait_list.IsEmpty() == false,   ResultRequiresLock);
-        RESULT_RETURN_UNLESS(current_fiber->ukern_fiber_handle == *lock_address, ResultInvalidLockAddressValue);
+            /* Integrity checks */
+            RESULT_RETURN_UNLESS(current_fiber->ukern_fiber_handle == ((*lock_address) & (~FiberLocalStorage::HasChildWaitersBit)), ResultInvalidLockAddressValue);
 
-        /* Release lock */
-        current_fiber->ReleaseLockWaitListUnsafe();
+            /* Set cv key to 1 before releasing the lock, so a signaller holding the lock after us sees our wait */
+            *cv_key = 1;
 
-        /* Set cv key to 1 */
-        *cv_key = 1;
+            /* Release lock */
+            current_fiber->ReleaseLockWaitListUnsafe(lock_address);
+        }
 
         /* Check if timed out */
-        u32 result = ResultSuccess;
-        if (0 == absolute_timeout) {
-            result = ResultTimeout;
-        } else {
-            /* Set wait state */
-            KeyArbiter key_arbiter         = {};
-            current_fiber->waitable_object = std::addressof(key_arbiter);
-            current_fiber->wait_address    = cv_key;
-            current_fiber->lock_address    = lock_address;
-            current_fiber->wait_tag        = tag;
-            current_fiber->fiber_state     = FiberState_Waiting;
-            current_fiber->timeout         = absolute_timeout;
-        }
+        RESULT_RETURN_IF(0 == absolute_timeout, ResultTimeout);
 
-        /* Find a parent cv waiter */
-        for (FiberLocalStorage &waiting_fiber : m_wait_list) {
-            if (waiting_fiber.wait_address == cv_key) {
-                waiting_fiber.wait_list.PushBack(*current_fiber);
-                break;
-            }
-        }
+        /* Set wait state */
+        KeyArbiter key_arbiter         = {};
+        current_fiber->waitable_object = std::addressof(key_arbiter);
+        current_fiber->wait_bucket     = wait_bucket;
+        current_fiber->wait_address    = cv_key;
+        current_fiber->lock_address    = lock_address;
+        current_fiber->wait_tag        = tag;
+        current_fiber->fiber_state     = FiberState_Waiting;
+        current_fiber->timeout         = absolute_timeout;
 
-        /* If no parent, become the parent */
-        if (current_fiber->wait_list_node.IsLinked() == true) {
-            current_fiber->scheduler_list_node.Unlink();
-            m_wait_list.PushBack(*current_fiber);
-        }
+        /* Wait in the cv key's bucket */
+        wait_bucket->PushBackUnsafe(current_fiber);
+        this->RegisterWaitTimer(current_fiber);
 
         /* Swap to scheduler */
-        ::SwitchToFiber(this->GetSchedulerFiber(current_fiber));
-
-        if (result == ResultSuccess) {
-            result = current_fiber->last_result;
-        }
+        bucket_lock.HandOffToScheduler();
+        SwitchToFiberContext(this->GetSchedulerFiber(current_fiber));
 
-        return result;
+        return current_fiber->last_result;
     }
 
-    void UserScheduler::SwapLockForSignalKey(FiberLocalStorage *waiting_fiber) {
+    void UserScheduler::ReacquireKeyLock(FiberLocalStorage *waiting_fiber, CoreWakeBatch *wake_batch) {
+
+        std::atomic_ref<u32> lock_tag(*waiting_fiber->lock_address);
 
-        /* Try to take the lock back */
-        const u32 prev_tag = *waiting_fiber->lock_address;
-        u32       tag      =  waiting_fiber->wait_tag;
-        if (prev_tag != 0) {
-            tag |= FiberLocalStorage::HasChildWaitersBit;
+        /* Take the lock directly if it's free */
+        u32 prev_tag = 0;
+        if (lock_tag.compare_exchange_strong(prev_tag, waiting_fiber->wait_tag) == true) {
+            waiting_fiber->waitable_object->EndWait(waiting_fiber, ResultSuccess, wake_batch);
+            return;
         }
-        *waiting_fiber->lock_address = tag;
 
-        /* If there were other waiters */
-        if (prev_tag != 0) {
-            /* Get fiber by handle */
-            FiberLocalStorage *lock_fiber = this->GetFiberByHandle(~FiberLocalStorage::HasChildWaitersBit);
+        /* Otherwise lock scheduler, so the owner can't unlock without seeing us */
+        ScopedSchedulerLock lock(this);
 
-            /* Push back fiber waiter */
-            lock_fiber->wait_list.PushBack(*waiting_fiber);
-        } else {
-            waiting_fiber->waitable_object->EndWait(waiting_fiber, ResultSuccess);
+        /* Tag the lock as having waiters, or take it if the owner released it */
+        prev_tag = lock_tag.load();
+        for (;;) {
+            if (prev_tag == 0) {
+                if (lock_tag.compare_exchange_weak(prev_tag, waiting_fiber->wait_tag) == true) {
+                    waiting_fiber->waitable_object->EndWait(waiting_fiber, ResultSuccess, wake_batch);
+                    return;
+                }
+                continue;
+            }
+            if (lock_tag.compare_exchange_weak(prev_tag, prev_tag | FiberLocalStorage::HasChildWaitersBit) == true) { break; }
         }
+
+        /* Get fiber by handle */
+        FiberLocalStorage *lock_fiber = this->GetFiberByHandle(prev_tag & (~FiberLocalStorage::HasChildWaitersBit));
+        DD_ASSERT(lock_fiber != nullptr);
+
+        /* Add waiter in priority order, the wait ends when the lock is handed to us */
+        lock_fiber->AddLockWaiterUnsafe(waiting_fiber);
+        this->UpdateInheritedPriorityUnsafe(lock_fiber);
     }
 
     Result UserScheduler::SignalKeyImpl(u32 *cv_key, u32 signal_count) {
@@ -534,8 +934,9 @@ namespace dd::ukern::impl {
         /* Integrity checks */
         RESULT_RETURN_IF(cv_key == nullptr, ResultInvalidAddress);
 
-        /* Lock scheduler */
-        ScopedSchedulerLock lock(this);
+        /* Lock the cv key's wait bucket */
+        WaitAddressBucket *wait_bucket = m_wait_address_table.GetBucket(cv_key);
+        ScopedWaitBucketLock bucket_lock(wait_bucket);
 
         /* Zero signal count */
         if (signal_count == 0) {
@@ -545,56 +946,29 @@ namespace dd::ukern::impl {
             return ResultSuccess;
         }
 
-        /* Find parent waiter */
-        FiberLocalStorage *cv_fiber = nullptr;
-        for (FiberLocalStorage &fiber_local : m_wait_list) {
-            if (fiber_local.wait_address == cv_key) {
-                cv_fiber = std::addressof(fiber_local);
-                break;
-            }
-        }
-
-        /* Check we found a waiter */
-        RESULT_RETURN_IF(cv_fiber == nullptr, ResultInvalidAddress);
-
-        /* Handle reacquisition of lock */
-        this->SwapLockForSignalKey(cv_fiber);
+        /* Signal cv waiters in wait order */
+        CoreWakeBatch wake_batch      = {};
+        u32           signalled_count = 0;
+        wait_bucket->VisitWaitersUnsafe(cv_key, [&](FiberLocalStorage *waiting_fiber) -> bool {
 
-        /* Unlock cv waiters */
-        u32 i = 1;
-        for (FiberLocalStorage &waiting_fiber : cv_fiber->wait_list) {
-
-            /* Break if signal count is reached */
-            if (signal_count <= i) { break; }
-
-            /* Detach from child list */
-            waiting_fiber.wait_list_node.Unlink();
+            /* Leave the wait bucket */
+            waiting_fiber->scheduler_list_node.Unlink();
+            this->UnregisterWaitTimer(waiting_fiber);
 
             /* Handle reacquisition of lock */
-            this->SwapLockForSignalKey(std::addressof(waiting_fiber));
-
-            /* Loop count */
-            ++i;
-        }
-
-        /* Transfer wait list */
-        if (cv_fiber->wait_list.IsEmpty() == false) {
+            this->ReacquireKeyLock(waiting_fiber, std::addressof(wake_batch));
 
-            FiberLocalStorage *next_cv_parent = std::addressof(cv_fiber->wait_list.PopFront());
-            for (FiberLocalStorage &waiting_fiber : cv_fiber->wait_list) {
-                /* Detach from previous list */
-                waiting_fiber.wait_list_node.Unlink();
+            ++signalled_count;
+            return signalled_count < signal_count;
+        });
+        this->WakeCores(wake_batch);
 
-                /* Add to new parent */
-                next_cv_parent->wait_list.PushBack(waiting_fiber);
-            }
-
-            cv_fiber->scheduler_list_node.Unlink();
-            m_wait_list.PushBack(*next_cv_parent);
+        /* Set cv key to 0 once no waiters remain */
+        if (wait_bucket->HasWaitersUnsafe(cv_key) == false) {
+            *cv_key = 0;
         }
 
-        /* Set cv key to 0 */
-        *cv_key = 0;
+        RESULT_RETURN_IF(signalled_count == 0, ResultNoWaiters);
 
         return ResultSuccess;
     }
@@ -607,48 +981,31 @@ namespace dd::ukern::impl {
         /* Get current fiber */
         FiberLocalStorage *current_fiber = this->GetCurrentThreadImpl();
 
-        /* Lock scheduler */
-        ScopedSchedulerLock lock(this);
+        /* Lock the address' wait bucket */
+        WaitAddressBucket *wait_bucket = m_wait_address_table.GetBucket(wait_address);
+        ScopedWaitBucketLock bucket_lock(wait_bucket);
 
         /* Check address */
-        u32 result = ResultSuccess;
-        if (*wait_address != value) {
-            result = ResultInvalidWaitAddressValue;
-        } else if (absolute_timeout <= 0) {
-            result = ResultTimeout;
-        } else {
-
-            /* Set wait address state */
-            WaitAddressArbiter wait_address_arbiter = {};
-            current_fiber->waitable_object  = std::addressof(wait_address_arbiter);
-            current_fiber->wait_address = wait_address;
-            current_fiber->fiber_state  = FiberState_Waiting;
-            current_fiber->timeout      = absolute_timeout;
-
-            /* Find address in wait list */
-            FiberLocalStorage *address_fiber = nullptr;
-            for (FiberLocalStorage &waiting_fiber : m_wait_list) {
-                if (wait_address == waiting_fiber.wait_address) {
-                    address_fiber = std::addressof(waiting_fiber);
-                    break;
-                }
-            }
-
-            /* Push back to a wait list */
-            if (address_fiber == nullptr) {
-                m_wait_list.PushBack(*current_fiber);
-            } else {
-                address_fiber->wait_list.PushBack(*current_fiber);
-            }
-        }
+        RESULT_RETURN_IF(std::atomic_ref<u32>(*wait_address).load() != value, ResultInvalidWaitAddressValue);
+        RESULT_RETURN_IF(absolute_timeout <= 0,  ResultTimeout);
+
+        /* Set wait address state */
+        WaitAddressArbiter wait_address_arbiter = {};
+        current_fiber->waitable_object = std::addressof(wait_address_arbiter);
+        current_fiber->wait_bucket     = wait_bucket;
+        current_fiber->wait_address    = wait_address;
+        current_fiber->fiber_state     = FiberState_Waiting;
+        current_fiber->timeout         = absolute_timeout;
 
-        ::SwitchToFiber(this->GetSchedulerFiber(current_fiber));
+        /* Wait in the address' bucket */
+        wait_bucket->PushBackUnsafe(current_fiber);
+        this->RegisterWaitTimer(current_fiber);
 
-        if (result == ResultSuccess) {
-            result = current_fiber->last_result;
-        }
+        /* Swap to scheduler */
+        bucket_lock.HandOffToScheduler();
+        SwitchToFiberContext(this->GetSchedulerFiber(current_fiber));
 
-        return result;
+        return current_fiber->last_result;
     }
 
     Result UserScheduler::WaitForAddressIfLessThanImpl(u32 *wait_address, u32 value, s64 absolute_timeout, bool do_decrement) {
@@ -659,54 +1016,55 @@ namespace dd::ukern::impl {
         /* Get current fiber */
         FiberLocalStorage *current_fiber = this->GetCurrentThreadImpl();
 
-        /* Lock scheduler */
-        ScopedSchedulerLock lock(this);
+        /* Lock the address' wait bucket */
+        WaitAddressBucket *wait_bucket = m_wait_address_table.GetBucket(wait_address);
+        ScopedWaitBucketLock bucket_lock(wait_bucket);
 
-        /* Perform decrement */
-        u32 wait_value = *wait_address;
+        /* Perform decrement if we will wait */
+        std::atomic_ref<u32> address_value(*wait_address);
+        u32 wait_value = address_value.load();
         if (do_decrement == true) {
-            *wait_address  = *wait_address - 1;
+            while (wait_value < value && address_value.compare_exchange_weak(wait_value, wait_value - 1) == false) {}
         }
 
         /* Check address */
-        u32 result = ResultSuccess;
-        if (wait_value >= value) {
-            result = ResultInvalidWaitAddressValue;
-        } else if (absolute_timeout <= 0) {
-            result = ResultTimeout;
-        } else {
+        RESULT_RETURN_IF(wait_value >= value,   ResultInvalidWaitAddressValue);
+        RESULT_RETURN_IF(absolute_timeout <= 0, ResultTimeout);
+
+        /* Set wait address state */
+        WaitAddressArbiter wait_address_arbiter = {};
+        current_fiber->waitable_object = std::addressof(wait_address_arbiter);
+        current_fiber->wait_bucket     = wait_bucket;
+        current_fiber->wait_address    = wait_address;
+        current_fiber->fiber_state     = FiberState_Waiting;
+        current_fiber->timeout         = absolute_timeout;
 
-            /* Set wait address state */
-            WaitAddressArbiter wait_address_arbiter = {};
-            current_fiber->waitable_object  = std::addressof(wait_address_arbiter);
-            current_fiber->wait_address = wait_address;
-            current_fiber->fiber_state  = FiberState_Waiting;
-            current_fiber->timeout      = absolute_timeout;
-
-            /* Find address in wait list */
-            FiberLocalStorage *address_fiber = nullptr;
-            for (FiberLocalStorage &waiting_fiber : m_wait_list) {
-                if (wait_address == waiting_fiber.wait_address) {
-                    address_fiber = std::addressof(waiting_fiber);
-                    break;
-                }
-            }
+        /* Wait in the address' bucket */
+        wait_bucket->PushBackUnsafe(current_fiber);
+        this->RegisterWaitTimer(current_fiber);
 
-            /* Push back to a wait list */
-            if (address_fiber == nullptr) {
-                m_wait_list.PushBack(*current_fiber);
-            } else {
-                address_fiber->wait_list.PushBack(*current_fiber);
-            }
-        }
+        /* Swap to scheduler */
+        bucket_lock.HandOffToScheduler();
+        SwitchToFiberContext(this->GetSchedulerFiber(current_fiber));
 
-        ::SwitchToFiber(this->GetSchedulerFiber(current_fiber));
+        return current_fiber->last_result;
+    }
 
-        if (result == ResultSuccess) {
-            result = current_fiber->last_result;
-        }
+    u32 UserScheduler::WakeAddressWaitersUnsafe(WaitAddressBucket *wait_bucket, u32 *wait_address, u32 count) {
+
+        /* Release up to count waiters in wait order, waking cores once for the whole batch */
+        CoreWakeBatch wake_batch  = {};
+        u32           woken_count = 0;
+        wait_bucket->VisitWaitersUnsafe(wait_address, [&](FiberLocalStorage *waiting_fiber) -> bool {
 
-        return result;
+            waiting_fiber->waitable_object->EndWait(waiting_fiber, ResultSuccess, std::addressof(wake_batch));
+
+            ++woken_count;
+            return woken_count < count;
+        });
+        this->WakeCores(wake_batch);
+
+        return woken_count;
     }
 
     Result UserScheduler::WakeByAddressImpl(u32 *wait_address, u32 count) {
@@ -714,188 +1072,172 @@ namespace dd::ukern::impl {
         /* Integrity checks */
         RESULT_RETURN_IF(wait_address == nullptr, ResultInvalidAddress);
 
-        /* Lock scheduler */
-        ScopedSchedulerLock lock(this);
-
         if (count == 0) { return ResultSuccess; }
 
-        /* Find address in wait list */
-        FiberLocalStorage *address_fiber = nullptr;
-        for (FiberLocalStorage &waiting_fiber : m_wait_list) {
-            if (wait_address == waiting_fiber.wait_address) {
-                address_fiber = std::addressof(waiting_fiber);
-                break;
-            }
-        }
-
-        /* Integrity checks */
-        RESULT_RETURN_IF(address_fiber == nullptr, ResultNoWaiters);
-
-        /* Release parent waiter */
-        address_fiber->waitable_object->EndWait(address_fiber, ResultSuccess);
+        /* Lock the address' wait bucket */
+        WaitAddressBucket *wait_bucket = m_wait_address_table.GetBucket(wait_address);
+        ScopedWaitBucketLock bucket_lock(wait_bucket);
 
         /* Release the waiting fibers */
-        u32 i = 1;
-        for (FiberLocalStorage &waiting_fiber : address_fiber->wait_list) {
-
-            if (count < i) { break; }
+        const u32 woken_count = this->WakeAddressWaitersUnsafe(wait_bucket, wait_address, count);
+        RESULT_RETURN_IF(woken_count == 0, ResultNoWaiters);
 
-            waiting_fiber.waitable_object->EndWait(std::addressof(waiting_fiber), ResultSuccess);
-            waiting_fiber.wait_list_node.Unlink();
+        return ResultSuccess;
+    }
 
-            ++i;
-        }
+    Result UserScheduler::WakeByAddressIncrementEqualImpl(u32 *wait_address, u32 value, u32 count) {
 
-        /* Transfer wait list */
-        if (address_fiber->wait_list.IsEmpty() == false) {
+        /* Integrity checks */
+        RESULT_RETURN_IF(wait_address == nullptr, ResultInvalidAddress);
 
-            FiberLocalStorage *next_address_parent = std::addressof(address_fiber->wait_list.PopFront());
-            for (FiberLocalStorage &waiting_fiber : address_fiber->wait_list) {
-                /* Detach from previous list */
-                waiting_fiber.wait_list_node.Unlink();
+        /* Lock the address' wait bucket */
+        WaitAddressBucket *wait_bucket = m_wait_address_table.GetBucket(wait_address);
+        ScopedWaitBucketLock bucket_lock(wait_bucket);
 
-                /* Add to new parent */
-                next_address_parent->wait_list.PushBack(waiting_fiber);
-            }
+        /* Check and increment address value */
+        u32 expected_value = value;
+        RESULT_RETURN_UNLESS(std::atomic_ref<u32>(*wait_address).compare_exchange_strong(expected_value, value + 1), ResultValueOutOfRange);
 
-            address_fiber->scheduler_list_node.Unlink();
-            m_wait_list.PushBack(*next_address_parent);
+        /* Release the waiting fibers */
+        if (count != 0) {
+            this->WakeAddressWaitersUnsafe(wait_bucket, wait_address, count);
         }
 
-       return ResultSuccess;
+        return ResultSuccess;
     }
 
-    Result UserScheduler::WakeByAddressIncrementEqualImpl(u32 *wait_address, u32 value, u32 count) {
+    Result UserScheduler::WakeByAddressModifyLessThanImpl(u32 *wait_address, u32 value, u32 count) {
 
         /* Integrity checks */
         RESULT_RETURN_IF(wait_address == nullptr, ResultInvalidAddress);
 
-        /* Lock scheduler */
-        ScopedSchedulerLock lock(this);
-        
-        /* Check address value */
-        RESULT_RETURN_IF(*wait_address != value, ResultValueOutOfRange);
-
-        *wait_address = value + 1;
+        /* Lock the address' wait bucket */
+        WaitAddressBucket *wait_bucket = m_wait_address_table.GetBucket(wait_address);
+        ScopedWaitBucketLock bucket_lock(wait_bucket);
+
+        /* Determine value to signal, +1 without waiters, -1 if every waiter will be woken */
+        const u32 waiter_count = wait_bucket->CountWaitersUnsafe(wait_address);
+        s32 signal = 0;
+        if (waiter_count == 0) {
+            signal = 1;
+        } else if (waiter_count <= count) {
+            signal = -1;
+        }
 
-        /* Find address in wait list */
-        FiberLocalStorage *address_fiber = nullptr;
-        for (FiberLocalStorage &waiting_fiber : m_wait_list) {
-            if (wait_address == waiting_fiber.wait_address) {
-                address_fiber = std::addressof(waiting_fiber);
-                break;
-            }
+        /* Check address value, and only modify if non-zero signal */
+        std::atomic_ref<u32> address_value(*wait_address);
+        if (signal != 0) {
+            u32 expected_value = value;
+            RESULT_RETURN_UNLESS(address_value.compare_exchange_strong(expected_value, value + signal), ResultValueOutOfRange);
+        } else {
+            RESULT_RETURN_UNLESS(address_value.load() == value, ResultValueOutOfRange);
         }
-        
-        /* Release parent waiter */
-        address_fiber->waitable_object->EndWait(address_fiber, ResultSuccess);
 
         /* Release the waiting fibers */
-        u32 i = 1;
-        for (FiberLocalStorage &waiting_fiber : address_fiber->wait_list) {
-
-            if (count < i) { break; }
-
-            waiting_fiber.waitable_object->EndWait(std::addressof(waiting_fiber), ResultSuccess);
-            waiting_fiber.wait_list_node.Unlink();
-
-            ++i;
+        if (count != 0) {
+            this->WakeAddressWaitersUnsafe(wait_bucket, wait_address, count);
         }
 
-        /* Transfer wait list */
-        if (address_fiber->wait_list.IsEmpty() == false) {
-
-            FiberLocalStorage *next_address_parent = std::addressof(address_fiber->wait_list.PopFront());
-            for (FiberLocalStorage &waiting_fiber : address_fiber->wait_list) {
-                /* Detach from previous list */
-                waiting_fiber.wait_list_node.Unlink();
+        return ResultSuccess;
+    }
 
-                /* Add to new parent */
-                next_address_parent->wait_list.PushBack(waiting_fiber);
-            }
+    void UserScheduler::ScheduleCoroutineUnsafe(CoroutineResumeNode *resume_node, CoreWakeBatch *wake_batch) {
 
-            address_fiber->scheduler_list_node.Unlink();
-            m_wait_list.PushBack(*next_address_parent);
-        }
+        /* The runner bucket is never in the address table, so it nests under any address bucket */
+        ScopedWaitBucketLock bucket_lock(std::addressof(m_coroutine_runner_bucket));
+        m_coroutine_ready_list.PushBack(*resume_node);
 
-        return ResultSuccess;
+        /* Release one idle runner */
+        m_coroutine_runner_bucket.VisitWaitersUnsafe(std::addressof(m_coroutine_runner_key), [&](FiberLocalStorage *runner_fiber) -> bool {
+            runner_fiber->waitable_object->EndWait(runner_fiber, ResultSuccess, wake_batch);
+            return false;
+        });
     }
 
-    Result UserScheduler::WakeByAddressModifyLessThanImpl(u32 *wait_address, u32 value, u32 count) {
+    Result UserScheduler::WaitForAddressIfEqualAsyncImpl(CoroutineWaiter *coroutine_waiter, u32 *wait_address, u32 value, s64 absolute_timeout) {
 
         /* Integrity checks */
         RESULT_RETURN_IF(wait_address == nullptr, ResultInvalidAddress);
 
-        /* Lock scheduler */
-        ScopedSchedulerLock lock(this);
+        /* Lock the address' wait bucket */
+        WaitAddressBucket *wait_bucket = m_wait_address_table.GetBucket(wait_address);
+        ScopedWaitBucketLock bucket_lock(wait_bucket);
 
-        /* Check address value */
-        if (*wait_address != value) {
-            return ResultValueOutOfRange;
-        }
+        /* Check address */
+        RESULT_RETURN_IF(std::atomic_ref<u32>(*wait_address).load() != value, ResultInvalidWaitAddressValue);
+        RESULT_RETURN_IF(absolute_timeout <= 0,  ResultTimeout);
+
+        /* The waiter's entry stands in for a fiber in the bucket and timer heap, the coroutine frame holds no stack */
+        FiberLocalStorage *wait_entry = coroutine_waiter->GetWaitEntry();
+        wait_entry->waitable_object = coroutine_waiter;
+        wait_entry->wait_bucket     = wait_bucket;
+        wait_entry->wait_address    = wait_address;
+        wait_entry->fiber_state     = FiberState_Waiting;
+        wait_entry->timeout         = absolute_timeout;
+        wait_entry->last_result     = ResultSuccess;
+
+        /* The coroutine may resume on a runner as soon as the bucket unlocks */
+        wait_bucket->PushBackUnsafe(wait_entry);
+        this->RegisterWaitTimer(wait_entry);
 
-        /* Find address in wait list */
-        FiberLocalStorage *address_fiber = nullptr;
-        for (FiberLocalStorage &waiting_fiber : m_wait_list) {
-            if (wait_address == waiting_fiber.wait_address) {
-                address_fiber = std::addressof(waiting_fiber);
-                break;
-            }
-        }
+        return ResultSuccess;
+    }
 
-        /* Determine value to signal */
-        u32 signal = -1;
+    void UserScheduler::ScheduleCoroutineImpl(CoroutineResumeNode *resume_node) {
 
-        if (address_fiber == nullptr) { 
-            signal = 1; 
-        } else if (0 < count) {
-            /* Count waiters */
-            signal = 0;
-            u32 i = 1;
-            for ([[maybe_unused]] FiberLocalStorage &waiting_fiber : address_fiber->wait_list) {
-                ++i;
-            }
-            /* Signal -1 if less waiters to wakeup then count */
-            if (i < count) { signal = -1; }
-        }
+        CoreWakeBatch wake_batch = {};
+        this->ScheduleCoroutineUnsafe(resume_node, std::addressof(wake_batch));
+        this->WakeCores(wake_batch);
+    }
 
-        /* Only modify if non-zero signal */
-        if (signal != 0) {
-            *wait_address = value + signal;
-        }
+    CoroutineResumeNode *UserScheduler::WaitForReadyCoroutineImpl() {
 
-        /* Release parent waiter */
-        address_fiber->waitable_object->EndWait(address_fiber, ResultSuccess);
+        /* Get current fiber */
+        FiberLocalStorage *current_fiber = this->GetCurrentThreadImpl();
 
-        /* Release the waiting fibers */
-        u32 i = 1;
-        for (FiberLocalStorage &waiting_fiber : address_fiber->wait_list) {
+        for (;;) {
+            ScopedWaitBucketLock bucket_lock(std::addressof(m_coroutine_runner_bucket));
 
-            if (count < i) { break; }
+            /* Resume in the order coroutines became ready */
+            if (m_coroutine_ready_list.IsEmpty() == false) {
+                return std::addressof(m_coroutine_ready_list.PopFront());
+            }
+            if (m_is_coroutine_runner_exiting == true) { return nullptr; }
 
-            waiting_fiber.waitable_object->EndWait(std::addressof(waiting_fiber), ResultSuccess);
-            waiting_fiber.wait_list_node.Unlink();
+            /* Park in the runner bucket like an address waiter */
+            WaitAddressArbiter wait_address_arbiter = {};
+            current_fiber->waitable_object = std::addressof(wait_address_arbiter);
+            current_fiber->wait_bucket     = std::addressof(m_coroutine_runner_bucket);
+            current_fiber->wait_address    = std::addressof(m_coroutine_runner_key);
+            current_fiber->fiber_state     = FiberState_Waiting;
+            current_fiber->timeout         = TimeSpan::MaxTime;
 
-            ++i;
-        }
+            m_coroutine_runner_bucket.PushBackUnsafe(current_fiber);
 
-        /* Transfer wait list */
-        if (address_fiber->wait_list.IsEmpty() == false) {
+            /* Swap to scheduler */
+            bucket_lock.HandOffToScheduler();
+            SwitchToFiberContext(this->GetSchedulerFiber(current_fiber));
+        }
+    }
 
-            FiberLocalStorage *next_address_parent = std::addressof(address_fiber->wait_list.PopFront());
-            for (FiberLocalStorage &waiting_fiber : address_fiber->wait_list) {
-                /* Detach from previous list */
-                waiting_fiber.wait_list_node.Unlink();
+    void UserScheduler::ExitCoroutineRunnersImpl() {
 
-                /* Add to new parent */
-                next_address_parent->wait_list.PushBack(waiting_fiber);
-            }
+        CoreWakeBatch wake_batch = {};
+        {
+            ScopedWaitBucketLock bucket_lock(std::addressof(m_coroutine_runner_bucket));
+            m_is_coroutine_runner_exiting = true;
 
-            address_fiber->scheduler_list_node.Unlink();
-            m_wait_list.PushBack(*next_address_parent);
+            /* Release every idle runner to observe the exit */
+            m_coroutine_runner_bucket.VisitWaitersUnsafe(std::addressof(m_coroutine_runner_key), [&](FiberLocalStorage *runner_fiber) -> bool {
+                runner_fiber->waitable_object->EndWait(runner_fiber, ResultSuccess, std::addressof(wake_batch));
+                return true;
+            });
         }
-
-        return ResultSuccess;
+        this->WakeCores(wake_batch);
     }
 
+    void UserScheduler::ResetCoroutineRunnersImpl() {
+        ScopedWaitBucketLock bucket_lock(std::addressof(m_coroutine_runner_bucket));
+        m_is_coroutine_runner_exiting = false;
+    }
 }
@@ -0,0 +1,139 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <dd.hpp>
+
+namespace dd::ukern::impl {
+
+    namespace {
+
+        thread_local u32 sCurrentCoreNumber = 0;
+
+        constexpr const char *EventNameTable[] = {
+            "Dispatch",
+            "Preempt",
+            "Wait",
+            "Wake",
+            "Timeout",
+            "Exit",
+        };
+
+        void OutputJsonString(FILE *file, const char *string, size_t max_length) {
+
+            ::fputc('\"', file);
+            for (size_t i = 0; i < max_length && string[i] != '\0'; ++i) {
+                const char character = string[i];
+                if (character == '\"' || character == '\\') { ::fputc('\\', file); }
+                if (static_cast<u8>(character) < 0x20) { continue; }
+                ::fputc(character, file);
+            }
+            ::fputc('\"', file);
+        }
+    }
+
+    void SchedulerTracer::SetCurrentCoreNumber(u32 core_number) {
+        sCurrentCoreNumber = core_number;
+    }
+
+    void SchedulerTracer::RecordImpl(SchedulerTraceEventType event_type, FiberLocalStorage *fiber_local) {
+        const u32 core_number = sCurrentCoreNumber;
+        m_ring_array[core_number].Record(event_type, core_number, fiber_local);
+    }
+
+    Result SchedulerTracer::Enable(u32 core_count) {
+
+        /* Allocate rings before any core can observe tracing as enabled */
+        for (u32 i = 0; i < core_count; ++i) {
+            RESULT_RETURN_UNLESS(m_ring_array[i].Initialize() == true, ResultTraceAllocationFailure);
+        }
+        m_core_count = core_count;
+
+        m_is_enabled.store(true, std::memory_order_release);
+
+        return ResultSuccess;
+    }
+
+    void SchedulerTracer::Disable() {
+        m_is_enabled.store(false, std::memory_order_release);
+    }
+
+    Result SchedulerTracer::ExportChromeTraceJson(const char *path) {
+
+        /* Stop recording so the rings are not overwritten while exporting */
+        this->Disable();
+        RESULT_RETURN_UNLESS(m_core_count != 0, ResultTraceNotEnabled);
+
+        FILE *file = ::fopen(path, "w");
+        RESULT_RETURN_UNLESS(file != nullptr, ResultTraceOutputFailure);
+
+        /* Find the earliest retained event to base timestamps on */
+        s64 base_tick = 0x7fff'ffff'ffff'ffff;
+        for (u32 i = 0; i < m_core_count; ++i) {
+            const u64 write_count = m_ring_array[i].GetWriteCount();
+            if (write_count == 0) { continue; }
+
+            const u64 first_index = (SchedulerTraceRing::EventCount < write_count) ? write_count - SchedulerTraceRing::EventCount : 0;
+            const s64 first_tick  = m_ring_array[i].GetEvent(first_index)->tick;
+            if (first_tick < base_tick) { base_tick = first_tick; }
+        }
+
+        ::fputs("{\"traceEvents\":[\n", file);
+
+        bool is_first_event = true;
+        for (u32 i = 0; i < m_core_count; ++i) {
+
+            /* Name each core's track */
+            ::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Core %u\"}}", (is_first_event == true) ? "" : ",\n", i, i);
+            is_first_event = false;
+
+            /* Dispatches open a slice on the core's track until the fiber switches out, wakes and timeouts are instant events */
+            const u64 write_count = m_ring_array[i].GetWriteCount();
+            const u64 first_index = (SchedulerTraceRing::EventCount < write_count) ? write_count - SchedulerTraceRing::EventCount : 0;
+            bool      is_open     = false;
+            for (u64 y = first_index; y < write_count; ++y) {
+
+                const SchedulerTraceEvent *event = m_ring_array[i].GetEvent(y);
+                const double timestamp_us        = static_cast<double>(TimeSpan::FromTick(event->tick - base_tick).GetNanoSeconds()) / 1000.0;
+
+                const char *phase = "i";
+                switch (event->event_type) {
+                    case SchedulerTraceEventType_Dispatch:
+                        phase   = "B";
+                        is_open = true;
+                        break;
+                    case SchedulerTraceEventType_Preempt:
+                    case SchedulerTraceEventType_Wait:
+                    case SchedulerTraceEventType_Exit:
+                        /* Skip switch outs whose dispatch was overwritten */
+                        if (is_open == false) { continue; }
+                        phase   = "E";
+                        is_open = false;
+                        break;
+                    default:
+                        break;
+                }
+
+                ::fputs(",\n{\"name\":", file);
+                OutputJsonString(file, event->fiber_name, MaxFiberNameLength);
+                ::fprintf(file, ",\"cat\":\"ukern\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":0,\"tid\":%u,%s\"args\":{\"handle\":%u,\"event\":\"%s\"}}", phase, timestamp_us, i, (phase[0] == 'i') ? "\"s\":\"t\"," : "", event->fiber_handle, EventNameTable[event->event_type]);
+            }
+        }
+
+        ::fputs("\n]}\n", file);
+        ::fclose(file);
+
+        return ResultSuccess;
+    }
+}
@@ -25,6 +25,14 @@ namespace dd::ukern {
         impl::GetScheduler()->ExitThreadImpl(handle);
     }
 
+    Result JoinThread(UKernHandle handle, TimeSpan timeout_ns) {
+        return impl::GetScheduler()->JoinThreadImpl(handle, impl::GetAbsoluteTimeToWakeup(timeout_ns));
+    }
+
+    Result JoinThreads(const UKernHandle *handle_array, u32 handle_count, TimeSpan timeout_ns) {
+        return impl::GetScheduler()->JoinThreadsImpl(handle_array, handle_count, impl::GetAbsoluteTimeToWakeup(timeout_ns));
+    }
+
     Result StartThread(UKernHandle handle) {
         return impl::GetScheduler()->SetActivityImpl(handle, ActivityLevel_Schedulable);
     }
@@ -73,13 +81,40 @@ namespace dd::ukern {
         return impl::GetScheduler()->SetCoreMaskImpl(handle, core_mask);
     }
 
+    Result SetThreadDeadline(UKernHandle handle, TimeSpan relative_deadline, TimeSpan budget) {
+        return impl::GetScheduler()->SetDeadlineImpl(handle, relative_deadline.GetTick(), budget.GetTick());
+    }
+
+    Result GetThreadDeadlineStatistics(ThreadDeadlineStatistics *out_statistics, UKernHandle handle) {
+        return impl::GetScheduler()->GetDeadlineStatisticsImpl(out_statistics, handle);
+    }
+
     void Sleep(TimeSpan timeout_span) {
+
+        /* A zero sleep only yields */
+        if (timeout_span.GetNanoSeconds() == 0) {
+            impl::GetScheduler()->YieldThreadImpl();
+            return;
+        }
+
         impl::GetScheduler()->SleepThreadImpl(impl::GetAbsoluteTimeToWakeup(timeout_span));
     }
 
     void YieldThread() {
-        impl::GetScheduler()->SleepThreadImpl(0);
+        impl::GetScheduler()->YieldThreadImpl();
     }
 
     ThreadType *GetCurrentThread() { return impl::GetScheduler()->GetCurrentThreadImpl(); }
+
+    Result AllocateFiberLocalSlot(u32 *out_slot) {
+        return impl::GetScheduler()->AllocateFiberLocalSlotImpl(out_slot);
+    }
+
+    Result FreeFiberLocalSlot(u32 slot) {
+        return impl::GetScheduler()->FreeFiberLocalSlotImpl(slot);
+    }
+
+    void GetFiberStackPoolStatistics(FiberStackPoolStatistics *out_statistics) {
+        impl::GetScheduler()->GetFiberStackPoolStatisticsImpl(out_statistics);
+    }
 }
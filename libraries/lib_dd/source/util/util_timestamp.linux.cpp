@@ -0,0 +1,43 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <dd.hpp>
+
+namespace dd::util {
+
+    /* Ticks are CLOCK_MONOTONIC nanoseconds */
+    constexpr s64 MonotonicClockFrequency = 1'000'000'000;
+
+    s64 sMaxTickToTimeSpan = TimeSpan::MaxTime;
+
+    void InitializeTimeStamp() {
+        sMaxTickToTimeSpan = ((TimeSpan::MaxTime - (TimeSpan::MaxTime % MonotonicClockFrequency)) / 1'000'000'000) * MonotonicClockFrequency;
+    }
+
+    s64 GetSystemTick() {
+        struct timespec time = {};
+        const int result = ::clock_gettime(CLOCK_MONOTONIC, std::addressof(time));
+        DD_ASSERT(result == 0);
+        return time.tv_sec * MonotonicClockFrequency + time.tv_nsec;
+    }
+
+    s32 GetSystemTickFrequency() {
+        return MonotonicClockFrequency;
+    }
+    
+    s64 GetMaxTickToTimeSpan() {
+        return sMaxTickToTimeSpan;
+    }
+}
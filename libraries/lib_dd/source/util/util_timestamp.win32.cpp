@@ -0,0 +1,43 @@
+ /*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <dd.hpp>
+
+namespace dd::util {
+
+    s64 sSystemFrequency   = 0;
+    s64 sMaxTickToTimeSpan = TimeSpan::MaxTime;
+
+    void InitializeTimeStamp() {
+        const bool result = ::QueryPerformanceFrequency(reinterpret_cast<LARGE_INTEGER*>(std::addressof(sSystemFrequency)));
+        DD_ASSERT(result == true);
+        sMaxTickToTimeSpan = ((TimeSpan::MaxTime - (TimeSpan::MaxTime % sSystemFrequency)) / 1'000'000'000) * sSystemFrequency;
+    }
+
+    s64 GetSystemTick() {
+        s64 time = 0;
+        const bool result = ::QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(std::addressof(time)));
+        DD_ASSERT(result == true);
+        return time;
+    }
+
+    s32 GetSystemTickFrequency() {
+        return sSystemFrequency;
+    }
+    
+    s64 GetMaxTickToTimeSpan() {
+        return sMaxTickToTimeSpan;
+    }
+}
@@ -32,28 +32,4 @@ namespace dd::util {
             return __builtin_ia32_rdtsc();
         }
     }
-
-    s64 sSystemFrequency   = 0;
-    s64 sMaxTickToTimeSpan = TimeSpan::MaxTime;
-
-    void InitializeTimeStamp() {
-        const bool result = ::QueryPerformanceFrequency(reinterpret_cast<LARGE_INTEGER*>(std::addressof(sSystemFrequency)));
-        DD_ASSERT(result == true);
-        sMaxTickToTimeSpan = ((TimeSpan::MaxTime - (TimeSpan::MaxTime % sSystemFrequency)) / 1'000'000'000) * sSystemFrequency;
-    }
-
-    s64 GetSystemTick() {
-        s64 time = 0;
-        const bool result = ::QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(std::addressof(time)));
-        DD_ASSERT(result == true);
-        return time;
-    }
-
-    s32 GetSystemTickFrequency() {
-        return sSystemFrequency;
-    }
-    
-    s64 GetMaxTickToTimeSpan() {
-        return sMaxTickToTimeSpan;
-    }
 }
@@ -50,11 +50,11 @@ namespace unit {
                     const int result = current_test->Run();
                     if (result != -1) {
                         char failure_output[0x200] = {};
-                        ::snprintf(failure_output, sizeof(failure_output), "Test failed:    %s (%s:%d)(%lld/%lld)", current_test->GetTestName(), current_test->GetTestFileName(), result, test_number, test_count);
+                        ::snprintf(failure_output, sizeof(failure_output), "Test failed:    %s (%s:%d)(%zu/%zu)", current_test->GetTestName(), current_test->GetTestFileName(), result, test_number, test_count);
                         ::puts(failure_output);
                     } else {
                         char success_output[0x200] = {};
-                        ::snprintf(success_output, sizeof(success_output), "Test succeeded: %s (%s)(%lld/%lld)", current_test->GetTestName(), current_test->GetTestFileName(), test_number, test_count);
+                        ::snprintf(success_output, sizeof(success_output), "Test succeeded: %s (%s)(%zu/%zu)", current_test->GetTestName(), current_test->GetTestFileName(), test_number, test_count);
                         ::puts(success_output);
                     }
 
@@ -0,0 +1,97 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 BenchCoreCount  = 4;
+constexpr u32 JobCount        = 10000;
+constexpr u32 LayerJobCount   = 1000;
+constexpr u32 DependencyCount = (JobCount - LayerJobCount) * 2;
+constexpr u32 SubmitCount     = 100;
+constexpr u32 WorkIterations  = 256;
+
+dd::job::FixedJobGraph<JobCount, 1>               WideGraph;
+dd::job::FixedJobGraph<JobCount, DependencyCount> LayerGraph;
+dd::job::FixedJobGraph<JobCount, JobCount - 1>    ChainGraph;
+u32                                               WorkArray[JobCount] = {};
+u32                                               WorkIterationCount  = 0;
+
+void BenchJobMain(void *arg) {
+    u32 *work = reinterpret_cast<u32*>(arg);
+    u32  hash = *work;
+    for (u32 i = 0; i < WorkIterationCount; ++i) { hash = hash * 0x9e37'79b1 + i; }
+    *work = hash;
+    return;
+}
+
+s64 RunGraph(dd::job::JobGraph *graph) {
+
+    const s64 start_tick = dd::util::GetSystemTick();
+
+    /* Resubmit the built graph, nothing is allocated per submission */
+    for (u32 i = 0; i < SubmitCount; ++i) {
+        const u32 result0 = dd::job::RunJobGraph(graph);
+        if (result0 != dd::ResultSuccess) { return -1; }
+    }
+
+    return dd::TimeSpan::FromTick(dd::util::GetSystemTick() - start_tick).GetNanoSeconds();
+}
+
+TEST(BenchmarkJobGraph) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(dd::ukern::UKernCoreMask::MakeLowBits(BenchCoreCount));
+
+    const u32 result0 = dd::job::InitializeJobSystem();
+    TEST_ASSERT(result0 == dd::ResultSuccess);
+
+    /* Independent jobs, layers with a fan in of two, and a single chain */
+    dd::job::JobHandle handle = 0;
+    for (u32 i = 0; i < JobCount; ++i) {
+        TEST_ASSERT(WideGraph.AddJob(std::addressof(handle), BenchJobMain, std::addressof(WorkArray[i])) == dd::ResultSuccess);
+        TEST_ASSERT(LayerGraph.AddJob(std::addressof(handle), BenchJobMain, std::addressof(WorkArray[i])) == dd::ResultSuccess);
+        TEST_ASSERT(ChainGraph.AddJob(std::addressof(handle), BenchJobMain, std::addressof(WorkArray[i])) == dd::ResultSuccess);
+    }
+    for (u32 i = LayerJobCount; i < JobCount; ++i) {
+        TEST_ASSERT(LayerGraph.AddDependency(i - LayerJobCount, i) == dd::ResultSuccess);
+        TEST_ASSERT(LayerGraph.AddDependency(i - LayerJobCount + ((i + 1) % LayerJobCount) - (i % LayerJobCount), i) == dd::ResultSuccess);
+    }
+    for (u32 i = 1; i < JobCount; ++i) {
+        TEST_ASSERT(ChainGraph.AddDependency(i - 1, i) == dd::ResultSuccess);
+    }
+
+    /* Empty jobs measure the scheduling overhead alone */
+    const s64 empty_wide_ns = RunGraph(std::addressof(WideGraph));
+    TEST_ASSERT(0 <= empty_wide_ns);
+    const s64 empty_layer_ns = RunGraph(std::addressof(LayerGraph));
+    TEST_ASSERT(0 <= empty_layer_ns);
+    const s64 empty_chain_ns = RunGraph(std::addressof(ChainGraph));
+    TEST_ASSERT(0 <= empty_chain_ns);
+
+    /* Serial reference, called through a pointer like the workers do */
+    WorkIterationCount = WorkIterations;
+    dd::job::JobFunction volatile serial_function = BenchJobMain;
+    const s64 serial_start_tick = dd::util::GetSystemTick();
+    for (u32 i = 0; i < SubmitCount; ++i) {
+        for (u32 j = 0; j < JobCount; ++j) { serial_function(std::addressof(WorkArray[j])); }
+    }
+    const s64 serial_ns = dd::TimeSpan::FromTick(dd::util::GetSystemTick() - serial_start_tick).GetNanoSeconds();
+
+    const s64 wide_ns = RunGraph(std::addressof(WideGraph));
+    TEST_ASSERT(0 <= wide_ns);
+    const s64 layer_ns = RunGraph(std::addressof(LayerGraph));
+    TEST_ASSERT(0 <= layer_ns);
+    const s64 chain_ns = RunGraph(std::addressof(ChainGraph));
+    TEST_ASSERT(0 <= chain_ns);
+
+    dd::job::FinalizeJobSystem();
+
+    constexpr double SubmittedJobCount = static_cast<double>(JobCount) * SubmitCount;
+    ::printf("JobGraph: %u workers, %u jobs, overhead wide %.2f ns, layered %.2f ns, chain %.2f ns per job\n", BenchCoreCount, JobCount, static_cast<double>(empty_wide_ns) / SubmittedJobCount, static_cast<double>(empty_layer_ns) / SubmittedJobCount, static_cast<double>(empty_chain_ns) / SubmittedJobCount);
+    ::printf("JobGraph: %u iteration jobs, serial %.2f ns, wide %.2f ns, layered %.2f ns, chain %.2f ns per job\n", WorkIterations, static_cast<double>(serial_ns) / SubmittedJobCount, static_cast<double>(wide_ns) / SubmittedJobCount, static_cast<double>(layer_ns) / SubmittedJobCount, static_cast<double>(chain_ns) / SubmittedJobCount);
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,96 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32    BenchCoreCount = 4;
+constexpr size_t ElementCount   = 1 << 20;
+constexpr size_t Grain          = 4096;
+constexpr u32    RepeatCount    = 8;
+
+float TransformArray[ElementCount] = {};
+u32   SortArray[ElementCount]      = {};
+
+void FillSortArray() {
+    u32 seed = 0x1234'5678;
+    for (size_t i = 0; i < ElementCount; ++i) {
+        seed         = seed * 1664525 + 1013904223;
+        SortArray[i] = seed;
+    }
+}
+
+struct BenchTimes {
+    s64 for_ns;
+    s64 reduce_ns;
+    s64 sort_ns;
+};
+
+float TransformElement(size_t index) {
+    float value = static_cast<float>(index);
+    for (u32 i = 0; i < 16; ++i) { value = value * 0.999f + 1.0f; }
+    return value;
+}
+
+BenchTimes RunBench() {
+
+    BenchTimes times = {};
+
+    const s64 for_start_tick = dd::util::GetSystemTick();
+    for (u32 i = 0; i < RepeatCount; ++i) {
+        dd::job::ParallelFor(0, ElementCount, Grain, [](size_t index) { TransformArray[index] = TransformElement(index); });
+    }
+    times.for_ns = dd::TimeSpan::FromTick(dd::util::GetSystemTick() - for_start_tick).GetNanoSeconds() / RepeatCount;
+
+    const s64 reduce_start_tick = dd::util::GetSystemTick();
+    double sum = 0.0;
+    for (u32 i = 0; i < RepeatCount; ++i) {
+        sum += dd::job::ParallelReduce(0, ElementCount, Grain, 0.0, [](size_t index) { return static_cast<double>(TransformArray[index]); }, [](double lhs, double rhs) { return lhs + rhs; });
+    }
+    times.reduce_ns = dd::TimeSpan::FromTick(dd::util::GetSystemTick() - reduce_start_tick).GetNanoSeconds() / RepeatCount;
+    if (sum <= 0.0) { times.reduce_ns = -1; }
+
+    for (u32 i = 0; i < RepeatCount; ++i) {
+        FillSortArray();
+        const s64 sort_start_tick = dd::util::GetSystemTick();
+        dd::job::ParallelSort(SortArray, ElementCount, Grain);
+        times.sort_ns += dd::TimeSpan::FromTick(dd::util::GetSystemTick() - sort_start_tick).GetNanoSeconds();
+    }
+    times.sort_ns = times.sort_ns / RepeatCount;
+
+    return times;
+}
+
+TEST(BenchmarkJobParallel) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(dd::ukern::UKernCoreMask::MakeLowBits(BenchCoreCount));
+
+    /* Serial reference without workers */
+    const BenchTimes serial_times = RunBench();
+    TEST_ASSERT(0 <= serial_times.reduce_ns);
+    for (size_t i = 1; i < ElementCount; ++i) { TEST_ASSERT(SortArray[i - 1] <= SortArray[i]); }
+    ::printf("JobParallel: serial, for %.3f ms, reduce %.3f ms, sort %.3f ms\n", static_cast<double>(serial_times.for_ns) / 1000000.0, static_cast<double>(serial_times.reduce_ns) / 1000000.0, static_cast<double>(serial_times.sort_ns) / 1000000.0);
+
+    /* Scale the workers from one core up */
+    for (u32 worker_count = 1; worker_count <= BenchCoreCount; ++worker_count) {
+
+        const u32 result0 = dd::job::InitializeJobSystem(worker_count);
+        TEST_ASSERT(result0 == dd::ResultSuccess);
+
+        const BenchTimes times = RunBench();
+        TEST_ASSERT(0 <= times.reduce_ns);
+        for (size_t i = 1; i < ElementCount; ++i) { TEST_ASSERT(SortArray[i - 1] <= SortArray[i]); }
+
+        dd::job::FinalizeJobSystem();
+
+        ::printf("JobParallel: %u workers, for %.3f ms (%.2fx), reduce %.3f ms (%.2fx), sort %.3f ms (%.2fx)\n", worker_count,
+            static_cast<double>(times.for_ns) / 1000000.0, static_cast<double>(serial_times.for_ns) / static_cast<double>(times.for_ns),
+            static_cast<double>(times.reduce_ns) / 1000000.0, static_cast<double>(serial_times.reduce_ns) / static_cast<double>(times.reduce_ns),
+            static_cast<double>(times.sort_ns) / 1000000.0, static_cast<double>(serial_times.sort_ns) / static_cast<double>(times.sort_ns));
+    }
+
+    TEST_SUCCESS;
+}
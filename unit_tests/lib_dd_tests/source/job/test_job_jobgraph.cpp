@@ -0,0 +1,136 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 LayerCount      = 8;
+constexpr u32 LayerJobCount   = 64;
+constexpr u32 JobCount        = LayerCount * LayerJobCount;
+constexpr u32 DependencyCount = (LayerCount - 1) * LayerJobCount * 2;
+constexpr u32 SubmitCount     = 32;
+
+dd::job::FixedJobGraph<JobCount, DependencyCount> LayerGraph;
+std::atomic<u32>                                 SequenceCounter = 0;
+u32                                              SequenceArray[JobCount] = {};
+dd::job::JobHandle                               HandleArray[JobCount]   = {};
+
+constexpr u32 SubmitterCount    = 4;
+constexpr u32 SubmitterJobCount = 16;
+
+dd::job::FixedJobGraph<SubmitterJobCount, 1> SubmitterGraphArray[SubmitterCount];
+std::atomic<u32>                             SubmitterJobCounter = 0;
+std::atomic<u32>                             SubmitterFailures   = 0;
+
+void TestJobMain(void *arg) {
+    const u32 job_index = reinterpret_cast<uintptr_t>(arg);
+    SequenceArray[job_index] = SequenceCounter.fetch_add(1) + 1;
+}
+
+void TestCountJobMain(void *) {
+    SubmitterJobCounter.fetch_add(1);
+}
+
+void TestSubmitterMain(void *arg) {
+
+    /* Each submitter resubmits it's own graph while the others do the same */
+    dd::job::JobGraph *graph = std::addressof(SubmitterGraphArray[reinterpret_cast<uintptr_t>(arg)]);
+    for (u32 i = 0; i < SubmitCount; ++i) {
+        if (dd::job::SubmitJobGraph(graph) != dd::ResultSuccess) { SubmitterFailures.fetch_add(1); return; }
+        graph->Wait();
+    }
+
+    return;
+}
+
+TEST(JobGraph) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(0b1111);
+
+    /* Nothing runs before the job system starts */
+    dd::job::FixedJobGraph<1, 1> empty_graph;
+    const u32 result0 = dd::job::SubmitJobGraph(std::addressof(empty_graph));
+    TEST_ASSERT(result0 == dd::job::ResultJobSystemNotInitialized);
+
+    const u32 result1 = dd::job::InitializeJobSystem();
+    TEST_ASSERT(result1 == dd::ResultSuccess);
+    TEST_ASSERT(dd::job::GetJobWorkerCount() == 4);
+
+    /* Malformed graphs are rejected while building */
+    dd::job::JobHandle handle = 0;
+    TEST_ASSERT(empty_graph.AddJob(std::addressof(handle), TestJobMain, nullptr) == dd::ResultSuccess);
+    TEST_ASSERT(empty_graph.AddJob(std::addressof(handle), TestJobMain, nullptr) == dd::job::ResultJobGraphFull);
+    TEST_ASSERT(empty_graph.AddDependency(0, 0) == dd::job::ResultInvalidDependency);
+    TEST_ASSERT(empty_graph.AddDependency(0, 1) == dd::job::ResultInvalidJobHandle);
+
+    /* Each job depends on two jobs of the previous layer */
+    for (u32 i = 0; i < JobCount; ++i) {
+        const u32 result2 = LayerGraph.AddJob(std::addressof(HandleArray[i]), TestJobMain, reinterpret_cast<void*>(static_cast<uintptr_t>(i)));
+        TEST_ASSERT(result2 == dd::ResultSuccess);
+    }
+    for (u32 layer = 1; layer < LayerCount; ++layer) {
+        for (u32 i = 0; i < LayerJobCount; ++i) {
+            const u32 job_index = layer * LayerJobCount + i;
+            const u32 result3 = LayerGraph.AddDependency(HandleArray[job_index - LayerJobCount], HandleArray[job_index]);
+            TEST_ASSERT(result3 == dd::ResultSuccess);
+            const u32 result4 = LayerGraph.AddDependency(HandleArray[(layer - 1) * LayerJobCount + (i * 7 + 3) % LayerJobCount], HandleArray[job_index]);
+            TEST_ASSERT(result4 == dd::ResultSuccess);
+        }
+    }
+    TEST_ASSERT(LayerGraph.GetJobCount() == JobCount);
+    TEST_ASSERT(LayerGraph.GetDependencyCount() == DependencyCount);
+
+    /* Resubmit the same graph, every job must run once after it's predecessors */
+    for (u32 submit = 0; submit < SubmitCount; ++submit) {
+        SequenceCounter = 0;
+        ::memset(SequenceArray, 0, sizeof(SequenceArray));
+
+        const u32 result5 = dd::job::SubmitJobGraph(std::addressof(LayerGraph));
+        TEST_ASSERT(result5 == dd::ResultSuccess);
+        LayerGraph.Wait();
+        TEST_ASSERT(LayerGraph.IsComplete() == true);
+
+        TEST_ASSERT(SequenceCounter == JobCount);
+        for (u32 layer = 1; layer < LayerCount; ++layer) {
+            for (u32 i = 0; i < LayerJobCount; ++i) {
+                const u32 job_index = layer * LayerJobCount + i;
+                TEST_ASSERT(SequenceArray[job_index] != 0);
+                TEST_ASSERT(SequenceArray[job_index - LayerJobCount] < SequenceArray[job_index]);
+                TEST_ASSERT(SequenceArray[(layer - 1) * LayerJobCount + (i * 7 + 3) % LayerJobCount] < SequenceArray[job_index]);
+            }
+        }
+    }
+
+    /* Fibers on every core submit concurrently */
+    for (u32 i = 0; i < SubmitterCount; ++i) {
+        for (u32 job = 0; job < SubmitterJobCount; ++job) {
+            const u32 result6 = SubmitterGraphArray[i].AddJob(std::addressof(handle), TestCountJobMain, nullptr);
+            TEST_ASSERT(result6 == dd::ResultSuccess);
+        }
+    }
+    dd::ukern::UKernHandle submitter_handle_array[SubmitterCount] = {};
+    for (u32 i = 0; i < SubmitterCount; ++i) {
+        const u32 result7 = dd::ukern::CreateThread(std::addressof(submitter_handle_array[i]), TestSubmitterMain, i, 0x4000, THREAD_PRIORITY_NORMAL, i);
+        TEST_ASSERT(result7 == dd::ResultSuccess);
+        const u32 result8 = dd::ukern::StartThread(submitter_handle_array[i]);
+        TEST_ASSERT(result8 == dd::ResultSuccess);
+    }
+    for (u32 i = 0; i < SubmitterCount; ++i) {
+        dd::ukern::ExitThread(submitter_handle_array[i]);
+    }
+    TEST_ASSERT(SubmitterFailures == 0);
+    TEST_ASSERT(SubmitterJobCounter == SubmitterCount * SubmitterJobCount * SubmitCount);
+
+    /* Independent jobs run as roots */
+    const u32 result9 = dd::job::RunJobGraph(std::addressof(empty_graph));
+    TEST_ASSERT(result9 == dd::ResultSuccess);
+    TEST_ASSERT(empty_graph.IsComplete() == true);
+
+    dd::job::FinalizeJobSystem();
+    TEST_ASSERT(dd::job::GetJobWorkerCount() == 0);
+
+    TEST_SUCCESS;
+}
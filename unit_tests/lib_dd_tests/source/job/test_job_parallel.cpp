@@ -0,0 +1,97 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr size_t ElementCount = 100000;
+constexpr size_t Grain        = 256;
+
+struct IndexSpan {
+    size_t begin;
+    size_t end;
+    bool   is_contiguous;
+};
+
+std::atomic<u32> VisitArray[ElementCount] = {};
+u32              SortArray[ElementCount]  = {};
+
+int CheckParallel() {
+
+    /* Every index is visited once */
+    for (size_t i = 0; i < ElementCount; ++i) { VisitArray[i] = 0; }
+    dd::job::ParallelFor(0, ElementCount, Grain, [](size_t index) { VisitArray[index].fetch_add(1, std::memory_order_relaxed); });
+    for (size_t i = 0; i < ElementCount; ++i) { TEST_ASSERT(VisitArray[i] == 1); }
+
+    /* Ranges below the grain and empty ranges */
+    dd::job::ParallelFor(10, 20, Grain, [](size_t index) { VisitArray[index].fetch_add(1, std::memory_order_relaxed); });
+    TEST_ASSERT(VisitArray[9] == 1 && VisitArray[10] == 2 && VisitArray[19] == 2 && VisitArray[20] == 1);
+    dd::job::ParallelFor(20, 20, Grain, [](size_t index) { VisitArray[index].fetch_add(1, std::memory_order_relaxed); });
+    TEST_ASSERT(VisitArray[20] == 1);
+
+    /* Sum */
+    const u64 sum = dd::job::ParallelReduce(0, ElementCount, Grain, static_cast<u64>(0), [](size_t index) { return static_cast<u64>(index); }, [](u64 lhs, u64 rhs) { return lhs + rhs; });
+    TEST_ASSERT(sum == static_cast<u64>(ElementCount) * (ElementCount - 1) / 2);
+
+    /* Reduction order is kept for operators that don't commute */
+    const IndexSpan identity = { 0, 0, true };
+    const IndexSpan span     = dd::job::ParallelReduce(0, ElementCount, Grain, identity,
+        [](size_t index) { return IndexSpan{ index, index + 1, true }; },
+        [](const IndexSpan &lhs, const IndexSpan &rhs) {
+            if (lhs.begin == lhs.end) { return rhs; }
+            if (rhs.begin == rhs.end) { return lhs; }
+            return IndexSpan{ lhs.begin, rhs.end, lhs.is_contiguous && rhs.is_contiguous && lhs.end == rhs.begin };
+        });
+    TEST_ASSERT(span.begin == 0 && span.end == ElementCount && span.is_contiguous == true);
+
+    /* Random values with many duplicates */
+    u32 seed      = 0x1234'5678;
+    u64 value_sum = 0;
+    for (size_t i = 0; i < ElementCount; ++i) {
+        seed          = seed * 1664525 + 1013904223;
+        SortArray[i]  = (i & 1) ? (seed >> 8) : (seed >> 28);
+        value_sum    += SortArray[i];
+    }
+    dd::job::ParallelSort(SortArray, ElementCount, Grain);
+    u64 sorted_sum = SortArray[0];
+    for (size_t i = 1; i < ElementCount; ++i) {
+        TEST_ASSERT(SortArray[i - 1] <= SortArray[i]);
+        sorted_sum += SortArray[i];
+    }
+    TEST_ASSERT(sorted_sum == value_sum);
+
+    /* Descending with a comparator */
+    dd::job::ParallelSort(SortArray, ElementCount, Grain, [](u32 lhs, u32 rhs) { return rhs < lhs; });
+    for (size_t i = 1; i < ElementCount; ++i) { TEST_ASSERT(SortArray[i] <= SortArray[i - 1]); }
+
+    /* Already sorted and constant input */
+    dd::job::ParallelSort(SortArray, ElementCount, Grain);
+    for (size_t i = 1; i < ElementCount; ++i) { TEST_ASSERT(SortArray[i - 1] <= SortArray[i]); }
+    for (size_t i = 0; i < ElementCount; ++i) { SortArray[i] = 7; }
+    dd::job::ParallelSort(SortArray, ElementCount, Grain);
+    for (size_t i = 0; i < ElementCount; ++i) { TEST_ASSERT(SortArray[i] == 7); }
+
+    TEST_SUCCESS;
+}
+
+TEST(JobParallel) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(0b1111);
+
+    /* Runs serially without workers, failures return their line */
+    const int serial_line = CheckParallel();
+    if (serial_line != -1) { return serial_line; }
+
+    const u32 result0 = dd::job::InitializeJobSystem();
+    TEST_ASSERT(result0 == dd::ResultSuccess);
+
+    const int parallel_line = CheckParallel();
+    if (parallel_line != -1) { return parallel_line; }
+
+    dd::job::FinalizeJobSystem();
+
+    TEST_SUCCESS;
+}
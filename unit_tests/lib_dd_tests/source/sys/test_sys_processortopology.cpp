@@ -0,0 +1,41 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+TEST(ProcessorTopology) {
+
+    /* Query the OS topology */
+    dd::sys::ProcessorTopology topology = {};
+    dd::sys::QueryProcessorTopology(std::addressof(topology));
+
+    TEST_ASSERT(0 < topology.processor_count && topology.processor_count <= dd::sys::ProcessorTopology::MaxProcessorCount);
+    TEST_ASSERT(0 < topology.numa_node_count);
+    TEST_ASSERT(topology.GetDistance(0, 0) == dd::sys::ProcessorDistance_Self);
+
+    /* Domain ids are dense */
+    for (u32 i = 0; i < topology.processor_count; ++i) {
+        const dd::sys::ProcessorTopology::ProcessorInfo &info = topology.processor_info_array[i];
+        TEST_ASSERT(info.core_id   == dd::sys::ProcessorTopology::InvalidDomain || info.core_id   < topology.core_count);
+        TEST_ASSERT(info.l2_domain == dd::sys::ProcessorTopology::InvalidDomain || info.l2_domain < topology.l2_domain_count);
+        TEST_ASSERT(info.l3_domain == dd::sys::ProcessorTopology::InvalidDomain || info.l3_domain < topology.l3_domain_count);
+        TEST_ASSERT(info.numa_node == dd::sys::ProcessorTopology::InvalidDomain || info.numa_node < topology.numa_node_count);
+    }
+
+    /* Two SMT cores sharing an L2, two cores sharing only the L3 and one processor on a remote node */
+    dd::sys::ProcessorTopology synthetic = {};
+    synthetic.SetFlat(5);
+    synthetic.processor_info_array[0] = { 0, 0, 0, 0 };
+    synthetic.processor_info_array[1] = { 0, 0, 0, 0 };
+    synthetic.processor_info_array[2] = { 1, 0, 0, 0 };
+    synthetic.processor_info_array[3] = { 2, 1, 0, 0 };
+    synthetic.processor_info_array[4] = { 3, 2, 1, 1 };
+
+    TEST_ASSERT(synthetic.GetDistance(0, 1) == dd::sys::ProcessorDistance_SmtSibling);
+    TEST_ASSERT(synthetic.GetDistance(0, 2) == dd::sys::ProcessorDistance_SharedL2);
+    TEST_ASSERT(synthetic.GetDistance(0, 3) == dd::sys::ProcessorDistance_SharedL3);
+    TEST_ASSERT(synthetic.GetDistance(0, 4) == dd::sys::ProcessorDistance_Remote);
+    TEST_ASSERT(synthetic.GetDistance(0, 5) == dd::sys::ProcessorDistance_Remote);
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,63 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 WorkerCount = 8;
+constexpr u32 PhaseCount  = 200;
+
+dd::ukern::InternalBarrier PhaseBarrier(WorkerCount);
+u32                        PhaseArray[WorkerCount] = {};
+std::atomic<u32>           LastArrivalCount        = 0;
+std::atomic<u32>           PhaseViolations         = 0;
+
+void TestWorkerMain(void *arg) {
+
+    const u32 worker_index = reinterpret_cast<uintptr_t>(arg);
+
+    for (u32 phase = 1; phase <= PhaseCount; ++phase) {
+
+        /* Publish this phase */
+        std::atomic_ref<u32>(PhaseArray[worker_index]).store(phase);
+        if (((phase + worker_index) & 0x7) == 0) { dd::ukern::YieldThread(); }
+
+        if (PhaseBarrier.ArriveAndWait() == true) { LastArrivalCount.fetch_add(1); }
+
+        /* Every worker has published before anyone leaves */
+        for (u32 i = 0; i < WorkerCount; ++i) {
+            const u32 other_phase = std::atomic_ref<u32>(PhaseArray[i]).load();
+            if (other_phase != phase) { PhaseViolations.fetch_add(1); }
+        }
+
+        /* Nobody may publish the next phase until every worker has checked this one */
+        PhaseBarrier.ArriveAndWait();
+    }
+
+    return;
+}
+
+TEST(Barrier) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(0b1111);
+
+    dd::ukern::UKernHandle handle_array[WorkerCount] = {};
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(handle_array[i]), TestWorkerMain, i, 0x4000, THREAD_PRIORITY_NORMAL, i % 4);
+        TEST_ASSERT(result0 == dd::ResultSuccess);
+        const u32 result1 = dd::ukern::StartThread(handle_array[i]);
+        TEST_ASSERT(result1 == dd::ResultSuccess);
+    }
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        dd::ukern::ExitThread(handle_array[i]);
+    }
+
+    /* One last arrival per phase */
+    TEST_ASSERT(PhaseViolations == 0);
+    TEST_ASSERT(LastArrivalCount == PhaseCount);
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,111 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+#if defined(DD_PLATFORM_LINUX)
+    #include <ucontext.h>
+#endif
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32    RoundTripCount  = 1000000;
+constexpr size_t BenchStackSize  = 0x10000;
+
+/* Native fiber baseline (Win32 fibers, ucontext on linux) */
+#if defined(DD_PLATFORM_LINUX)
+    ucontext_t NativeMainContext  = {};
+    ucontext_t NativePingContext  = {};
+#else
+    void      *NativeMainContext  = nullptr;
+    void      *NativePingContext  = nullptr;
+#endif
+u32 NativePingCount = 0;
+
+#if defined(DD_PLATFORM_LINUX)
+    void NativePingMain() {
+        for (;;) {
+            ++NativePingCount;
+            ::swapcontext(std::addressof(NativePingContext), std::addressof(NativeMainContext));
+        }
+    }
+#else
+    void NativePingMain(void *) {
+        for (;;) {
+            ++NativePingCount;
+            ::SwitchToFiber(NativeMainContext);
+        }
+    }
+#endif
+
+/* ukern fiber context */
+dd::ukern::impl::FiberContext ContextMainContext = nullptr;
+dd::ukern::impl::FiberContext ContextPingContext = nullptr;
+u32 ContextPingCount = 0;
+
+void ContextPingMain(void *) {
+    for (;;) {
+        ++ContextPingCount;
+        dd::ukern::impl::SwitchToFiberContext(ContextMainContext);
+    }
+}
+
+ALWAYS_INLINE double NanoSecondsPerSwitch(s64 start_tick, s64 end_tick) {
+    const s64 ns = dd::TimeSpan::FromTick(end_tick - start_tick).GetNanoSeconds();
+    return static_cast<double>(ns) / static_cast<double>(RoundTripCount * 2);
+}
+
+TEST(BenchmarkContextSwitch) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Native fiber round trips */
+    #if defined(DD_PLATFORM_LINUX)
+        void *native_stack = ::malloc(BenchStackSize);
+        ::getcontext(std::addressof(NativePingContext));
+        NativePingContext.uc_stack.ss_sp   = native_stack;
+        NativePingContext.uc_stack.ss_size = BenchStackSize;
+        NativePingContext.uc_link          = nullptr;
+        ::makecontext(std::addressof(NativePingContext), NativePingMain, 0);
+    #else
+        NativeMainContext = ::ConvertThreadToFiber(nullptr);
+        NativePingContext = ::CreateFiber(BenchStackSize, NativePingMain, nullptr);
+    #endif
+
+    const s64 native_start = dd::util::GetSystemTick();
+    for (u32 i = 0; i < RoundTripCount; ++i) {
+        #if defined(DD_PLATFORM_LINUX)
+            ::swapcontext(std::addressof(NativeMainContext), std::addressof(NativePingContext));
+        #else
+            ::SwitchToFiber(NativePingContext);
+        #endif
+    }
+    const s64 native_end = dd::util::GetSystemTick();
+
+    #if defined(DD_PLATFORM_LINUX)
+        ::free(native_stack);
+    #else
+        ::DeleteFiber(NativePingContext);
+        ::ConvertFiberToThread();
+    #endif
+
+    TEST_ASSERT(NativePingCount == RoundTripCount);
+
+    /* ukern fiber context round trips */
+    ContextMainContext = dd::ukern::impl::ConvertThreadToFiberContext(nullptr);
+    ContextPingContext = dd::ukern::impl::CreateFiberContext(BenchStackSize, ContextPingMain, nullptr);
+    TEST_ASSERT(ContextPingContext != nullptr);
+
+    const s64 context_start = dd::util::GetSystemTick();
+    for (u32 i = 0; i < RoundTripCount; ++i) {
+        dd::ukern::impl::SwitchToFiberContext(ContextPingContext);
+    }
+    const s64 context_end = dd::util::GetSystemTick();
+
+    dd::ukern::impl::DeleteFiberContext(ContextPingContext);
+
+    TEST_ASSERT(ContextPingCount == RoundTripCount);
+
+    /* Report */
+    ::printf("context switch: native %.2f ns/switch, ukern %.2f ns/switch\n", NanoSecondsPerSwitch(native_start, native_end), NanoSecondsPerSwitch(context_start, context_end));
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,71 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 BenchCoreCount   = 4;
+constexpr u32 PendingCount     = 2048;
+constexpr u32 FiberStackSize   = 0x4000;
+
+/* Pending waits parked on a latch, as a fiber each or as a stackless task each */
+dd::ukern::UKernHandle HandleArray[PendingCount] = {};
+dd::ukern::Task<void>  TaskArray[PendingCount];
+std::atomic<u32>       CompletedCount = 0;
+
+void BenchFiberWaiterMain(void *arg) {
+    reinterpret_cast<dd::ukern::InternalLatch*>(arg)->Wait();
+    CompletedCount.fetch_add(1);
+}
+
+dd::ukern::Task<void> BenchTaskWaiterAsync(dd::ukern::InternalLatch *latch) {
+    co_await latch->WaitAsync();
+    CompletedCount.fetch_add(1);
+}
+
+TEST(BenchmarkCoroutine) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(dd::ukern::UKernCoreMask::MakeLowBits(BenchCoreCount));
+
+    const u32 result0 = dd::ukern::StartCoroutineRunners();
+    TEST_ASSERT(result0 == dd::ResultSuccess);
+
+    /* Park every fiber, then release them all */
+    dd::ukern::InternalLatch fiber_latch(1);
+    const s64 fiber_start_tick = dd::util::GetSystemTick();
+    for (u32 i = 0; i < PendingCount; ++i) {
+        const u32 result1 = dd::ukern::CreateThread(std::addressof(HandleArray[i]), BenchFiberWaiterMain, reinterpret_cast<uintptr_t>(std::addressof(fiber_latch)), FiberStackSize, THREAD_PRIORITY_NORMAL, i % BenchCoreCount);
+        TEST_ASSERT(result1 == dd::ResultSuccess);
+        const u32 result2 = dd::ukern::StartThread(HandleArray[i]);
+        TEST_ASSERT(result2 == dd::ResultSuccess);
+    }
+    fiber_latch.CountDown();
+    for (u32 i = 0; i < PendingCount; ++i) {
+        dd::ukern::ExitThread(HandleArray[i]);
+    }
+    const s64 fiber_end_tick = dd::util::GetSystemTick();
+    TEST_ASSERT(CompletedCount == PendingCount);
+
+    /* Park every task, then release them all */
+    dd::ukern::InternalLatch task_latch(1);
+    const s64 task_start_tick = dd::util::GetSystemTick();
+    for (u32 i = 0; i < PendingCount; ++i) {
+        TaskArray[i] = BenchTaskWaiterAsync(std::addressof(task_latch));
+        TaskArray[i].Start();
+    }
+    task_latch.CountDown();
+    for (u32 i = 0; i < PendingCount; ++i) {
+        TaskArray[i].Wait();
+    }
+    const s64 task_end_tick = dd::util::GetSystemTick();
+    TEST_ASSERT(CompletedCount == PendingCount * 2);
+
+    dd::ukern::ExitCoroutineRunners();
+
+    ::printf("Pending waits: %u waiters, fibers %.2f us (%u KiB of stack), tasks %.2f us (no stack)\n", PendingCount, static_cast<double>(dd::TimeSpan::FromTick(fiber_end_tick - fiber_start_tick).GetNanoSeconds()) / 1000.0, (PendingCount * FiberStackSize) / 1024, static_cast<double>(dd::TimeSpan::FromTick(task_end_tick - task_start_tick).GetNanoSeconds()) / 1000.0);
+
+    TEST_SUCCESS;
+}
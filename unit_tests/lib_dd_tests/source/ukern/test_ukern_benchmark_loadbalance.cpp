@@ -0,0 +1,118 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 BenchCoreCount  = 4;
+constexpr u32 WorkerCount     = 32;
+constexpr u32 WorkChunkCount  = 200;
+constexpr u32 WorkChunkLength = 20000;
+
+enum Placement : u32 {
+    Placement_CoreZero,
+    Placement_Balanced,
+    Placement_Count
+};
+
+std::atomic<u32> CompletedWorkers[Placement_Count]              = {};
+std::atomic<u32> CoreChunkCount[Placement_Count][BenchCoreCount] = {};
+std::atomic<u32> WorkSink                                       = 0;
+
+void BenchWorkerMain(void *arg) {
+
+    const u32 placement = reinterpret_cast<uintptr_t>(arg);
+
+    u32 seed = placement + 1;
+    for (u32 i = 0; i < WorkChunkCount; ++i) {
+
+        /* Burn a chunk of cpu time */
+        for (u32 j = 0; j < WorkChunkLength; ++j) {
+            seed = seed * 1664525 + 1013904223;
+        }
+
+        /* Record which core did the chunk */
+        const u32 current_core = dd::ukern::GetCurrentThread()->current_core;
+        CoreChunkCount[placement][current_core].fetch_add(1, std::memory_order_relaxed);
+
+        /* Let the scheduler rebalance between chunks */
+        dd::ukern::YieldThread();
+    }
+
+    WorkSink.fetch_add(seed, std::memory_order_relaxed);
+    CompletedWorkers[placement].fetch_add(1);
+
+    return;
+}
+
+s64 RunPlacement(u32 placement) {
+
+    const s64 start_tick = dd::util::GetSystemTick();
+
+    /* Every worker starts on core 0, as CreateThreadImpl places them */
+    dd::ukern::UKernHandle handle_array[WorkerCount] = {};
+    for (u32 i = 0; i < WorkerCount; ++i) {
+
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(handle_array[i]), BenchWorkerMain, placement, 0x4000, THREAD_PRIORITY_NORMAL, 0);
+        if (result0 != dd::ResultSuccess) { return -1; }
+
+        if (placement == Placement_Balanced) {
+            const u32 result1 = dd::ukern::SetThreadCoreMask(handle_array[i], dd::ukern::UKernCoreMask::MakeLowBits(BenchCoreCount));
+            if (result1 != dd::ResultSuccess) { return -1; }
+        }
+
+        const u32 result2 = dd::ukern::StartThread(handle_array[i]);
+        if (result2 != dd::ResultSuccess) { return -1; }
+    }
+
+    const u32 result3 = dd::ukern::JoinThreads(handle_array, WorkerCount, dd::TimeSpan::FromSeconds(60));
+    if (result3 != dd::ResultSuccess) { return -1; }
+
+    const s64 end_tick = dd::util::GetSystemTick();
+
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        dd::ukern::ExitThread(handle_array[i]);
+    }
+
+    return dd::TimeSpan::FromTick(end_tick - start_tick).GetNanoSeconds();
+}
+
+void PrintPlacement(const char *name, u32 placement, s64 time_ns) {
+    ::printf("SchedulerLoadBalance: %-9s %8.2f ms, chunks per core", name, static_cast<double>(time_ns) / 1000000.0);
+    for (u32 i = 0; i < BenchCoreCount; ++i) {
+        ::printf(" %u", CoreChunkCount[placement][i].load());
+    }
+    ::printf("\n");
+}
+
+TEST(BenchmarkSchedulerLoadBalance) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(dd::ukern::UKernCoreMask::MakeLowBits(BenchCoreCount));
+
+    /* Workers kept on core 0 are the baseline, balanced workers may be placed on or stolen by any core */
+    const s64 core_zero_ns = RunPlacement(Placement_CoreZero);
+    TEST_ASSERT(0 <= core_zero_ns);
+
+    const s64 balanced_ns = RunPlacement(Placement_Balanced);
+    TEST_ASSERT(0 <= balanced_ns);
+
+    TEST_ASSERT(CompletedWorkers[Placement_CoreZero] == WorkerCount && CompletedWorkers[Placement_Balanced] == WorkerCount);
+
+    /* The baseline must never leave core 0, the balanced run should spread out */
+    TEST_ASSERT(CoreChunkCount[Placement_CoreZero][0] == WorkerCount * WorkChunkCount);
+
+    u32 busy_core_count = 0;
+    for (u32 i = 0; i < BenchCoreCount; ++i) {
+        if (CoreChunkCount[Placement_Balanced][i] != 0) { ++busy_core_count; }
+    }
+    TEST_ASSERT(1 < busy_core_count);
+
+    /* Report */
+    PrintPlacement("core zero", Placement_CoreZero, core_zero_ns);
+    PrintPlacement("balanced",  Placement_Balanced, balanced_ns);
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,141 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 BenchCoreCount = 4;
+constexpr u32 WorkerCount    = 16;
+constexpr u32 WorkIterations = 16384;
+constexpr u32 WriteInterval  = 64;
+constexpr u32 TableSize      = 64;
+
+u32              LookupTable[TableSize] = {};
+std::atomic<u32> WorkSink               = 0;
+std::atomic<u32> CompletedWorkers       = 0;
+
+dd::ukern::InternalCriticalSection  TableCriticalSection = {};
+dd::ukern::InternalReaderWriterLock TableLock            = {};
+
+/* Readers hash the table, writers bump one entry */
+ALWAYS_INLINE u32 ReadTable() {
+    u32 hash = 0;
+    for (u32 i = 0; i < TableSize; ++i) {
+        hash = (hash * 31) + LookupTable[i];
+    }
+    return hash;
+}
+
+ALWAYS_INLINE void WriteTable(u32 index) {
+    LookupTable[index % TableSize] = LookupTable[index % TableSize] + 1;
+}
+
+void BenchCriticalSectionMain(void *arg) {
+
+    const u32 worker_index = reinterpret_cast<uintptr_t>(arg);
+
+    u32 sink = 0;
+    for (u32 i = 0; i < WorkIterations; ++i) {
+        std::scoped_lock l(TableCriticalSection);
+        if (((i + worker_index) % WriteInterval) == 0) {
+            WriteTable(i);
+        } else {
+            sink += ReadTable();
+        }
+    }
+
+    WorkSink.fetch_add(sink, std::memory_order_relaxed);
+    CompletedWorkers.fetch_add(1);
+
+    return;
+}
+
+void BenchReaderWriterLockMain(void *arg) {
+
+    const u32 worker_index = reinterpret_cast<uintptr_t>(arg);
+
+    u32 sink = 0;
+    for (u32 i = 0; i < WorkIterations; ++i) {
+        if (((i + worker_index) % WriteInterval) == 0) {
+            TableLock.Enter();
+            WriteTable(i);
+            TableLock.Leave();
+        } else {
+            TableLock.EnterShared();
+            sink += ReadTable();
+            TableLock.LeaveShared();
+        }
+    }
+
+    WorkSink.fetch_add(sink, std::memory_order_relaxed);
+    CompletedWorkers.fetch_add(1);
+
+    return;
+}
+
+s64 RunWorkers(dd::ukern::ThreadFunction worker_main) {
+
+    const s64 start_tick = dd::util::GetSystemTick();
+
+    dd::ukern::UKernHandle handle_array[WorkerCount] = {};
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(handle_array[i]), worker_main, i, 0x4000, THREAD_PRIORITY_NORMAL, i % BenchCoreCount);
+        if (result0 != dd::ResultSuccess) { return -1; }
+        const u32 result1 = dd::ukern::StartThread(handle_array[i]);
+        if (result1 != dd::ResultSuccess) { return -1; }
+    }
+
+    const u32 result2 = dd::ukern::JoinThreads(handle_array, WorkerCount, dd::TimeSpan::FromSeconds(60));
+    if (result2 != dd::ResultSuccess) { return -1; }
+
+    const s64 end_tick = dd::util::GetSystemTick();
+
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        dd::ukern::ExitThread(handle_array[i]);
+    }
+
+    return dd::TimeSpan::FromTick(end_tick - start_tick).GetNanoSeconds();
+}
+
+TEST(BenchmarkReaderWriterLock) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(dd::ukern::UKernCoreMask::MakeLowBits(BenchCoreCount));
+
+    /* Uncontended cost of each lock */
+    constexpr u32 UncontendedCount = 1000000;
+    const s64 cs_start_tick = dd::util::GetSystemTick();
+    for (u32 i = 0; i < UncontendedCount; ++i) {
+        TableCriticalSection.Enter();
+        TableCriticalSection.Leave();
+    }
+    const s64 rw_start_tick = dd::util::GetSystemTick();
+    for (u32 i = 0; i < UncontendedCount; ++i) {
+        TableLock.EnterShared();
+        TableLock.LeaveShared();
+    }
+    const s64 rw_end_tick = dd::util::GetSystemTick();
+
+    /* Read mostly contention */
+    const s64 critical_section_ns = RunWorkers(BenchCriticalSectionMain);
+    TEST_ASSERT(0 <= critical_section_ns);
+
+    const s64 reader_writer_ns = RunWorkers(BenchReaderWriterLockMain);
+    TEST_ASSERT(0 <= reader_writer_ns);
+
+    TEST_ASSERT(CompletedWorkers == WorkerCount * 2);
+
+    /* Every write landed exactly once */
+    u32 write_total = 0;
+    for (u32 i = 0; i < TableSize; ++i) {
+        write_total += LookupTable[i];
+    }
+    TEST_ASSERT(write_total == 2 * WorkerCount * WorkIterations / WriteInterval);
+
+    ::printf("ReaderWriterLock: uncontended critical section %.2f ns, shared %.2f ns\n", static_cast<double>(dd::TimeSpan::FromTick(rw_start_tick - cs_start_tick).GetNanoSeconds()) / UncontendedCount, static_cast<double>(dd::TimeSpan::FromTick(rw_end_tick - rw_start_tick).GetNanoSeconds()) / UncontendedCount);
+    ::printf("ReaderWriterLock: %u fibers, 1 in %u writes, critical section %.2f ms, reader writer lock %.2f ms\n", WorkerCount, WriteInterval, static_cast<double>(critical_section_ns) / 1000000.0, static_cast<double>(reader_writer_ns) / 1000000.0);
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,192 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 BenchCoreCount   = 4;
+constexpr u32 UncontendedCount = 1000000;
+constexpr u32 PhaseCount       = 100;
+constexpr u32 ForkCount        = 16;
+constexpr u32 JoinRoundCount   = 50;
+
+/* Critical section and condition variable equivalents */
+class CsSemaphore {
+    private:
+        dd::ukern::InternalCriticalSection   m_cs;
+        dd::ukern::InternalConditionVariable m_cv;
+        u32                                  m_count;
+    public:
+        constexpr CsSemaphore(u32 initial_count) : m_cs(), m_cv(), m_count(initial_count) {/*...*/}
+
+        void Acquire() {
+            std::scoped_lock l(m_cs);
+            while (m_count == 0) { m_cv.Wait(std::addressof(m_cs)); }
+            m_count = m_count - 1;
+        }
+        void Release() {
+            std::scoped_lock l(m_cs);
+            m_count = m_count + 1;
+            m_cv.Signal();
+        }
+};
+
+class CsBarrier {
+    private:
+        dd::ukern::InternalCriticalSection   m_cs;
+        dd::ukern::InternalConditionVariable m_cv;
+        u32                                  m_expected_count;
+        u32                                  m_arrived_count;
+        u32                                  m_phase;
+    public:
+        constexpr CsBarrier(u32 expected_count) : m_cs(), m_cv(), m_expected_count(expected_count), m_arrived_count(0), m_phase(0) {/*...*/}
+
+        void ArriveAndWait() {
+            std::scoped_lock l(m_cs);
+            const u32 arrive_phase = m_phase;
+            m_arrived_count = m_arrived_count + 1;
+            if (m_arrived_count == m_expected_count) {
+                m_arrived_count = 0;
+                m_phase         = m_phase + 1;
+                m_cv.Broadcast();
+                return;
+            }
+            while (m_phase == arrive_phase) { m_cv.Wait(std::addressof(m_cs)); }
+        }
+};
+
+class CsLatch {
+    private:
+        dd::ukern::InternalCriticalSection   m_cs;
+        dd::ukern::InternalConditionVariable m_cv;
+        u32                                  m_count;
+    public:
+        constexpr CsLatch(u32 expected_count) : m_cs(), m_cv(), m_count(expected_count) {/*...*/}
+
+        void CountDown() {
+            std::scoped_lock l(m_cs);
+            m_count = m_count - 1;
+            if (m_count == 0) { m_cv.Broadcast(); }
+        }
+        void Wait() {
+            std::scoped_lock l(m_cs);
+            while (m_count != 0) { m_cv.Wait(std::addressof(m_cs)); }
+        }
+};
+
+CsBarrier                  BenchCsBarrier(BenchCoreCount);
+dd::ukern::InternalBarrier BenchBarrier(BenchCoreCount);
+
+void BenchCsBarrierMain(void *) {
+    for (u32 i = 0; i < PhaseCount; ++i) { BenchCsBarrier.ArriveAndWait(); }
+    return;
+}
+
+void BenchBarrierMain(void *) {
+    for (u32 i = 0; i < PhaseCount; ++i) { BenchBarrier.ArriveAndWait(); }
+    return;
+}
+
+void BenchCsLatchMain(void *arg) {
+    reinterpret_cast<CsLatch*>(arg)->CountDown();
+    return;
+}
+
+void BenchLatchMain(void *arg) {
+    reinterpret_cast<dd::ukern::InternalLatch*>(arg)->CountDown();
+    return;
+}
+
+s64 RunPhases(dd::ukern::ThreadFunction worker_main) {
+
+    const s64 start_tick = dd::util::GetSystemTick();
+
+    /* One fiber per core */
+    dd::ukern::UKernHandle handle_array[BenchCoreCount] = {};
+    for (u32 i = 0; i < BenchCoreCount; ++i) {
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(handle_array[i]), worker_main, 0, 0x4000, THREAD_PRIORITY_NORMAL, i);
+        if (result0 != dd::ResultSuccess) { return -1; }
+        const u32 result1 = dd::ukern::StartThread(handle_array[i]);
+        if (result1 != dd::ResultSuccess) { return -1; }
+    }
+
+    const u32 result2 = dd::ukern::JoinThreads(handle_array, BenchCoreCount, dd::TimeSpan::FromSeconds(60));
+    if (result2 != dd::ResultSuccess) { return -1; }
+
+    const s64 end_tick = dd::util::GetSystemTick();
+
+    for (u32 i = 0; i < BenchCoreCount; ++i) {
+        dd::ukern::ExitThread(handle_array[i]);
+    }
+
+    return dd::TimeSpan::FromTick(end_tick - start_tick).GetNanoSeconds();
+}
+
+template<typename Latch>
+s64 RunForkJoin(dd::ukern::ThreadFunction worker_main) {
+
+    const s64 start_tick = dd::util::GetSystemTick();
+
+    for (u32 round = 0; round < JoinRoundCount; ++round) {
+
+        /* Fork, then join on the latch */
+        Latch latch(ForkCount);
+        dd::ukern::UKernHandle handle_array[ForkCount] = {};
+        for (u32 i = 0; i < ForkCount; ++i) {
+            const u32 result0 = dd::ukern::CreateThread(std::addressof(handle_array[i]), worker_main, reinterpret_cast<uintptr_t>(std::addressof(latch)), 0x4000, THREAD_PRIORITY_NORMAL, i % BenchCoreCount);
+            if (result0 != dd::ResultSuccess) { return -1; }
+            const u32 result1 = dd::ukern::StartThread(handle_array[i]);
+            if (result1 != dd::ResultSuccess) { return -1; }
+        }
+        latch.Wait();
+
+        for (u32 i = 0; i < ForkCount; ++i) {
+            dd::ukern::ExitThread(handle_array[i]);
+        }
+    }
+
+    return dd::TimeSpan::FromTick(dd::util::GetSystemTick() - start_tick).GetNanoSeconds();
+}
+
+TEST(BenchmarkSemaphoreLatchBarrier) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(dd::ukern::UKernCoreMask::MakeLowBits(BenchCoreCount));
+
+    /* Uncontended acquire and release */
+    CsSemaphore                  cs_semaphore(1);
+    dd::ukern::InternalSemaphore semaphore(1);
+
+    const s64 cs_start_tick = dd::util::GetSystemTick();
+    for (u32 i = 0; i < UncontendedCount; ++i) {
+        cs_semaphore.Acquire();
+        cs_semaphore.Release();
+    }
+    const s64 start_tick = dd::util::GetSystemTick();
+    for (u32 i = 0; i < UncontendedCount; ++i) {
+        semaphore.Acquire();
+        semaphore.Release();
+    }
+    const s64 end_tick = dd::util::GetSystemTick();
+    TEST_ASSERT(semaphore.GetCount() == 1);
+
+    /* Phases across every core */
+    const s64 cs_barrier_ns = RunPhases(BenchCsBarrierMain);
+    TEST_ASSERT(0 <= cs_barrier_ns);
+    const s64 barrier_ns = RunPhases(BenchBarrierMain);
+    TEST_ASSERT(0 <= barrier_ns);
+
+    /* Fork and join */
+    const s64 cs_latch_ns = RunForkJoin<CsLatch>(BenchCsLatchMain);
+    TEST_ASSERT(0 <= cs_latch_ns);
+    const s64 latch_ns = RunForkJoin<dd::ukern::InternalLatch>(BenchLatchMain);
+    TEST_ASSERT(0 <= latch_ns);
+
+    ::printf("Semaphore: uncontended cs+cv %.2f ns, semaphore %.2f ns\n", static_cast<double>(dd::TimeSpan::FromTick(start_tick - cs_start_tick).GetNanoSeconds()) / UncontendedCount, static_cast<double>(dd::TimeSpan::FromTick(end_tick - start_tick).GetNanoSeconds()) / UncontendedCount);
+    ::printf("Barrier: %u cores, cs+cv %.2f us, barrier %.2f us per phase\n", BenchCoreCount, static_cast<double>(cs_barrier_ns) / (1000.0 * PhaseCount), static_cast<double>(barrier_ns) / (1000.0 * PhaseCount));
+    ::printf("Latch: %u fibers, cs+cv %.2f us, latch %.2f us per fork join\n", ForkCount, static_cast<double>(cs_latch_ns) / (1000.0 * JoinRoundCount), static_cast<double>(latch_ns) / (1000.0 * JoinRoundCount));
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,130 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 WorkerCount    = 4;
+constexpr u32 CoroutineCount = 1000;
+constexpr u32 PermitCount    = 200;
+
+dd::ukern::InternalLatch     StartLatch(1);
+dd::ukern::InternalLatch     FiberDoneLatch(WorkerCount);
+dd::ukern::InternalSemaphore PermitSemaphore(0);
+std::atomic<u32>             ResumedCount  = 0;
+std::atomic<u32>             AcquiredCount = 0;
+u32                          TimeoutWord   = 0;
+
+dd::ukern::Task<u32> AddAsync(u32 lhs, u32 rhs) {
+    co_await dd::ukern::YieldAsync();
+    co_return lhs + rhs;
+}
+
+dd::ukern::Task<u32> SumAsync(u32 count) {
+    u32 sum = 0;
+    for (u32 i = 0; i < count; ++i) {
+        sum = co_await AddAsync(sum, i);
+    }
+    co_return sum;
+}
+
+dd::ukern::Task<void> LatchWaiterAsync() {
+    co_await StartLatch.WaitAsync();
+    ResumedCount.fetch_add(1);
+}
+
+dd::ukern::Task<void> PermitTakerAsync() {
+    const bool is_acquired = co_await PermitSemaphore.AcquireAsync();
+    if (is_acquired == true) { AcquiredCount.fetch_add(1); }
+}
+
+dd::ukern::Task<dd::Result> TimeoutAsync() {
+    co_return co_await dd::ukern::WaitForAddressIfEqualAsync(std::addressof(TimeoutWord), 0, dd::TimeSpan::FromMilliSeconds(2).GetNanoSeconds());
+}
+
+dd::ukern::Task<dd::Result> MismatchAsync() {
+    co_return co_await dd::ukern::WaitForAddressIfEqualAsync(std::addressof(TimeoutWord), 1);
+}
+
+void TestWorkerMain(void *) {
+
+    /* Fibers release permits for coroutines */
+    for (u32 i = 0; i < PermitCount / WorkerCount; ++i) {
+        PermitSemaphore.Release();
+        dd::ukern::YieldThread();
+    }
+
+    FiberDoneLatch.CountDown();
+
+    return;
+}
+
+dd::ukern::Task<void> TaskArray[CoroutineCount];
+
+TEST(Coroutine) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(0b1111);
+
+    const u32 result0 = dd::ukern::StartCoroutineRunners();
+    TEST_ASSERT(result0 == dd::ResultSuccess);
+
+    /* Nested tasks transfer to their awaiter, a fiber waits on the outer task */
+    dd::ukern::Task<u32> sum_task = SumAsync(100);
+    sum_task.Wait();
+    TEST_ASSERT(sum_task.IsComplete() == true);
+    TEST_ASSERT(sum_task.GetResult() == 4950);
+
+    /* Address waits time out and check their value */
+    dd::ukern::Task<dd::Result> timeout_task = TimeoutAsync();
+    timeout_task.Wait();
+    TEST_ASSERT(timeout_task.GetResult() == dd::ukern::ResultTimeout);
+    dd::ukern::Task<dd::Result> mismatch_task = MismatchAsync();
+    mismatch_task.Wait();
+    TEST_ASSERT(mismatch_task.GetResult() == dd::ukern::ResultInvalidWaitAddressValue);
+
+    /* Coroutines wait on a latch opened by a fiber */
+    for (u32 i = 0; i < CoroutineCount; ++i) {
+        TaskArray[i] = LatchWaiterAsync();
+        TaskArray[i].Start();
+    }
+    dd::ukern::Sleep(dd::TimeSpan::FromMilliSeconds(1));
+    TEST_ASSERT(ResumedCount == 0);
+
+    StartLatch.CountDown();
+    for (u32 i = 0; i < CoroutineCount; ++i) {
+        TaskArray[i].Wait();
+    }
+    TEST_ASSERT(ResumedCount == CoroutineCount);
+
+    /* Coroutines take permits released by fibers */
+    for (u32 i = 0; i < PermitCount; ++i) {
+        TaskArray[i] = PermitTakerAsync();
+        TaskArray[i].Start();
+    }
+
+    dd::ukern::UKernHandle handle_array[WorkerCount] = {};
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        const u32 result1 = dd::ukern::CreateThread(std::addressof(handle_array[i]), TestWorkerMain, i, 0x4000, THREAD_PRIORITY_NORMAL, i);
+        TEST_ASSERT(result1 == dd::ResultSuccess);
+        const u32 result2 = dd::ukern::StartThread(handle_array[i]);
+        TEST_ASSERT(result2 == dd::ResultSuccess);
+    }
+
+    FiberDoneLatch.Wait();
+    for (u32 i = 0; i < PermitCount; ++i) {
+        TaskArray[i].Wait();
+    }
+    TEST_ASSERT(AcquiredCount == PermitCount);
+    TEST_ASSERT(PermitSemaphore.GetCount() == 0);
+
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        dd::ukern::ExitThread(handle_array[i]);
+    }
+
+    dd::ukern::ExitCoroutineRunners();
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,95 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 NormalFiberCount = 3;
+constexpr s64 NormalSpinTimeMs = 20;
+
+dd::ukern::InternalCriticalSection SharedCriticalSection = {};
+volatile u32                       LowHoldsLock          = 0;
+volatile u32                       NormalDoneCount       = 0;
+volatile u32                       HighAcquireNormalDone = 0xffff'ffff;
+
+void TestLowPriorityMain(void *) {
+
+    /* Hold the lock across a sleep, so it must be rescheduled to release it */
+    SharedCriticalSection.Enter();
+    LowHoldsLock = 1;
+    dd::ukern::Sleep(dd::TimeSpan::FromMilliSeconds(1));
+    SharedCriticalSection.Leave();
+
+    return;
+}
+
+void TestHighPriorityMain(void *) {
+
+    /* Block on the low priority owner, lending it our priority */
+    SharedCriticalSection.Enter();
+    HighAcquireNormalDone = NormalDoneCount;
+    SharedCriticalSection.Leave();
+
+    return;
+}
+
+void TestNormalPriorityMain(void *) {
+
+    /* Keep the core busy above the low priority owner's base priority */
+    const s64 start = dd::util::GetSystemTick();
+    while (dd::TimeSpan::FromTick(dd::util::GetSystemTick() - start).GetMilliSeconds() < NormalSpinTimeMs) {
+        dd::ukern::YieldThread();
+    }
+    NormalDoneCount = NormalDoneCount + 1;
+
+    return;
+}
+
+TEST(CriticalSectionPriorityInheritance) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Use one core so priorities decide who runs */
+    dd::ukern::UKernCoreMask core_mask = 1;
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(core_mask);
+
+    /* Let the low priority fiber take the lock */
+    dd::ukern::UKernHandle low_handle = 0;
+    const u32 result0 = dd::ukern::CreateThread(std::addressof(low_handle), TestLowPriorityMain, 0, 0x4000, THREAD_PRIORITY_LOWEST, 0);
+    TEST_ASSERT(result0 == dd::ResultSuccess);
+    const u32 result1 = dd::ukern::StartThread(low_handle);
+    TEST_ASSERT(result1 == dd::ResultSuccess);
+    while (LowHoldsLock == 0) {
+        dd::ukern::Sleep(dd::TimeSpan::FromMicroSeconds(100));
+    }
+
+    /* Start normal priority fibers that would starve the owner */
+    dd::ukern::UKernHandle normal_handle_array[NormalFiberCount] = {};
+    for (u32 i = 0; i < NormalFiberCount; ++i) {
+        const u32 result2 = dd::ukern::CreateThread(std::addressof(normal_handle_array[i]), TestNormalPriorityMain, 0, 0x4000, THREAD_PRIORITY_NORMAL, 0);
+        TEST_ASSERT(result2 == dd::ResultSuccess);
+        const u32 result3 = dd::ukern::StartThread(normal_handle_array[i]);
+        TEST_ASSERT(result3 == dd::ResultSuccess);
+    }
+
+    /* Start the high priority fiber, it blocks on the lock straight away */
+    dd::ukern::UKernHandle high_handle = 0;
+    const u32 result4 = dd::ukern::CreateThread(std::addressof(high_handle), TestHighPriorityMain, 0, 0x4000, THREAD_PRIORITY_HIGHEST, 0);
+    TEST_ASSERT(result4 == dd::ResultSuccess);
+    const u32 result5 = dd::ukern::StartThread(high_handle);
+    TEST_ASSERT(result5 == dd::ResultSuccess);
+
+    /* Wait for everyone */
+    const u32 result6 = dd::ukern::JoinThread(high_handle, dd::TimeSpan::FromSeconds(5));
+    TEST_ASSERT(result6 == dd::ResultSuccess);
+    const u32 result7 = dd::ukern::JoinThreads(normal_handle_array, NormalFiberCount, dd::TimeSpan::FromSeconds(5));
+    TEST_ASSERT(result7 == dd::ResultSuccess);
+    dd::ukern::ExitThread(low_handle);
+
+    /* The boosted owner must have released the lock before the normal fibers finished */
+    TEST_ASSERT(HighAcquireNormalDone == 0);
+
+    TEST_SUCCESS;
+}
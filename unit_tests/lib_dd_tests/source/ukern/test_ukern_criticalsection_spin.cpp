@@ -0,0 +1,66 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 WorkerCount    = 4;
+constexpr u32 WorkIterations = 20000;
+
+dd::ukern::InternalCriticalSection SharedCriticalSection = {};
+u32                                SharedCounter         = 0;
+std::atomic<u32>                   OwnershipViolations   = 0;
+
+void TestSpinWorkerMain(void *) {
+
+    for (u32 i = 0; i < WorkIterations; ++i) {
+        SharedCriticalSection.Enter();
+
+        /* Short hold so contenders usually acquire in the spin phase */
+        if (SharedCriticalSection.IsLockedByCurrentThread() == false) { OwnershipViolations.fetch_add(1); }
+        SharedCounter = SharedCounter + 1;
+
+        SharedCriticalSection.Leave();
+
+        /* Occasionally hold across a yield so spinners must fall back to arbitration */
+        if ((i & 0xff) == 0) {
+            SharedCriticalSection.Enter();
+            dd::ukern::YieldThread();
+            SharedCounter = SharedCounter + 1;
+            SharedCriticalSection.Leave();
+        }
+    }
+
+    return;
+}
+
+TEST(CriticalSectionSpinContention) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Use four cores */
+    dd::ukern::UKernCoreMask core_mask = 0b1111;
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(core_mask);
+
+    /* Create a worker per core */
+    dd::ukern::UKernHandle handle_array[WorkerCount] = {};
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(handle_array[i]), TestSpinWorkerMain, 0, 0x4000, THREAD_PRIORITY_NORMAL, i);
+        TEST_ASSERT(result0 == dd::ResultSuccess);
+        const u32 result1 = dd::ukern::StartThread(handle_array[i]);
+        TEST_ASSERT(result1 == dd::ResultSuccess);
+    }
+
+    /* Wait for all workers */
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        dd::ukern::ExitThread(handle_array[i]);
+    }
+
+    /* Ensure mutual exclusion held */
+    TEST_ASSERT(OwnershipViolations == 0);
+    TEST_ASSERT(SharedCounter == WorkerCount * (WorkIterations + (WorkIterations + 0xff) / 0x100));
+
+    TEST_SUCCESS;
+}
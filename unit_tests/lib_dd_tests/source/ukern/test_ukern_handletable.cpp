@@ -55,46 +55,80 @@ TEST(HandleTableAllocation) {
     TEST_ASSERT(handle_table.GetObjectByHandle(handle1) == nullptr);
     TEST_ASSERT(handle_table.GetObjectByHandle(handle2) == nullptr);
 
+    handle_table.Finalize();
+
     TEST_SUCCESS;
 }
 
-TEST(HandleExhaustion) {
+TEST(HandleStaleGeneration) {
 
     dd::ukern::HandleTable handle_table = {};
     handle_table.Initialize();
 
-    constexpr u32 MaxHandles     = dd::ukern::HandleTable::MaxHandles;
-    constexpr u32 TestIterations = 2048;
+    dd::ukern::UKernHandle handle0 = 0;
+    dd::ukern::UKernHandle handle1 = 0;
+    u32                    value0 = 1;
+    u32                    value1 = 2;
+
+    /* Reserve and free a handle so it's entry is reused */
+    TEST_ASSERT(handle_table.ReserveHandle(std::addressof(handle0), std::addressof(value0)) == true);
+    TEST_ASSERT(handle_table.FreeHandle(handle0) == true);
+    TEST_ASSERT(handle_table.ReserveHandle(std::addressof(handle1), std::addressof(value1)) == true);
+
+    /* The entry is shared but the stale handle must not resolve or free it */
+    TEST_ASSERT((handle0 & dd::ukern::HandleTable::IndexMask) == (handle1 & dd::ukern::HandleTable::IndexMask));
+    TEST_ASSERT(handle_table.GetObjectByHandle(handle0) == nullptr);
+    TEST_ASSERT(handle_table.FreeHandle(handle0) == false);
+    TEST_ASSERT(*reinterpret_cast<u32*>(handle_table.GetObjectByHandle(handle1)) == 2);
 
-    dd::ukern::UKernHandle handles[MaxHandles + 1] = {0};
+    /* Invalid handles never resolve */
+    TEST_ASSERT(handle_table.GetObjectByHandle(0) == nullptr);
+    TEST_ASSERT(handle_table.GetObjectByHandle(dd::ukern::InvalidHandle) == nullptr);
 
-    /* Run the test for multiple iterations to ensure freeing handles work */
+    handle_table.Finalize();
+
+    TEST_SUCCESS;
+}
+
+constexpr u32 MaxHandles     = dd::ukern::HandleTable::MaxHandles;
+constexpr u32 TestIterations = 8;
+
+dd::ukern::UKernHandle HandleArray[MaxHandles + 1] = {0};
+u32                    ValueArray[MaxHandles + 1]  = {0};
+
+TEST(HandleExhaustion) {
+
+    dd::ukern::HandleTable handle_table = {};
+    handle_table.Initialize();
+
+    /* Run the test for multiple iterations to ensure freeing handles work, the first iteration grows the table to it's full size */
     for (u32 y = 0; y < TestIterations; ++y) {
 
         /* Reserve all handles */
-        u32 values[MaxHandles + 1] = {0};
         for (u32 i = 0; i < MaxHandles; ++i) {
-            values[i] = i + 1;
-            TEST_ASSERT(handle_table.ReserveHandle(std::addressof(handles[i]), std::addressof(values[i])) == true);
+            ValueArray[i] = i + 1;
+            TEST_ASSERT(handle_table.ReserveHandle(std::addressof(HandleArray[i]), std::addressof(ValueArray[i])) == true);
         }
 
         /* Try to obtain a handle after exhasustion */
-        values[MaxHandles] = MaxHandles + 1;
-        TEST_ASSERT(handle_table.ReserveHandle(std::addressof(handles[MaxHandles]), std::addressof(values[MaxHandles])) == false);
+        ValueArray[MaxHandles] = MaxHandles + 1;
+        TEST_ASSERT(handle_table.ReserveHandle(std::addressof(HandleArray[MaxHandles]), std::addressof(ValueArray[MaxHandles])) == false);
 
         /* Ensure each handle points to the correct object */
         for (u32 i = 0; i < MaxHandles; ++i) {
-            TEST_ASSERT(handle_table.GetObjectByHandle(handles[i]) != nullptr);
+            TEST_ASSERT(handle_table.GetObjectByHandle(HandleArray[i]) != nullptr);
         }
         for (u32 i = 0; i < MaxHandles; ++i) {
-            TEST_ASSERT(*reinterpret_cast<u32*>(handle_table.GetObjectByHandle(handles[i])) == (i + 1));
+            TEST_ASSERT(*reinterpret_cast<u32*>(handle_table.GetObjectByHandle(HandleArray[i])) == (i + 1));
         }
 
         /* Free all the handles */
         for (u32 i = 0; i < MaxHandles; ++i) {
-            TEST_ASSERT(handle_table.FreeHandle(handles[i]) == true);
+            TEST_ASSERT(handle_table.FreeHandle(HandleArray[i]) == true);
         }
     }
 
+    handle_table.Finalize();
+
     TEST_SUCCESS;
 }
@@ -0,0 +1,64 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 WorkerCount = 8;
+
+dd::ukern::InternalLatch StartLatch(1);
+dd::ukern::InternalLatch DoneLatch(WorkerCount);
+std::atomic<u32>         StartedCount  = 0;
+std::atomic<u32>         FinishedCount = 0;
+
+void TestWorkerMain(void *) {
+
+    /* Every worker blocks on the start latch */
+    StartLatch.Wait();
+    StartedCount.fetch_add(1);
+
+    dd::ukern::YieldThread();
+
+    FinishedCount.fetch_add(1);
+    DoneLatch.CountDown();
+
+    return;
+}
+
+TEST(Latch) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(0b1111);
+
+    dd::ukern::UKernHandle handle_array[WorkerCount] = {};
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(handle_array[i]), TestWorkerMain, i, 0x4000, THREAD_PRIORITY_NORMAL, i % 4);
+        TEST_ASSERT(result0 == dd::ResultSuccess);
+        const u32 result1 = dd::ukern::StartThread(handle_array[i]);
+        TEST_ASSERT(result1 == dd::ResultSuccess);
+    }
+
+    /* Nobody passes the start latch before it opens */
+    dd::ukern::Sleep(dd::TimeSpan::FromMicroSeconds(500));
+    TEST_ASSERT(StartedCount == 0);
+    TEST_ASSERT(StartLatch.TryWait() == false);
+
+    StartLatch.CountDown();
+    TEST_ASSERT(StartLatch.TryWait() == true);
+
+    /* Wait for every worker to count down */
+    DoneLatch.Wait();
+    TEST_ASSERT(FinishedCount == WorkerCount);
+    TEST_ASSERT(DoneLatch.TryWait() == true);
+
+    /* An open latch stays open */
+    DoneLatch.Wait();
+
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        dd::ukern::ExitThread(handle_array[i]);
+    }
+
+    TEST_SUCCESS;
+}
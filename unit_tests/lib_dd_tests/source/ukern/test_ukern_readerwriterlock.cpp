@@ -0,0 +1,111 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 WorkerCount    = 8;
+constexpr u32 WorkIterations = 4000;
+constexpr u32 WriteInterval  = 16;
+
+dd::ukern::InternalReaderWriterLock SharedLock        = {};
+u32                                 SharedValue0      = 0;
+u32                                 SharedValue1      = 0;
+std::atomic<u32>                    ActiveReaderCount = 0;
+std::atomic<u32>                    ActiveWriterCount = 0;
+std::atomic<u32>                    LockViolations    = 0;
+std::atomic<u32>                    WriteCount        = 0;
+
+void TestWorkerMain(void *arg) {
+
+    const u32 worker_index = reinterpret_cast<uintptr_t>(arg);
+
+    for (u32 i = 0; i < WorkIterations; ++i) {
+
+        if (((i + worker_index) % WriteInterval) == 0) {
+            SharedLock.Enter();
+
+            /* Writers exclude readers and each other */
+            if (ActiveWriterCount.fetch_add(1) != 0 || ActiveReaderCount.load() != 0) { LockViolations.fetch_add(1); }
+            if (SharedLock.IsLockedByCurrentThread() == false)                        { LockViolations.fetch_add(1); }
+
+            SharedValue0 = SharedValue0 + 1;
+            if ((i & 0x3f) == 0) { dd::ukern::YieldThread(); }
+            SharedValue1 = SharedValue1 + 1;
+            WriteCount.fetch_add(1);
+
+            ActiveWriterCount.fetch_sub(1);
+            SharedLock.Leave();
+        } else {
+            SharedLock.EnterShared();
+
+            /* Readers never observe a partial write */
+            ActiveReaderCount.fetch_add(1);
+            if (ActiveWriterCount.load() != 0 || SharedValue0 != SharedValue1) { LockViolations.fetch_add(1); }
+            if ((i & 0x7f) == 0) { dd::ukern::YieldThread(); }
+            ActiveReaderCount.fetch_sub(1);
+
+            SharedLock.LeaveShared();
+        }
+    }
+
+    return;
+}
+
+void TestWaitingWriterMain(void *) {
+    SharedLock.Enter();
+    SharedValue0 = SharedValue0 + 1;
+    SharedValue1 = SharedValue1 + 1;
+    SharedLock.Leave();
+    return;
+}
+
+TEST(ReaderWriterLock) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(0b1111);
+
+    /* Readers share the lock */
+    SharedLock.EnterShared();
+    TEST_ASSERT(SharedLock.TryEnterShared() == true);
+    TEST_ASSERT(SharedLock.TryEnter() == false);
+    SharedLock.LeaveShared();
+
+    /* A waiting writer holds off new readers until the current ones leave */
+    dd::ukern::UKernHandle writer_handle = 0;
+    const u32 result0 = dd::ukern::CreateThread(std::addressof(writer_handle), TestWaitingWriterMain, 0, 0x4000, THREAD_PRIORITY_NORMAL, 1);
+    TEST_ASSERT(result0 == dd::ResultSuccess);
+    const u32 result1 = dd::ukern::StartThread(writer_handle);
+    TEST_ASSERT(result1 == dd::ResultSuccess);
+
+    for (;;) {
+        if (SharedLock.TryEnterShared() == false) { break; }
+        SharedLock.LeaveShared();
+        dd::ukern::Sleep(dd::TimeSpan::FromMicroSeconds(100));
+    }
+    TEST_ASSERT(SharedValue0 == 0);
+
+    SharedLock.LeaveShared();
+    dd::ukern::ExitThread(writer_handle);
+    TEST_ASSERT(SharedValue0 == 1 && SharedValue1 == 1);
+
+    /* Mixed readers and writers across every core */
+    dd::ukern::UKernHandle handle_array[WorkerCount] = {};
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        const u32 result2 = dd::ukern::CreateThread(std::addressof(handle_array[i]), TestWorkerMain, i, 0x4000, THREAD_PRIORITY_NORMAL, i % 4);
+        TEST_ASSERT(result2 == dd::ResultSuccess);
+        const u32 result3 = dd::ukern::StartThread(handle_array[i]);
+        TEST_ASSERT(result3 == dd::ResultSuccess);
+    }
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        dd::ukern::ExitThread(handle_array[i]);
+    }
+
+    TEST_ASSERT(LockViolations == 0);
+    TEST_ASSERT(WriteCount == WorkerCount * WorkIterations / WriteInterval);
+    TEST_ASSERT(SharedValue0 == WriteCount + 1 && SharedValue1 == SharedValue0);
+
+    TEST_SUCCESS;
+}
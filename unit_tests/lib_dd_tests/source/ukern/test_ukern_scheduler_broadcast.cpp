@@ -0,0 +1,82 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 BroadcastCoreCount = 4;
+constexpr u32 WaiterCount        = 64;
+constexpr u32 RoundCount         = 8;
+
+u32              Generation  = 0;
+u32              AckCount    = 0;
+std::atomic<u32> ResumeCount = 0;
+
+void TestWaiterMain(void *) {
+
+    for (u32 round = 0; round < RoundCount; ++round) {
+
+        /* Wait for the next broadcast */
+        while (std::atomic_ref<u32>(Generation).load() == round) {
+            dd::ukern::WaitOnAddress(reinterpret_cast<uintptr_t>(std::addressof(Generation)), dd::ukern::ArbitrationType_WaitIfEqual, round, -1);
+        }
+
+        ResumeCount.fetch_add(1);
+
+        /* The last waiter to resume releases the broadcaster */
+        if (std::atomic_ref<u32>(AckCount).fetch_add(1) + 1 == WaiterCount) {
+            dd::ukern::WakeByAddress(reinterpret_cast<uintptr_t>(std::addressof(AckCount)), dd::ukern::SignalType_Signal, 0, 1);
+        }
+    }
+
+    return;
+}
+
+TEST(SchedulerBroadcastWake) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(dd::ukern::UKernCoreMask::MakeLowBits(BroadcastCoreCount));
+
+    /* Create waiters allowed on every core */
+    dd::ukern::UKernHandle handle_array[WaiterCount] = {};
+    for (u32 i = 0; i < WaiterCount; ++i) {
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(handle_array[i]), TestWaiterMain, i, 0x4000, THREAD_PRIORITY_NORMAL, 0);
+        TEST_ASSERT(result0 == dd::ResultSuccess);
+
+        const u32 result1 = dd::ukern::SetThreadCoreMask(handle_array[i], dd::ukern::UKernCoreMask::MakeLowBits(BroadcastCoreCount));
+        TEST_ASSERT(result1 == dd::ResultSuccess);
+
+        const u32 result2 = dd::ukern::StartThread(handle_array[i]);
+        TEST_ASSERT(result2 == dd::ResultSuccess);
+    }
+
+    /* Broadcast each round to every waiter with a single wake call */
+    for (u32 round = 0; round < RoundCount; ++round) {
+
+        /* Let the waiters block and idle cores park */
+        dd::ukern::Sleep(dd::TimeSpan::FromMicroSeconds(500));
+
+        std::atomic_ref<u32>(AckCount).store(0);
+
+        std::atomic_ref<u32>(Generation).store(round + 1);
+        dd::ukern::WakeByAddress(reinterpret_cast<uintptr_t>(std::addressof(Generation)), dd::ukern::SignalType_Signal, 0, WaiterCount);
+
+        /* Wait for every waiter to resume */
+        for (u32 ack_count = std::atomic_ref<u32>(AckCount).load(); ack_count < WaiterCount; ack_count = std::atomic_ref<u32>(AckCount).load()) {
+            dd::ukern::WaitOnAddress(reinterpret_cast<uintptr_t>(std::addressof(AckCount)), dd::ukern::ArbitrationType_WaitIfEqual, ack_count, -1);
+        }
+    }
+
+    const u32 result3 = dd::ukern::JoinThreads(handle_array, WaiterCount, dd::TimeSpan::FromSeconds(10));
+    TEST_ASSERT(result3 == dd::ResultSuccess);
+    for (u32 i = 0; i < WaiterCount; ++i) {
+        dd::ukern::ExitThread(handle_array[i]);
+    }
+
+    /* Every waiter resumed once per round */
+    TEST_ASSERT(ResumeCount == WaiterCount * RoundCount);
+
+    TEST_SUCCESS;
+}
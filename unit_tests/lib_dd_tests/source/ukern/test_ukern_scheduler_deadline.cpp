@@ -0,0 +1,93 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 BackgroundFiberCount = 2;
+constexpr u32 FrameCount           = 10;
+
+volatile u32                        DeadlineFramesDone    = 0;
+dd::ukern::ThreadDeadlineStatistics FrameStatistics       = {};
+u32                                 FrameStatisticsResult = 0;
+
+void SpinFor(dd::TimeSpan spin_time) {
+    const s64 start = dd::util::GetSystemTick();
+    while (dd::TimeSpan::FromTick(dd::util::GetSystemTick() - start).GetNanoSeconds() < spin_time.GetNanoSeconds()) {}
+}
+
+void TestFrameMain(void *) {
+
+    /* Frames with a short burst of work, each sleep completes a job */
+    for (u32 i = 0; i < FrameCount; ++i) {
+        SpinFor(dd::TimeSpan::FromMicroSeconds(100));
+        dd::ukern::Sleep(dd::TimeSpan::FromMilliSeconds(1));
+    }
+
+    /* One frame overruns it's budget and deadline */
+    SpinFor(dd::TimeSpan::FromMilliSeconds(6));
+    dd::ukern::Sleep(dd::TimeSpan::FromMilliSeconds(1));
+
+    /* Record our statistics before exiting */
+    FrameStatisticsResult = dd::ukern::GetThreadDeadlineStatistics(std::addressof(FrameStatistics), dd::ukern::GetCurrentThread()->ukern_fiber_handle);
+    DeadlineFramesDone    = 1;
+
+    return;
+}
+
+void TestBackgroundMain(void *) {
+
+    /* Saturate the core above the frame fiber's static priority */
+    while (DeadlineFramesDone == 0) {
+        dd::ukern::YieldThread();
+    }
+
+    return;
+}
+
+TEST(SchedulerDeadline) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Use one core so the deadline class decides who runs */
+    dd::ukern::UKernCoreMask core_mask = 1;
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(core_mask);
+
+    /* Lowest priority frame fiber with a deadline class */
+    dd::ukern::UKernHandle frame_handle = 0;
+    const u32 result0 = dd::ukern::CreateThread(std::addressof(frame_handle), TestFrameMain, 0, 0x4000, THREAD_PRIORITY_LOWEST, 0);
+    TEST_ASSERT(result0 == dd::ResultSuccess);
+
+    /* Reject budgets exceeding the deadline */
+    const u32 result1 = dd::ukern::SetThreadDeadline(frame_handle, dd::TimeSpan::FromMilliSeconds(1), dd::TimeSpan::FromMilliSeconds(2));
+    TEST_ASSERT(result1 == dd::ukern::ResultInvalidDeadline);
+    const u32 result2 = dd::ukern::SetThreadDeadline(frame_handle, dd::TimeSpan::FromMilliSeconds(5), dd::TimeSpan::FromMilliSeconds(1));
+    TEST_ASSERT(result2 == dd::ResultSuccess);
+
+    /* Highest priority background load */
+    dd::ukern::UKernHandle background_handle_array[BackgroundFiberCount] = {};
+    for (u32 i = 0; i < BackgroundFiberCount; ++i) {
+        const u32 result3 = dd::ukern::CreateThread(std::addressof(background_handle_array[i]), TestBackgroundMain, 0, 0x4000, THREAD_PRIORITY_HIGHEST, 0);
+        TEST_ASSERT(result3 == dd::ResultSuccess);
+        const u32 result4 = dd::ukern::StartThread(background_handle_array[i]);
+        TEST_ASSERT(result4 == dd::ResultSuccess);
+    }
+    const u32 result5 = dd::ukern::StartThread(frame_handle);
+    TEST_ASSERT(result5 == dd::ResultSuccess);
+
+    /* Wait for everyone */
+    const u32 result6 = dd::ukern::JoinThreads(background_handle_array, BackgroundFiberCount, dd::TimeSpan::FromSeconds(5));
+    TEST_ASSERT(result6 == dd::ResultSuccess);
+    const u32 result7 = dd::ukern::JoinThread(frame_handle, dd::TimeSpan::FromSeconds(5));
+    TEST_ASSERT(result7 == dd::ResultSuccess);
+
+    /* Every frame ran despite the load, only the overrunning frame missed */
+    TEST_ASSERT(FrameStatisticsResult == dd::ResultSuccess);
+    TEST_ASSERT(FrameStatistics.job_count == FrameCount + 1);
+    TEST_ASSERT(FrameStatistics.miss_count == 1);
+    TEST_ASSERT(FrameStatistics.overrun_count == 1);
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,95 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 WorkerCount = 8;
+constexpr u32 YieldCount  = 100;
+constexpr u32 LookupCount = 10000000;
+
+u32              TestSlot         = 0;
+std::atomic<u32> SlotViolations   = 0;
+std::atomic<u32> CompletedWorkers = 0;
+
+void TestWorkerMain(void *arg) {
+
+    /* New fibers start with every slot cleared */
+    if (dd::ukern::GetFiberLocal(TestSlot) != nullptr) { SlotViolations.fetch_add(1); }
+
+    dd::ukern::SetFiberLocal(TestSlot, arg);
+
+    /* Values follow the fiber across switches and cores */
+    for (u32 i = 0; i < YieldCount; ++i) {
+        dd::ukern::YieldThread();
+        if (dd::ukern::GetFiberLocal(TestSlot) != arg) { SlotViolations.fetch_add(1); }
+    }
+
+    CompletedWorkers.fetch_add(1);
+
+    return;
+}
+
+TEST(SchedulerFiberLocalSlots) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(0b11);
+
+    /* Allocate every slot, then fail */
+    u32 slot_array[dd::ukern::MaxFiberLocalSlotCount] = {};
+    for (u32 i = 0; i < dd::ukern::MaxFiberLocalSlotCount; ++i) {
+        const u32 result0 = dd::ukern::AllocateFiberLocalSlot(std::addressof(slot_array[i]));
+        TEST_ASSERT(result0 == dd::ResultSuccess);
+        TEST_ASSERT(slot_array[i] < dd::ukern::MaxFiberLocalSlotCount);
+    }
+    u32 extra_slot = 0;
+    const u32 result1 = dd::ukern::AllocateFiberLocalSlot(std::addressof(extra_slot));
+    TEST_ASSERT(result1 == dd::ukern::ResultFiberLocalSlotExhaustion);
+
+    /* A freed slot is cleared for every fiber when it's allocated again */
+    dd::ukern::SetFiberLocal(slot_array[3], std::addressof(extra_slot));
+    const u32 result2 = dd::ukern::FreeFiberLocalSlot(slot_array[3]);
+    TEST_ASSERT(result2 == dd::ResultSuccess);
+    const u32 result3 = dd::ukern::FreeFiberLocalSlot(slot_array[3]);
+    TEST_ASSERT(result3 == dd::ukern::ResultInvalidFiberLocalSlot);
+
+    const u32 result4 = dd::ukern::AllocateFiberLocalSlot(std::addressof(TestSlot));
+    TEST_ASSERT(result4 == dd::ResultSuccess);
+    TEST_ASSERT(TestSlot == slot_array[3]);
+    TEST_ASSERT(dd::ukern::GetFiberLocal(TestSlot) == nullptr);
+
+    /* Each worker keeps it's own value */
+    dd::ukern::UKernHandle handle_array[WorkerCount] = {};
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        const u32 result5 = dd::ukern::CreateThread(std::addressof(handle_array[i]), TestWorkerMain, i + 1, 0x4000, THREAD_PRIORITY_NORMAL, 0);
+        TEST_ASSERT(result5 == dd::ResultSuccess);
+
+        const u32 result6 = dd::ukern::SetThreadCoreMask(handle_array[i], 0b11);
+        TEST_ASSERT(result6 == dd::ResultSuccess);
+
+        const u32 result7 = dd::ukern::StartThread(handle_array[i]);
+        TEST_ASSERT(result7 == dd::ResultSuccess);
+    }
+
+    const u32 result8 = dd::ukern::JoinThreads(handle_array, WorkerCount, dd::TimeSpan::FromSeconds(10));
+    TEST_ASSERT(result8 == dd::ResultSuccess);
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        dd::ukern::ExitThread(handle_array[i]);
+    }
+
+    TEST_ASSERT(CompletedWorkers == WorkerCount);
+    TEST_ASSERT(SlotViolations == 0);
+
+    /* Repeated lookups through the current fiber */
+    dd::ukern::SetFiberLocal(dd::ukern::GetCurrentThread(), TestSlot, std::addressof(TestSlot));
+
+    uintptr_t lookup_sum = 0;
+    for (u32 i = 0; i < LookupCount; ++i) {
+        lookup_sum += reinterpret_cast<uintptr_t>(dd::ukern::GetFiberLocal(TestSlot));
+    }
+    TEST_ASSERT(lookup_sum == reinterpret_cast<uintptr_t>(std::addressof(TestSlot)) * LookupCount);
+
+    TEST_SUCCESS;
+}
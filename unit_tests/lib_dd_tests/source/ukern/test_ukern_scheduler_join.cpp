@@ -0,0 +1,87 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 JoinFiberCount = 8;
+
+u32 JoinDoneCount  = 0;
+u32 JoinReleaseKey = 0;
+
+void TestJoinSleeperMain(void *arg) {
+
+    /* Exit after a staggered delay */
+    const s64 delay_ms = static_cast<s64>(reinterpret_cast<uintptr_t>(arg));
+    dd::ukern::Sleep(dd::TimeSpan::FromMilliSeconds(delay_ms));
+
+    std::atomic_ref<u32>(JoinDoneCount).fetch_add(1);
+
+    return;
+}
+
+void TestJoinBlockedMain(void *) {
+
+    /* Wait until the test releases us */
+    while (std::atomic_ref<u32>(JoinReleaseKey).load() == 0) {
+        dd::ukern::WaitOnAddress(reinterpret_cast<uintptr_t>(std::addressof(JoinReleaseKey)), dd::ukern::ArbitrationType_WaitIfEqual, 0, dd::TimeSpan::FromMilliSeconds(100).GetNanoSeconds());
+    }
+
+    return;
+}
+
+TEST(SchedulerJoin) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Use two cores */
+    dd::ukern::UKernCoreMask core_mask = 3;
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(core_mask);
+
+    /* Start a fiber that won't exit until released */
+    dd::ukern::UKernHandle blocked_handle = 0;
+    const u32 result0 = dd::ukern::CreateThread(std::addressof(blocked_handle), TestJoinBlockedMain, 0, 0x4000, THREAD_PRIORITY_NORMAL, 1);
+    TEST_ASSERT(result0 == dd::ResultSuccess);
+    const u32 result1 = dd::ukern::StartThread(blocked_handle);
+    TEST_ASSERT(result1 == dd::ResultSuccess);
+
+    /* Timed join must expire */
+    const s64 start = dd::util::GetSystemTick();
+    const u32 result2 = dd::ukern::JoinThread(blocked_handle, dd::TimeSpan::FromMilliSeconds(2));
+    const s64 end   = dd::util::GetSystemTick();
+    TEST_ASSERT(result2 == dd::ukern::ResultTimeout);
+    TEST_ASSERT(2 <= dd::TimeSpan::FromTick(end - start).GetMilliSeconds());
+
+    /* Release the fiber and join for real */
+    std::atomic_ref<u32>(JoinReleaseKey).store(1);
+    dd::ukern::WakeByAddress(reinterpret_cast<uintptr_t>(std::addressof(JoinReleaseKey)), dd::ukern::SignalType_Signal, 0, 1);
+    const u32 result3 = dd::ukern::JoinThread(blocked_handle, dd::TimeSpan::FromSeconds(5));
+    TEST_ASSERT(result3 == dd::ResultSuccess);
+
+    /* Joining an exited fiber returns immediately, joining ourselves is rejected */
+    const u32 result4 = dd::ukern::JoinThread(blocked_handle, dd::TimeSpan::FromMilliSeconds(1));
+    TEST_ASSERT(result4 == dd::ResultSuccess);
+    const u32 result5 = dd::ukern::JoinThread(dd::ukern::GetCurrentThread()->ukern_fiber_handle, dd::TimeSpan::FromMilliSeconds(1));
+    TEST_ASSERT(result5 == dd::ukern::ResultInvalidHandle);
+
+    /* Start fibers exiting in reverse creation order across both cores */
+    dd::ukern::UKernHandle handle_array[JoinFiberCount] = {};
+    for (u32 i = 0; i < JoinFiberCount; ++i) {
+        const u32 result6 = dd::ukern::CreateThread(std::addressof(handle_array[i]), TestJoinSleeperMain, JoinFiberCount - i, 0x4000, THREAD_PRIORITY_NORMAL, i & 1);
+        TEST_ASSERT(result6 == dd::ResultSuccess);
+        const u32 result7 = dd::ukern::StartThread(handle_array[i]);
+        TEST_ASSERT(result7 == dd::ResultSuccess);
+    }
+
+    /* Join all, every fiber must have exited */
+    const u32 result8 = dd::ukern::JoinThreads(handle_array, JoinFiberCount, dd::TimeSpan::FromSeconds(5));
+    TEST_ASSERT(result8 == dd::ResultSuccess);
+    TEST_ASSERT(std::atomic_ref<u32>(JoinDoneCount).load() == JoinFiberCount);
+
+    /* ExitThread blocks the same way */
+    dd::ukern::ExitThread(handle_array[0]);
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,50 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 FiberCount = 4096;
+
+dd::ukern::UKernHandle HandleArray[FiberCount] = {};
+std::atomic<u32>       CompletedFibers = 0;
+
+void TestManyFibersMain(void *) {
+    CompletedFibers.fetch_add(1);
+    return;
+}
+
+TEST(SchedulerManyFibers) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Use one core */
+    dd::ukern::UKernCoreMask core_mask = 1;
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(core_mask);
+
+    /* Create more fibers than a single handle table chunk holds, all alive at once */
+    for (u32 i = 0; i < FiberCount; ++i) {
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(HandleArray[i]), TestManyFibersMain, 0, 0x4000, THREAD_PRIORITY_NORMAL, 0);
+        TEST_ASSERT(result0 == dd::ResultSuccess);
+    }
+
+    /* Ensure every handle resolves */
+    for (u32 i = 0; i < FiberCount; ++i) {
+        const u32 result1 = dd::ukern::SetThreadPriority(HandleArray[i], THREAD_PRIORITY_ABOVE_NORMAL);
+        TEST_ASSERT(result1 == dd::ResultSuccess);
+    }
+
+    /* Run them all */
+    for (u32 i = 0; i < FiberCount; ++i) {
+        const u32 result2 = dd::ukern::StartThread(HandleArray[i]);
+        TEST_ASSERT(result2 == dd::ResultSuccess);
+    }
+    for (u32 i = 0; i < FiberCount; ++i) {
+        dd::ukern::ExitThread(HandleArray[i]);
+    }
+    TEST_ASSERT(CompletedFibers.load() == FiberCount);
+
+    TEST_SUCCESS;
+}
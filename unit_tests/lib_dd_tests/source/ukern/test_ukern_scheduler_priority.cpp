@@ -0,0 +1,52 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+volatile u32 RunOrderIndex = 0;
+volatile s32 RunOrder[3] = {};
+
+void TestPriorityMain(void *arg) {
+
+    /* Record our priority in run order */
+    RunOrder[RunOrderIndex] = static_cast<s32>(reinterpret_cast<intptr_t>(arg));
+    RunOrderIndex = RunOrderIndex + 1;
+
+    return;
+}
+
+TEST(SchedulerPriorityOrder) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Use one core */
+    dd::ukern::UKernCoreMask core_mask = 1;
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(core_mask);
+
+    /* Create threads in reverse priority order */
+    const s32 priority_array[3] = { THREAD_PRIORITY_LOWEST, THREAD_PRIORITY_NORMAL, THREAD_PRIORITY_HIGHEST };
+    dd::ukern::UKernHandle handle_array[3] = {};
+    for (u32 i = 0; i < 3; ++i) {
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(handle_array[i]), TestPriorityMain, priority_array[i], 0x4000, priority_array[i], 0);
+        TEST_ASSERT(result0 == dd::ResultSuccess);
+    }
+    for (u32 i = 0; i < 3; ++i) {
+        const u32 result1 = dd::ukern::StartThread(handle_array[i]);
+        TEST_ASSERT(result1 == dd::ResultSuccess);
+    }
+
+    /* Sleep so the main thread leaves the run queue and every priority can run */
+    while (RunOrderIndex != 3) {
+        dd::ukern::Sleep(dd::TimeSpan::FromMilliSeconds(1));
+    }
+
+    /* Ensure highest priority ran first */
+    TEST_ASSERT(RunOrder[0] == THREAD_PRIORITY_HIGHEST);
+    TEST_ASSERT(RunOrder[1] == THREAD_PRIORITY_NORMAL);
+    TEST_ASSERT(RunOrder[2] == THREAD_PRIORITY_LOWEST);
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,36 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+TEST(SchedulerSleepPrecision) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::UKernCoreMask core_mask = 1;
+    dd::ukern::InitializeUKern(core_mask);
+
+    /* Sleep well below the OS tick repeatedly */
+    constexpr u32 SleepCount = 64;
+    s64 total_us = 0;
+    for (u32 i = 0; i < SleepCount; ++i) {
+
+        const s64 start = dd::util::GetSystemTick();
+        dd::ukern::Sleep(dd::TimeSpan::FromMicroSeconds(250));
+        const s64 end   = dd::util::GetSystemTick();
+
+        /* Never wake early */
+        const s64 elapsed_us = dd::TimeSpan::FromTick(end - start).GetMicroSeconds();
+        TEST_ASSERT(250 <= elapsed_us);
+
+        total_us += elapsed_us;
+    }
+
+    /* Ensure the average oversleep stays far below a millisecond tick */
+    const s64 average_us = total_us / SleepCount;
+    TEST_ASSERT(average_us < 1000);
+
+    TEST_SUCCESS;
+}
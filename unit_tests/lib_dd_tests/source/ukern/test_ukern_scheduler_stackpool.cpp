@@ -0,0 +1,64 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 SpawnCount = 16;
+
+volatile u32 CompletedFibers = 0;
+
+void TestStackPoolMain(void *arg) {
+
+    /* Touch the stack to ensure recycled stacks are usable */
+    char stack_array[0x2000];
+    ::memset(stack_array, static_cast<int>(reinterpret_cast<uintptr_t>(arg)), sizeof(stack_array));
+
+    CompletedFibers = CompletedFibers + ((stack_array[0] == stack_array[sizeof(stack_array) - 1]) ? 1 : 0);
+
+    return;
+}
+
+TEST(SchedulerStackPoolRecycle) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Use one core */
+    dd::ukern::UKernCoreMask core_mask = 1;
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(core_mask);
+
+    /* Spawn and join fibers one at a time so each spawn can reuse the last exited stack */
+    for (u32 i = 0; i < SpawnCount; ++i) {
+        dd::ukern::UKernHandle handle = 0;
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(handle), TestStackPoolMain, i, 0x4000, THREAD_PRIORITY_NORMAL, 0);
+        TEST_ASSERT(result0 == dd::ResultSuccess);
+        const u32 result1 = dd::ukern::StartThread(handle);
+        TEST_ASSERT(result1 == dd::ResultSuccess);
+
+        dd::ukern::ExitThread(handle);
+    }
+    TEST_ASSERT(CompletedFibers == SpawnCount);
+
+    /* Only the first spawn should have created a stack */
+    dd::ukern::FiberStackPoolStatistics statistics = {};
+    dd::ukern::GetFiberStackPoolStatistics(std::addressof(statistics));
+    TEST_ASSERT(statistics.miss_count == 1);
+    TEST_ASSERT(statistics.hit_count  == SpawnCount - 1);
+    TEST_ASSERT(statistics.bytes_held == dd::ukern::impl::GetFiberStackRegionSize(0x4000));
+
+    /* A larger size class must not reuse the held stack */
+    dd::ukern::UKernHandle large_handle = 0;
+    const u32 result2 = dd::ukern::CreateThread(std::addressof(large_handle), TestStackPoolMain, 0, 0x10000, THREAD_PRIORITY_NORMAL, 0);
+    TEST_ASSERT(result2 == dd::ResultSuccess);
+    dd::ukern::GetFiberStackPoolStatistics(std::addressof(statistics));
+    TEST_ASSERT(statistics.miss_count == 2);
+
+    const u32 result3 = dd::ukern::StartThread(large_handle);
+    TEST_ASSERT(result3 == dd::ResultSuccess);
+    dd::ukern::ExitThread(large_handle);
+    TEST_ASSERT(CompletedFibers == SpawnCount + 1);
+
+    TEST_SUCCESS;
+}
@@ -1,5 +1,6 @@
 #include <dd.hpp>
 #include <unit_tester.hpp>
+#include <thread>
 
 DECLARE_UNIT_TESTER_INSTANCE;
 
@@ -24,7 +25,7 @@ void TestWaitMain(void *arg) {
 TEST(SchedulerDualCoreThreadValueSet) {
 
     /* Integrity check for 2 cores */
-    TEST_ASSERT(::GetActiveProcessorCount(0) > 2);
+    TEST_ASSERT(std::thread::hardware_concurrency() > 2);
 
     /* Init timestamp */
     dd::util::InitializeTimeStamp();
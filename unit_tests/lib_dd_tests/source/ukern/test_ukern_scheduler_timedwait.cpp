@@ -0,0 +1,65 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 WaiterCount = 3;
+
+u32 WaitValue = 0;
+volatile u32 TimeoutOrderIndex = 0;
+volatile u32 TimeoutOrder[WaiterCount] = {};
+volatile u32 TimeoutResults[WaiterCount] = {};
+
+void TestTimedWaitMain(void *arg) {
+
+    const u32 timeout_ms = static_cast<u32>(reinterpret_cast<uintptr_t>(arg));
+
+    /* Wait on an address nobody will signal */
+    const u32 result = dd::ukern::WaitOnAddress(reinterpret_cast<uintptr_t>(std::addressof(WaitValue)), dd::ukern::ArbitrationType_WaitIfEqual, 0, dd::TimeSpan::FromMilliSeconds(timeout_ms).GetNanoSeconds());
+
+    /* Record our timeout order */
+    TimeoutResults[TimeoutOrderIndex] = result;
+    TimeoutOrder[TimeoutOrderIndex]   = timeout_ms;
+    TimeoutOrderIndex = TimeoutOrderIndex + 1;
+
+    return;
+}
+
+TEST(SchedulerTimedWaitOrder) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Use one core */
+    dd::ukern::UKernCoreMask core_mask = 1;
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(core_mask);
+
+    /* Create waiters on the same address, the first becomes the parent waiter and must time out last */
+    const u32 timeout_array[WaiterCount] = { 6, 2, 4 };
+    dd::ukern::UKernHandle handle_array[WaiterCount] = {};
+    for (u32 i = 0; i < WaiterCount; ++i) {
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(handle_array[i]), TestTimedWaitMain, timeout_array[i], 0x4000, THREAD_PRIORITY_NORMAL, 0);
+        TEST_ASSERT(result0 == dd::ResultSuccess);
+    }
+    for (u32 i = 0; i < WaiterCount; ++i) {
+        const u32 result1 = dd::ukern::StartThread(handle_array[i]);
+        TEST_ASSERT(result1 == dd::ResultSuccess);
+    }
+
+    /* Sleep until every waiter timed out */
+    while (TimeoutOrderIndex != WaiterCount) {
+        dd::ukern::Sleep(dd::TimeSpan::FromMilliSeconds(1));
+    }
+
+    /* Ensure waiters timed out in timeout order */
+    TEST_ASSERT(TimeoutOrder[0] == 2);
+    TEST_ASSERT(TimeoutOrder[1] == 4);
+    TEST_ASSERT(TimeoutOrder[2] == 6);
+    for (u32 i = 0; i < WaiterCount; ++i) {
+        TEST_ASSERT(TimeoutResults[i] == dd::ukern::ResultTimeout);
+    }
+
+    TEST_SUCCESS;
+}
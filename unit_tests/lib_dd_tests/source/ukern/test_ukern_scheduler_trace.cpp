@@ -0,0 +1,80 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 WorkerCount = 4;
+
+dd::ukern::InternalCriticalSection TraceCriticalSection = {};
+volatile u32                       CompletedWorkers     = 0;
+
+void TestTraceWorkerMain(void *) {
+
+    for (u32 i = 0; i < 8; ++i) {
+        TraceCriticalSection.Enter();
+        dd::ukern::YieldThread();
+        TraceCriticalSection.Leave();
+
+        dd::ukern::Sleep(dd::TimeSpan::FromMicroSeconds(100));
+    }
+
+    TraceCriticalSection.Enter();
+    CompletedWorkers = CompletedWorkers + 1;
+    TraceCriticalSection.Leave();
+
+    return;
+}
+
+TEST(SchedulerTraceExport) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Use one core */
+    dd::ukern::UKernCoreMask core_mask = 1;
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(core_mask);
+
+    /* Exporting before tracing was enabled fails */
+    TEST_ASSERT(dd::ukern::ExportSchedulerTrace("ukern_trace.json") == dd::ukern::ResultTraceNotEnabled);
+
+    /* Trace a few contended workers */
+    TEST_ASSERT(dd::ukern::EnableSchedulerTrace() == dd::ResultSuccess);
+
+    dd::ukern::UKernHandle handle_array[WorkerCount] = {};
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(handle_array[i]), TestTraceWorkerMain, 0, 0x4000, THREAD_PRIORITY_NORMAL, 0);
+        TEST_ASSERT(result0 == dd::ResultSuccess);
+        dd::ukern::SetThreadName(handle_array[i], "TraceWorker");
+        const u32 result1 = dd::ukern::StartThread(handle_array[i]);
+        TEST_ASSERT(result1 == dd::ResultSuccess);
+    }
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        dd::ukern::ExitThread(handle_array[i]);
+    }
+    TEST_ASSERT(CompletedWorkers == WorkerCount);
+
+    /* Export */
+    TEST_ASSERT(dd::ukern::ExportSchedulerTrace("ukern_trace.json") == dd::ResultSuccess);
+
+    /* Read back the trace */
+    FILE *file = ::fopen("ukern_trace.json", "r");
+    TEST_ASSERT(file != nullptr);
+    static char trace_buffer[0x100000] = {};
+    const size_t read_size = ::fread(trace_buffer, 1, sizeof(trace_buffer) - 1, file);
+    ::fclose(file);
+    ::remove("ukern_trace.json");
+
+    /* Ensure the trace is a chrome trace with dispatch slices, waits and wakes for our workers */
+    TEST_ASSERT(0 < read_size);
+    TEST_ASSERT(::strncmp(trace_buffer, "{\"traceEvents\":[", 16) == 0);
+    TEST_ASSERT(::strstr(trace_buffer, "\"name\":\"TraceWorker\"") != nullptr);
+    TEST_ASSERT(::strstr(trace_buffer, "\"ph\":\"B\"") != nullptr);
+    TEST_ASSERT(::strstr(trace_buffer, "\"event\":\"Wait\"") != nullptr);
+    TEST_ASSERT(::strstr(trace_buffer, "\"event\":\"Wake\"") != nullptr);
+    TEST_ASSERT(::strstr(trace_buffer, "\"event\":\"Timeout\"") != nullptr);
+    TEST_ASSERT(::strstr(trace_buffer, "\"event\":\"Exit\"") != nullptr);
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,75 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 WaiterCount = 8;
+
+u32 WaitValueArray[WaiterCount] = {};
+std::atomic<u32> WokenMask = 0;
+
+void TestWaitAddressMain(void *arg) {
+
+    const u32 index = static_cast<u32>(reinterpret_cast<uintptr_t>(arg));
+
+    /* Wait until our address is signalled */
+    while (WaitValueArray[index] == 0) {
+        dd::ukern::WaitOnAddress(reinterpret_cast<uintptr_t>(std::addressof(WaitValueArray[index])), dd::ukern::ArbitrationType_WaitIfEqual, 0, -1);
+    }
+
+    WokenMask.fetch_or(1u << index);
+
+    return;
+}
+
+TEST(SchedulerWaitAddressDistinct) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Use one core */
+    dd::ukern::UKernCoreMask core_mask = 1;
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(core_mask);
+
+    /* Create a waiter for each address */
+    dd::ukern::UKernHandle handle_array[WaiterCount] = {};
+    for (u32 i = 0; i < WaiterCount; ++i) {
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(handle_array[i]), TestWaitAddressMain, i, 0x4000, THREAD_PRIORITY_NORMAL, 0);
+        TEST_ASSERT(result0 == dd::ResultSuccess);
+        const u32 result1 = dd::ukern::StartThread(handle_array[i]);
+        TEST_ASSERT(result1 == dd::ResultSuccess);
+    }
+
+    /* Let every waiter reach it's wait */
+    dd::ukern::Sleep(dd::TimeSpan::FromMilliSeconds(2));
+
+    /* An address without waiters wakes nothing */
+    u32 unused_value = 0;
+    const u32 result2 = dd::ukern::WakeByAddress(reinterpret_cast<uintptr_t>(std::addressof(unused_value)), dd::ukern::SignalType_Signal, 0, 1);
+    TEST_ASSERT(result2 == dd::ukern::ResultNoWaiters);
+    TEST_ASSERT(WokenMask == 0);
+
+    /* Wake the odd addresses only */
+    for (u32 i = 1; i < WaiterCount; i += 2) {
+        WaitValueArray[i] = 1;
+        const u32 result3 = dd::ukern::WakeByAddress(reinterpret_cast<uintptr_t>(std::addressof(WaitValueArray[i])), dd::ukern::SignalType_Signal, 0, 1);
+        TEST_ASSERT(result3 == dd::ResultSuccess);
+    }
+    dd::ukern::Sleep(dd::TimeSpan::FromMilliSeconds(2));
+    TEST_ASSERT(WokenMask == 0b1010'1010);
+
+    /* Wake the rest */
+    for (u32 i = 0; i < WaiterCount; i += 2) {
+        WaitValueArray[i] = 1;
+        const u32 result4 = dd::ukern::WakeByAddress(reinterpret_cast<uintptr_t>(std::addressof(WaitValueArray[i])), dd::ukern::SignalType_Signal, 0, 1);
+        TEST_ASSERT(result4 == dd::ResultSuccess);
+    }
+    for (u32 i = 0; i < WaiterCount; ++i) {
+        dd::ukern::ExitThread(handle_array[i]);
+    }
+    TEST_ASSERT(WokenMask == 0b1111'1111);
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,75 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 WorkIterations = 1000;
+
+std::atomic<u32> CompletedWorkers   = 0;
+std::atomic<u32> CoreMaskViolations = 0;
+
+void TestWideMaskWorkerMain([[maybe_unused]] void *arg) {
+
+    for (u32 i = 0; i < WorkIterations; ++i) {
+
+        /* The wide mask only leaves core 1 */
+        if (dd::ukern::GetCurrentThread()->current_core != 1) {
+            CoreMaskViolations.fetch_add(1);
+        }
+
+        dd::ukern::YieldThread();
+    }
+
+    CompletedWorkers.fetch_add(1);
+
+    return;
+}
+
+TEST(SchedulerWideCoreMask) {
+
+    /* Bit sets span words */
+    dd::ukern::UKernCoreMask wide_mask = {};
+    wide_mask.Set(1);
+    wide_mask.Set(130);
+    wide_mask.Set(255);
+    TEST_ASSERT(wide_mask.Count() == 3);
+    TEST_ASSERT(wide_mask.FindFirstSet() == 1);
+    TEST_ASSERT(wide_mask.FindNextSet(1) == 130);
+    TEST_ASSERT(wide_mask.FindNextSet(130) == 255);
+    TEST_ASSERT(wide_mask.FindNextSet(255) == dd::ukern::UKernCoreMask::NotFound);
+    TEST_ASSERT(dd::ukern::UKernCoreMask::MakeLowBits(70).Count() == 70);
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Use two cores */
+    dd::ukern::UKernCoreMask core_mask = 0b11;
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(core_mask);
+
+    /* Create a worker on core 0 */
+    dd::ukern::UKernHandle handle = 0;
+    const u32 result0 = dd::ukern::CreateThread(std::addressof(handle), TestWideMaskWorkerMain, 0, 0x4000, THREAD_PRIORITY_NORMAL, 0);
+    TEST_ASSERT(result0 == dd::ResultSuccess);
+
+    /* Masks without any of our cores are rejected */
+    dd::ukern::UKernCoreMask invalid_mask = {};
+    invalid_mask.Set(130);
+    const u32 result1 = dd::ukern::SetThreadCoreMask(handle, invalid_mask);
+    TEST_ASSERT(result1 == dd::ukern::ResultInvalidCoreId);
+
+    /* Bits past our core count are dropped, leaving the worker pinned to core 1 */
+    const u32 result2 = dd::ukern::SetThreadCoreMask(handle, wide_mask);
+    TEST_ASSERT(result2 == dd::ResultSuccess);
+
+    const u32 result3 = dd::ukern::StartThread(handle);
+    TEST_ASSERT(result3 == dd::ResultSuccess);
+
+    dd::ukern::ExitThread(handle);
+
+    TEST_ASSERT(CompletedWorkers == 1);
+    TEST_ASSERT(CoreMaskViolations == 0);
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,81 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+#include <thread>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 WorkerCount    = 16;
+constexpr u32 WorkIterations = 1000;
+
+std::atomic<u32> CompletedWorkers = 0;
+std::atomic<u32> CoreMaskViolations = 0;
+std::atomic<u64> VisitedCoreMask = 0;
+
+void TestWorkerMain(void *arg) {
+
+    const u64 pinned_mask = reinterpret_cast<u64>(arg);
+
+    for (u32 i = 0; i < WorkIterations; ++i) {
+
+        /* Record the core we are running on */
+        const u32 current_core = dd::ukern::GetCurrentThread()->current_core;
+        VisitedCoreMask.fetch_or(1ull << current_core);
+
+        /* Pinned fibers must never be stolen by another core */
+        if (pinned_mask != 0 && (pinned_mask & (1ull << current_core)) == 0) {
+            CoreMaskViolations.fetch_add(1);
+        }
+
+        /* Give idle cores a chance to steal us */
+        dd::ukern::YieldThread();
+    }
+
+    CompletedWorkers.fetch_add(1);
+
+    return;
+}
+
+TEST(SchedulerWorkStealing) {
+
+    /* Integrity check for 4 cores */
+    TEST_ASSERT(std::thread::hardware_concurrency() >= 4);
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Use four cores */
+    dd::ukern::UKernCoreMask core_mask = 0b1111;
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(core_mask);
+
+    /* Create workers on core 0, half may migrate to any core and half are pinned */
+    dd::ukern::UKernHandle handle_array[WorkerCount] = {};
+    for (u32 i = 0; i < WorkerCount; ++i) {
+
+        const u64 pinned_mask = ((i & 1) == 0) ? 0 : 1;
+
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(handle_array[i]), TestWorkerMain, pinned_mask, 0x4000, THREAD_PRIORITY_NORMAL, 0);
+        TEST_ASSERT(result0 == dd::ResultSuccess);
+
+        if (pinned_mask == 0) {
+            const u32 result1 = dd::ukern::SetThreadCoreMask(handle_array[i], core_mask);
+            TEST_ASSERT(result1 == dd::ResultSuccess);
+        }
+
+        const u32 result2 = dd::ukern::StartThread(handle_array[i]);
+        TEST_ASSERT(result2 == dd::ResultSuccess);
+    }
+
+    /* Wait for all workers */
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        dd::ukern::ExitThread(handle_array[i]);
+    }
+
+    /* Ensure all work completed, pinned fibers stayed put, and other cores picked up work */
+    TEST_ASSERT(CompletedWorkers == WorkerCount);
+    TEST_ASSERT(CoreMaskViolations == 0);
+    TEST_ASSERT(dd::util::CountOneBits64(VisitedCoreMask) > 1);
+
+    TEST_SUCCESS;
+}
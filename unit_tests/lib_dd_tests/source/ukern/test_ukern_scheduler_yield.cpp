@@ -0,0 +1,56 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+volatile u32 YieldCompetitorCount = 0;
+
+void TestYieldCompetitorMain(void *arg) {
+
+    /* Alternate with the yielding main thread */
+    const u32 yield_count = static_cast<u32>(reinterpret_cast<uintptr_t>(arg));
+    for (u32 i = 0; i < yield_count; ++i) {
+        YieldCompetitorCount = YieldCompetitorCount + 1;
+        dd::ukern::YieldThread();
+    }
+
+    return;
+}
+
+TEST(SchedulerYield) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Use one core */
+    dd::ukern::UKernCoreMask core_mask = 1;
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(core_mask);
+
+    /* Uncontended yields should not enter the scheduler */
+    constexpr u32 YieldCount = 100000;
+    for (u32 i = 0; i < YieldCount; ++i) {
+        dd::ukern::YieldThread();
+        dd::ukern::Sleep(dd::TimeSpan::FromNanoSeconds(0));
+    }
+
+    /* A competitor at our priority must still get the core on every yield */
+    constexpr u32 CompetitorYieldCount = 64;
+    dd::ukern::UKernHandle competitor_handle = 0;
+    const u32 result0 = dd::ukern::CreateThread(std::addressof(competitor_handle), TestYieldCompetitorMain, CompetitorYieldCount, 0x4000, THREAD_PRIORITY_NORMAL, 0);
+    TEST_ASSERT(result0 == dd::ResultSuccess);
+    const u32 result1 = dd::ukern::StartThread(competitor_handle);
+    TEST_ASSERT(result1 == dd::ResultSuccess);
+
+    for (u32 i = 0; i < CompetitorYieldCount; ++i) {
+        const u32 last_count = YieldCompetitorCount;
+        dd::ukern::YieldThread();
+        TEST_ASSERT(last_count + 1 == YieldCompetitorCount);
+    }
+
+    /* Join blocks until the competitor exits */
+    dd::ukern::ExitThread(competitor_handle);
+
+    TEST_SUCCESS;
+}
@@ -0,0 +1,71 @@
+#include <dd.hpp>
+#include <unit_tester.hpp>
+
+DECLARE_UNIT_TESTER_INSTANCE;
+
+constexpr u32 WorkerCount    = 12;
+constexpr u32 PermitCount    = 3;
+constexpr u32 WorkIterations = 200;
+
+dd::ukern::InternalSemaphore PermitSemaphore(PermitCount);
+std::atomic<u32>             ActiveHolderCount = 0;
+std::atomic<u32>             MaxHolderCount    = 0;
+std::atomic<u32>             PermitViolations  = 0;
+
+void TestWorkerMain(void *) {
+
+    for (u32 i = 0; i < WorkIterations; ++i) {
+        PermitSemaphore.Acquire();
+
+        /* No more holders than permits */
+        const u32 holder_count = ActiveHolderCount.fetch_add(1) + 1;
+        if (PermitCount < holder_count) { PermitViolations.fetch_add(1); }
+        u32 last_max = MaxHolderCount.load();
+        while (last_max < holder_count && MaxHolderCount.compare_exchange_weak(last_max, holder_count) == false) {}
+
+        if ((i & 0xf) == 0) { dd::ukern::YieldThread(); }
+
+        ActiveHolderCount.fetch_sub(1);
+        PermitSemaphore.Release();
+    }
+
+    return;
+}
+
+TEST(Semaphore) {
+
+    /* Init timestamp */
+    dd::util::InitializeTimeStamp();
+
+    /* Initialize scheduler */
+    dd::ukern::InitializeUKern(0b1111);
+
+    /* Drain the permits, then time out without changing the count */
+    for (u32 i = 0; i < PermitCount; ++i) {
+        TEST_ASSERT(PermitSemaphore.TryAcquire() == true);
+    }
+    TEST_ASSERT(PermitSemaphore.TryAcquire() == false);
+    TEST_ASSERT(PermitSemaphore.TimedAcquire(dd::TimeSpan::FromMicroSeconds(500).GetNanoSeconds()) == false);
+    TEST_ASSERT(PermitSemaphore.GetCount() == 0);
+
+    /* Workers block until the permits are released together */
+    dd::ukern::UKernHandle handle_array[WorkerCount] = {};
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        const u32 result0 = dd::ukern::CreateThread(std::addressof(handle_array[i]), TestWorkerMain, i, 0x4000, THREAD_PRIORITY_NORMAL, i % 4);
+        TEST_ASSERT(result0 == dd::ResultSuccess);
+        const u32 result1 = dd::ukern::StartThread(handle_array[i]);
+        TEST_ASSERT(result1 == dd::ResultSuccess);
+    }
+    dd::ukern::Sleep(dd::TimeSpan::FromMicroSeconds(500));
+    PermitSemaphore.Release(PermitCount);
+
+    for (u32 i = 0; i < WorkerCount; ++i) {
+        dd::ukern::ExitThread(handle_array[i]);
+    }
+
+    TEST_ASSERT(PermitViolations == 0);
+    TEST_ASSERT(0 < MaxHolderCount && MaxHolderCount <= PermitCount);
+    TEST_ASSERT(PermitSemaphore.GetCount() == PermitCount);
+
+    TEST_SUCCESS;
+}